@@ -21,12 +21,20 @@
 #include "MapTree.h"
 #include "BoundingIntervalHierarchy.h"
 #include "VMapDefinitions.h"
+#include "Fingerprint.h"
 
 #include <set>
 #include <iomanip>
 #include <sstream>
 #include <iomanip>
 
+#include <ace/Task.h>
+#include <ace/Activation_Queue.h>
+#include <ace/Method_Request.h>
+#include <ace/Thread_Semaphore.h>
+#include <ace/Guard_T.h>
+#include <ace/OS_NS_sys_stat.h>
+
 using G3D::Vector3;
 using G3D::AABox;
 using G3D::inf;
@@ -54,12 +62,99 @@ namespace VMAP
 
     //=================================================================
 
+    #define FINGERPRINT_FILE "assembler.fingerprint"
+
+    /* Runs the assembler jobs of convertWorld2 on a pool of threads. The queue holds at most
+       a few jobs per thread, queueing another one blocks until a thread has finished one. */
+    class AssemblerWorkers : public ACE_Task_Base
+    {
+        public:
+            explicit AssemblerWorkers(uint32 threads) : iThreads(threads), iQueueSlots(threads * 4), iFailed(false) {}
+
+            bool start()
+            {
+                iQueue.queue()->activate();
+                return activate(THR_NEW_LWP | THR_JOINABLE, iThreads) != -1;
+            }
+
+            void execute(ACE_Method_Request* job)
+            {
+                iQueueSlots.acquire();
+                iQueue.enqueue(job);
+            }
+
+            // waits for all queued jobs, false if any of them failed
+            bool finish()
+            {
+                for (uint32 i = 0; i < iThreads * 4; ++i)
+                    iQueueSlots.acquire();
+
+                iQueue.queue()->deactivate();
+                wait();
+                return !iFailed;
+            }
+
+            int svc()
+            {
+                while (ACE_Method_Request* job = iQueue.dequeue())
+                {
+                    if (job->call() != 0)
+                    {
+                        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, iFailedLock, -1);
+                        iFailed = true;
+                    }
+                    delete job;
+                    iQueueSlots.release();
+                }
+                return 0;
+            }
+
+        private:
+            uint32 iThreads;
+            ACE_Activation_Queue iQueue;
+            ACE_Thread_Semaphore iQueueSlots;
+            ACE_Thread_Mutex iFailedLock;
+            bool iFailed;
+    };
+
+    class ConvertMapRequest : public ACE_Method_Request
+    {
+        public:
+            ConvertMapRequest(TileAssembler &assembler, uint32 mapId, MapSpawns &spawns, std::set<std::string> &spawnedModelFiles) :
+                iAssembler(assembler), iMapId(mapId), iSpawns(spawns), iSpawnedModelFiles(spawnedModelFiles) {}
+
+            int call() { return iAssembler.convertMap(iMapId, iSpawns, iSpawnedModelFiles) ? 0 : -1; }
+
+        private:
+            TileAssembler &iAssembler;
+            uint32 iMapId;
+            MapSpawns &iSpawns;
+            std::set<std::string> &iSpawnedModelFiles;
+    };
+
+    class ConvertModelRequest : public ACE_Method_Request
+    {
+        public:
+            ConvertModelRequest(TileAssembler &assembler, const std::string &modelFilename) :
+                iAssembler(assembler), iModelFilename(modelFilename) {}
+
+            int call() { return iAssembler.convertModel(iModelFilename) ? 0 : -1; }
+
+        private:
+            TileAssembler &iAssembler;
+            std::string iModelFilename;
+    };
+
+    //=================================================================
+
     TileAssembler::TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName)
     {
         iCurrentUniqueNameId = 0;
         iFilterMethod = NULL;
         iSrcDir = pSrcDirName;
         iDestDir = pDestDirName;
+        iThreads = 1;
+        iIncremental = false;
         //mkdir(iDestDir);
         //init();
     }
@@ -71,132 +166,301 @@ namespace VMAP
 
     bool TileAssembler::convertWorld2()
     {
-        std::set<std::string> spawnedModelFiles;
         bool success = readMapSpawns();
         if (!success)
             return false;
 
-        // export Map data
-        for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end() && success; ++map_iter)
+        if (iIncremental)
+            loadFingerprints();
+
+        // export Map data, every map writes its own files so they do not depend on the order maps are done in
+        std::vector<std::set<std::string> > mapModelFiles(mapData.size());
         {
-            // build global map tree
-            std::vector<ModelSpawn*> mapSpawns;
-            UniqueEntryMap::iterator entry;
-            printf("Calculating model bounds for map %u...\n", map_iter->first);
-            for (entry = map_iter->second->UniqueEntries.begin(); entry != map_iter->second->UniqueEntries.end(); ++entry)
+            AssemblerWorkers workers(iThreads);
+            if (!workers.start())
             {
-                // M2 models don't have a bound set in WDT/ADT placement data, i still think they're not used for LoS at all on retail
-                if (entry->second.flags & MOD_M2)
-                {
-                    if (!calculateTransformedBound(entry->second))
-                        break;
-                }
-                else if (entry->second.flags & MOD_WORLDSPAWN) // WMO maps and terrain maps use different origin, so we need to adapt :/
-                {
-                    // TODO: remove extractor hack and uncomment below line:
-                    //entry->second.iPos += Vector3(533.33333f*32, 533.33333f*32, 0.f);
-                    entry->second.iBound = entry->second.iBound + Vector3(533.33333f*32, 533.33333f*32, 0.f);
-                }
-                mapSpawns.push_back(&(entry->second));
-                spawnedModelFiles.insert(entry->second.name);
+                printf("Cannot start converting threads\n");
+                return false;
             }
 
-            printf("Creating map tree for map %u...\n", map_iter->first);
-            BIH pTree;
-            pTree.build(mapSpawns, BoundsTrait<ModelSpawn*>::getBounds);
+            uint32 mapIdx = 0;
+            for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end(); ++map_iter, ++mapIdx)
+                workers.execute(new ConvertMapRequest(*this, map_iter->first, *map_iter->second, mapModelFiles[mapIdx]));
+
+            success = workers.finish();
+        }
 
-            // ===> possibly move this code to StaticMapTree class
-            std::map<uint32, uint32> modelNodeIdx;
-            for (uint32 i=0; i<mapSpawns.size(); ++i)
-                modelNodeIdx.insert(pair<uint32, uint32>(mapSpawns[i]->ID, i));
+        std::set<std::string> spawnedModelFiles;
+        for (uint32 i = 0; i < mapModelFiles.size(); ++i)
+            spawnedModelFiles.insert(mapModelFiles[i].begin(), mapModelFiles[i].end());
 
-            // write map tree file
-            std::stringstream mapfilename;
-            mapfilename << iDestDir << "/" << std::setfill('0') << std::setw(3) << map_iter->first << ".vmtree";
-            FILE *mapfile = fopen(mapfilename.str().c_str(), "wb");
-            if (!mapfile)
+        // export objects
+        std::cout << "\nConverting Model Files" << std::endl;
+        {
+            AssemblerWorkers workers(iThreads);
+            if (!workers.start())
             {
-                success = false;
-                printf("Cannot open %s\n", mapfilename.str().c_str());
-                break;
+                printf("Cannot start converting threads\n");
+                return false;
             }
 
-            //general info
-            if (success && fwrite(VMAP_MAGIC, 1, 8, mapfile) != 8) success = false;
-            uint32 globalTileID = StaticMapTree::packTileID(65, 65);
-            pair<TileMap::iterator, TileMap::iterator> globalRange = map_iter->second->TileEntries.equal_range(globalTileID);
-            char isTiled = globalRange.first == globalRange.second; // only maps without terrain (tiles) have global WMO
-            if (success && fwrite(&isTiled, sizeof(char), 1, mapfile) != 1) success = false;
-            // Nodes
-            if (success && fwrite("NODE", 4, 1, mapfile) != 1) success = false;
-            if (success) success = pTree.writeToFile(mapfile);
-            // global map spawns (WDT), if any (most instances)
-            if (success && fwrite("GOBJ", 4, 1, mapfile) != 1) success = false;
-
-            for (TileMap::iterator glob=globalRange.first; glob != globalRange.second && success; ++glob)
+            for (std::set<std::string>::iterator mfile = spawnedModelFiles.begin(); mfile != spawnedModelFiles.end(); ++mfile)
+                workers.execute(new ConvertModelRequest(*this, *mfile));
+
+            if (!workers.finish())
+                success = false;
+        }
+
+        saveFingerprints();
+
+        //cleanup:
+        for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end(); ++map_iter)
+        {
+            delete map_iter->second;
+        }
+        return success;
+    }
+
+    bool TileAssembler::convertMap(uint32 mapId, MapSpawns &spawns, std::set<std::string> &spawnedModelFiles)
+    {
+        bool success = true;
+
+        std::stringstream mapfilename;
+        mapfilename << iDestDir << "/" << std::setfill('0') << std::setw(3) << mapId << ".vmtree";
+
+        std::stringstream fingerprintKey;
+        fingerprintKey << "map " << mapId;
+
+        uint64 fingerprint = getMapFingerprint(spawns);
+        if (isUpToDate(fingerprintKey.str(), fingerprint, mapfilename.str()))
+        {
+            printf("Map %u is up to date\n", mapId);
+            for (UniqueEntryMap::iterator entry = spawns.UniqueEntries.begin(); entry != spawns.UniqueEntries.end(); ++entry)
+                spawnedModelFiles.insert(entry->second.name);
+            return true;
+        }
+
+        // build global map tree
+        std::vector<ModelSpawn*> mapSpawns;
+        UniqueEntryMap::iterator entry;
+        printf("Calculating model bounds for map %u...\n", mapId);
+        for (entry = spawns.UniqueEntries.begin(); entry != spawns.UniqueEntries.end(); ++entry)
+        {
+            // M2 models don't have a bound set in WDT/ADT placement data, i still think they're not used for LoS at all on retail
+            if (entry->second.flags & MOD_M2)
+            {
+                if (!calculateTransformedBound(entry->second))
+                    break;
+            }
+            else if (entry->second.flags & MOD_WORLDSPAWN) // WMO maps and terrain maps use different origin, so we need to adapt :/
             {
-                success = ModelSpawn::writeToFile(mapfile, map_iter->second->UniqueEntries[glob->second]);
+                // TODO: remove extractor hack and uncomment below line:
+                //entry->second.iPos += Vector3(533.33333f*32, 533.33333f*32, 0.f);
+                entry->second.iBound = entry->second.iBound + Vector3(533.33333f*32, 533.33333f*32, 0.f);
             }
+            mapSpawns.push_back(&(entry->second));
+            spawnedModelFiles.insert(entry->second.name);
+        }
+
+        printf("Creating map tree for map %u...\n", mapId);
+        BIH pTree;
+        pTree.build(mapSpawns, BoundsTrait<ModelSpawn*>::getBounds);
+
+        // ===> possibly move this code to StaticMapTree class
+        std::map<uint32, uint32> modelNodeIdx;
+        for (uint32 i=0; i<mapSpawns.size(); ++i)
+            modelNodeIdx.insert(pair<uint32, uint32>(mapSpawns[i]->ID, i));
+
+        // write map tree file
+        FILE *mapfile = fopen(mapfilename.str().c_str(), "wb");
+        if (!mapfile)
+        {
+            printf("Cannot open %s\n", mapfilename.str().c_str());
+            return false;
+        }
 
-            fclose(mapfile);
+        //general info
+        if (success && fwrite(VMAP_MAGIC, 1, 8, mapfile) != 8) success = false;
+        uint32 globalTileID = StaticMapTree::packTileID(65, 65);
+        pair<TileMap::iterator, TileMap::iterator> globalRange = spawns.TileEntries.equal_range(globalTileID);
+        char isTiled = globalRange.first == globalRange.second; // only maps without terrain (tiles) have global WMO
+        if (success && fwrite(&isTiled, sizeof(char), 1, mapfile) != 1) success = false;
+        // Nodes
+        if (success && fwrite("NODE", 4, 1, mapfile) != 1) success = false;
+        if (success) success = pTree.writeToFile(mapfile);
+        // global map spawns (WDT), if any (most instances)
+        if (success && fwrite("GOBJ", 4, 1, mapfile) != 1) success = false;
+
+        for (TileMap::iterator glob=globalRange.first; glob != globalRange.second && success; ++glob)
+        {
+            success = ModelSpawn::writeToFile(mapfile, spawns.UniqueEntries[glob->second]);
+        }
 
-            // <====
+        fclose(mapfile);
 
-            // write map tile files, similar to ADT files, only with extra BSP tree node info
-            TileMap &tileEntries = map_iter->second->TileEntries;
-            TileMap::iterator tile;
-            for (tile = tileEntries.begin(); tile != tileEntries.end(); ++tile)
+        // <====
+
+        // write map tile files, similar to ADT files, only with extra BSP tree node info
+        TileMap &tileEntries = spawns.TileEntries;
+        TileMap::iterator tile;
+        for (tile = tileEntries.begin(); tile != tileEntries.end(); ++tile)
+        {
+            const ModelSpawn &spawn = spawns.UniqueEntries[tile->second];
+            if (spawn.flags & MOD_WORLDSPAWN) // WDT spawn, saved as tile 65/65 currently...
+                continue;
+            uint32 nSpawns = tileEntries.count(tile->first);
+            std::stringstream tilefilename;
+            tilefilename.fill('0');
+            tilefilename << iDestDir << "/" << std::setw(3) << mapId << "_";
+            uint32 x, y;
+            StaticMapTree::unpackTileID(tile->first, x, y);
+            tilefilename << std::setw(2) << x << "_" << std::setw(2) << y << ".vmtile";
+            FILE *tilefile = fopen(tilefilename.str().c_str(), "wb");
+            // file header
+            if (success && fwrite(VMAP_MAGIC, 1, 8, tilefile) != 8) success = false;
+            // write number of tile spawns
+            if (success && fwrite(&nSpawns, sizeof(uint32), 1, tilefile) != 1) success = false;
+            // write tile spawns
+            for (uint32 s=0; s<nSpawns; ++s)
             {
-                const ModelSpawn &spawn = map_iter->second->UniqueEntries[tile->second];
-                if (spawn.flags & MOD_WORLDSPAWN) // WDT spawn, saved as tile 65/65 currently...
-                    continue;
-                uint32 nSpawns = tileEntries.count(tile->first);
-                std::stringstream tilefilename;
-                tilefilename.fill('0');
-                tilefilename << iDestDir << "/" << std::setw(3) << map_iter->first << "_";
-                uint32 x, y;
-                StaticMapTree::unpackTileID(tile->first, x, y);
-                tilefilename << std::setw(2) << x << "_" << std::setw(2) << y << ".vmtile";
-                FILE *tilefile = fopen(tilefilename.str().c_str(), "wb");
-                // file header
-                if (success && fwrite(VMAP_MAGIC, 1, 8, tilefile) != 8) success = false;
-                // write number of tile spawns
-                if (success && fwrite(&nSpawns, sizeof(uint32), 1, tilefile) != 1) success = false;
-                // write tile spawns
-                for (uint32 s=0; s<nSpawns; ++s)
-                {
-                    if (s)
-                        ++tile;
-                    const ModelSpawn &spawn2 = map_iter->second->UniqueEntries[tile->second];
-                    success = success && ModelSpawn::writeToFile(tilefile, spawn2);
-                    // MapTree nodes to update when loading tile:
-                    std::map<uint32, uint32>::iterator nIdx = modelNodeIdx.find(spawn2.ID);
-                    if (success && fwrite(&nIdx->second, sizeof(uint32), 1, tilefile) != 1) success = false;
-                }
-                fclose(tilefile);
+                if (s)
+                    ++tile;
+                const ModelSpawn &spawn2 = spawns.UniqueEntries[tile->second];
+                success = success && ModelSpawn::writeToFile(tilefile, spawn2);
+                // MapTree nodes to update when loading tile:
+                std::map<uint32, uint32>::iterator nIdx = modelNodeIdx.find(spawn2.ID);
+                if (success && fwrite(&nIdx->second, sizeof(uint32), 1, tilefile) != 1) success = false;
             }
-            // break; //test, extract only first map; TODO: remvoe this line
+            fclose(tilefile);
         }
 
-        // export objects
-        std::cout << "\nConverting Model Files" << std::endl;
-        for (std::set<std::string>::iterator mfile = spawnedModelFiles.begin(); mfile != spawnedModelFiles.end(); ++mfile)
+        if (success)
+            setFingerprint(fingerprintKey.str(), fingerprint);
+
+        return success;
+    }
+
+    bool TileAssembler::convertModel(const std::string& pModelFilename)
+    {
+        std::string fingerprintKey = "model " + pModelFilename;
+        uint64 fingerprint = getRawFileFingerprint(pModelFilename);
+        if (isUpToDate(fingerprintKey, fingerprint, iDestDir + "/" + pModelFilename + ".vmo"))
+            return true;
+
+        printf("Converting %s\n", pModelFilename.c_str());
+        if (!convertRawFile(pModelFilename))
+        {
+            printf("error converting %s\n", pModelFilename.c_str());
+            return false;
+        }
+
+        setFingerprint(fingerprintKey, fingerprint);
+        return true;
+    }
+
+    void TileAssembler::loadFingerprints()
+    {
+        std::string fname = iDestDir + "/" + FINGERPRINT_FILE;
+        FILE *rf = fopen(fname.c_str(), "r");
+        if (!rf)
+            return;
+
+        char type[16];
+        char name[512];
+        uint32 high, low;
+        while (fscanf(rf, "%15s %511s %8x%8x", type, name, &high, &low) == 4)
+            iFingerprints[std::string(type) + " " + name] = (uint64(high) << 32) | low;
+
+        fclose(rf);
+    }
+
+    void TileAssembler::saveFingerprints()
+    {
+        std::string fname = iDestDir + "/" + FINGERPRINT_FILE;
+        FILE *wf = fopen(fname.c_str(), "w");
+        if (!wf)
+        {
+            printf("Cannot open %s\n", fname.c_str());
+            return;
+        }
+
+        // sorted by key, so the file does not depend on the order things were converted in
+        for (FingerprintMap::const_iterator itr = iFingerprints.begin(); itr != iFingerprints.end(); ++itr)
+            fprintf(wf, "%s %08x%08x\n", itr->first.c_str(), uint32(itr->second >> 32), uint32(itr->second));
+
+        fclose(wf);
+    }
+
+    bool TileAssembler::isUpToDate(const std::string& key, uint64 fingerprint, const std::string& outputFile)
+    {
+        if (!iIncremental || !fingerprint)
+            return false;
+
         {
-            std::cout << "Converting " << *mfile << std::endl;
-            if (!convertRawFile(*mfile))
+            ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, iFingerprintLock, false);
+            FingerprintMap::const_iterator itr = iFingerprints.find(key);
+            if (itr == iFingerprints.end() || itr->second != fingerprint)
+                return false;
+        }
+
+        ACE_stat st;
+        return ACE_OS::stat(outputFile.c_str(), &st) == 0;
+    }
+
+    void TileAssembler::setFingerprint(const std::string& key, uint64 fingerprint)
+    {
+        ACE_GUARD(ACE_Thread_Mutex, guard, iFingerprintLock);
+        if (fingerprint)
+            iFingerprints[key] = fingerprint;
+        else
+            iFingerprints.erase(key);
+    }
+
+    uint64 TileAssembler::getRawFileFingerprint(const std::string& pModelFilename) const
+    {
+        ACE_stat st;
+        if (ACE_OS::stat((iSrcDir + "/" + pModelFilename).c_str(), &st) != 0)
+            return 0;
+
+        uint64 size = uint64(st.st_size);
+        uint64 mtime = uint64(st.st_mtime);
+        uint64 fingerprint = FINGERPRINT_SEED;
+        fingerprint = HashBytes(fingerprint, &size, sizeof(size));
+        fingerprint = HashBytes(fingerprint, &mtime, sizeof(mtime));
+        return fingerprint;
+    }
+
+    uint64 TileAssembler::getMapFingerprint(const MapSpawns &spawns) const
+    {
+        uint64 fingerprint = HashBytes(FINGERPRINT_SEED, VMAP_MAGIC, 8);
+        for (UniqueEntryMap::const_iterator entry = spawns.UniqueEntries.begin(); entry != spawns.UniqueEntries.end(); ++entry)
+        {
+            const ModelSpawn &spawn = entry->second;
+            fingerprint = HashBytes(fingerprint, &spawn.flags, sizeof(spawn.flags));
+            fingerprint = HashBytes(fingerprint, &spawn.adtId, sizeof(spawn.adtId));
+            fingerprint = HashBytes(fingerprint, &spawn.ID, sizeof(spawn.ID));
+            fingerprint = HashBytes(fingerprint, &spawn.iPos, sizeof(spawn.iPos));
+            fingerprint = HashBytes(fingerprint, &spawn.iRot, sizeof(spawn.iRot));
+            fingerprint = HashBytes(fingerprint, &spawn.iScale, sizeof(spawn.iScale));
+            fingerprint = HashBytes(fingerprint, &spawn.iBound.low(), sizeof(Vector3));
+            fingerprint = HashBytes(fingerprint, &spawn.iBound.high(), sizeof(Vector3));
+            fingerprint = HashBytes(fingerprint, spawn.name.c_str(), spawn.name.size() + 1);
+
+            // the bounds of M2 spawns are calculated from the model files
+            if (spawn.flags & MOD_M2)
             {
-                std::cout << "error converting " << *mfile << std::endl;
-                success = false;
-                break;
+                uint64 modelFingerprint = getRawFileFingerprint(spawn.name);
+                fingerprint = HashBytes(fingerprint, &modelFingerprint, sizeof(modelFingerprint));
             }
         }
 
-        //cleanup:
-        for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end(); ++map_iter)
+        for (TileMap::const_iterator tile = spawns.TileEntries.begin(); tile != spawns.TileEntries.end(); ++tile)
         {
-            delete map_iter->second;
+            fingerprint = HashBytes(fingerprint, &tile->first, sizeof(tile->first));
+            fingerprint = HashBytes(fingerprint, &tile->second, sizeof(tile->second));
         }
-        return success;
+
+        return fingerprint;
     }
 
     bool TileAssembler::readMapSpawns()
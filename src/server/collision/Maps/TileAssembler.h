@@ -21,7 +21,9 @@
 
 #include <G3D/Vector3.h>
 #include <G3D/Matrix3.h>
+#include <ace/Thread_Mutex.h>
 #include <map>
+#include <set>
 
 #include "ModelInstance.h"
 
@@ -59,6 +61,7 @@ namespace VMAP
     };
 
     typedef std::map<uint32, MapSpawns*> MapData;
+    typedef std::map<std::string, uint64> FingerprintMap;
     //===============================================
 
     class TileAssembler
@@ -70,6 +73,18 @@ namespace VMAP
             G3D::Table<std::string, unsigned int > iUniqueNameIds;
             unsigned int iCurrentUniqueNameId;
             MapData mapData;
+            uint32 iThreads;
+            bool iIncremental;
+            // fingerprints of the inputs of every map and model written so far, for incremental runs
+            FingerprintMap iFingerprints;
+            ACE_Thread_Mutex iFingerprintLock;
+
+            void loadFingerprints();
+            void saveFingerprints();
+            bool isUpToDate(const std::string& key, uint64 fingerprint, const std::string& outputFile);
+            void setFingerprint(const std::string& key, uint64 fingerprint);
+            uint64 getRawFileFingerprint(const std::string& pModelFilename) const;
+            uint64 getMapFingerprint(const MapSpawns &spawns) const;
 
         public:
             TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName);
@@ -79,9 +94,18 @@ namespace VMAP
             bool readMapSpawns();
             bool calculateTransformedBound(ModelSpawn &spawn);
 
+            // both are called concurrently by convertWorld2, one map or model per call
+            bool convertMap(uint32 mapId, MapSpawns &spawns, std::set<std::string> &spawnedModelFiles);
+            bool convertModel(const std::string& pModelFilename);
+
             bool convertRawFile(const std::string& pModelFilename);
             void setModelNameFilterMethod(bool (*pFilterMethod)(char *pName)) { iFilterMethod = pFilterMethod; }
             std::string getDirEntryNameFromModName(unsigned int pMapId, const std::string& pModPosName);
+
+            // maps and models are converted on that many threads, 1 by default
+            void setThreadCount(uint32 threads) { iThreads = threads ? threads : 1; }
+            // skip maps and models whose inputs did not change since the last run
+            void setIncremental(bool incremental) { iIncremental = incremental; }
     };
 
 }                                                           // VMAP
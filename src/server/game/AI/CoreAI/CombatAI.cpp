@@ -186,7 +186,7 @@ ArchorAI::ArchorAI(Creature *c) : CreatureAI(c)
     if (!m_minRange)
         m_minRange = MELEE_RANGE;
     me->m_CombatDistance = GetSpellMaxRange(me->m_spells[0], false);
-    me->m_SightDistance = me->m_CombatDistance;
+    me->SetSightDistance(me->m_CombatDistance);
 }
 
 void ArchorAI::AttackStart(Unit *who)
@@ -231,7 +231,7 @@ TurretAI::TurretAI(Creature *c) : CreatureAI(c)
 
     m_minRange = GetSpellMinRange(me->m_spells[0], false);
     me->m_CombatDistance = GetSpellMaxRange(me->m_spells[0], false);
-    me->m_SightDistance = me->m_CombatDistance;
+    me->SetSightDistance(me->m_CombatDistance);
 }
 
 bool TurretAI::CanAIAttack(const Unit * /*who*/) const
@@ -414,6 +414,7 @@ void AchievementMgr::Reset()
     }
 
     m_completedAchievements.clear();
+    m_completedAchievementBits.clear();
     m_criteriaProgress.clear();
     DeleteFromDB(m_player->GetGUIDLow());
 
@@ -583,6 +584,7 @@ void AchievementMgr::LoadFromDB(PreparedQueryResult achievementResult, PreparedQ
             CompletedAchievementData& ca = m_completedAchievements[achievement_id];
             ca.date = time_t(fields[1].GetUInt64());
             ca.changed = false;
+            SetAchievedBit(achievement_id);
         }
         while (achievementResult->NextRow());
     }
@@ -724,7 +726,8 @@ void AchievementMgr::UpdateAchievementCriteria(AchievementCriteriaTypes type, ui
     if (!sWorld->getBoolConfig(CONFIG_GM_ALLOW_ACHIEVEMENT_GAINS) && m_player->GetSession()->GetSecurity() > SEC_PLAYER)
         return;
 
-    AchievementCriteriaEntryList const& achievementCriteriaList = sAchievementMgr->GetAchievementCriteriaByType(type);
+    // kill, loot, cast... updates only walk the criteria asking for that creature, item, spell...
+    AchievementCriteriaEntryList const& achievementCriteriaList = sAchievementMgr->GetAchievementCriteriaByType(type, miscvalue1);
     for (AchievementCriteriaEntryList::const_iterator i = achievementCriteriaList.begin(); i != achievementCriteriaList.end(); ++i)
     {
         AchievementCriteriaEntry const *achievementCriteria = (*i);
@@ -843,7 +846,7 @@ void AchievementMgr::UpdateAchievementCriteria(AchievementCriteriaTypes type, ui
                     SetCriteriaProgress(achievementCriteria, maxSkillvalue);
                 break;
             case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_ACHIEVEMENT:
-                if (m_completedAchievements.find(achievementCriteria->complete_achievement.linkedAchievement) != m_completedAchievements.end())
+                if (HasAchieved(achievementCriteria->complete_achievement.linkedAchievement))
                     SetCriteriaProgress(achievementCriteria, 1);
                 break;
             case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST_COUNT:
@@ -1968,6 +1971,7 @@ void AchievementMgr::CompletedAchievement(AchievementEntry const* achievement, b
     CompletedAchievementData& ca =  m_completedAchievements[achievement->ID];
     ca.date = time(NULL);
     ca.changed = true;
+    SetAchievedBit(achievement->ID);
 
     // don't insert for ACHIEVEMENT_FLAG_REALM_FIRST_KILL since otherwise only the first group member would reach that achievement
     // TODO: where do set this instead?
@@ -2072,9 +2076,15 @@ void AchievementMgr::BuildAllDataPacket(WorldPacket *data)
     *data << int32(-1);
 }
 
-bool AchievementMgr::HasAchieved(AchievementEntry const* achievement) const
+void AchievementMgr::SetAchievedBit(uint32 achievementId)
 {
-    return m_completedAchievements.find(achievement->ID) != m_completedAchievements.end();
+    if (m_completedAchievementBits.empty())
+        m_completedAchievementBits.resize(sAchievementStore.GetNumRows(), false);
+
+    if (achievementId >= m_completedAchievementBits.size())
+        m_completedAchievementBits.resize(achievementId + 1, false);
+
+    m_completedAchievementBits[achievementId] = true;
 }
 
 //==========================================================
@@ -2083,6 +2093,103 @@ AchievementCriteriaEntryList const& AchievementGlobalMgr::GetAchievementCriteria
     return m_AchievementCriteriasByType[type];
 }
 
+AchievementCriteriaEntryList const& AchievementGlobalMgr::GetAchievementCriteriaByType(AchievementCriteriaTypes type, uint32 miscValue)
+{
+    if (!miscValue || !m_AchievementCriteriaTypeHasMiscIndex[type])
+        return m_AchievementCriteriasByType[type];
+
+    static AchievementCriteriaEntryList const emptyList;
+
+    AchievementCriteriaListByMiscValue::const_iterator itr = m_AchievementCriteriasByMiscValue[type].find(miscValue);
+    return itr != m_AchievementCriteriasByMiscValue[type].end() ? itr->second : emptyList;
+}
+
+/**
+ * Value a criteria compares miscvalue1 against in AchievementMgr::UpdateAchievementCriteria.
+ * Only types that skip every criteria with a different value (when miscvalue1 is not 0) are listed,
+ * for those only the criteria with a matching value have to be looked at.
+ */
+static bool GetCriteriaMiscValue(AchievementCriteriaEntry const* criteria, uint32& miscValue)
+{
+    switch (criteria->requiredType)
+    {
+        case ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE:
+            miscValue = criteria->kill_creature.creatureID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_REACH_SKILL_LEVEL:
+            miscValue = criteria->reach_skill_level.skillID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LEVEL:
+            miscValue = criteria->learn_skill_level.skillID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUESTS_IN_ZONE:
+            miscValue = criteria->complete_quests_in_zone.zoneID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_KILLED_BY_CREATURE:
+            miscValue = criteria->killed_by_creature.creatureEntry;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST:
+            miscValue = criteria->complete_quest.questID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET:
+        case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET2:
+            miscValue = criteria->be_spell_target.spellID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL:
+        case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL2:
+            miscValue = criteria->cast_spell.spellID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SPELL:
+            miscValue = criteria->learn_spell.spellID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_TYPE:
+            miscValue = criteria->loot_type.lootType;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_OWN_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_ITEM:
+            miscValue = criteria->own_item.itemID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_USE_ITEM:
+            miscValue = criteria->use_item.itemID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_GAIN_REPUTATION:
+            miscValue = criteria->gain_reputation.factionID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_DO_EMOTE:
+            miscValue = criteria->do_emote.emoteID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_EQUIP_ITEM:
+            miscValue = criteria->equip_item.itemID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_USE_GAMEOBJECT:
+            miscValue = criteria->use_gameobject.goEntry;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_FISH_IN_GAMEOBJECT:
+            miscValue = criteria->fish_in_gameobject.goEntry;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILLLINE_SPELLS:
+            miscValue = criteria->learn_skillline_spell.skillLine;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LINE:
+            miscValue = criteria->learn_skill_line.skillLine;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_HK_CLASS:
+            miscValue = criteria->hk_class.classID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_HK_RACE:
+            miscValue = criteria->hk_race.raceID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_BG_OBJECTIVE_CAPTURE:
+            miscValue = criteria->bg_objective.objectiveId;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_HONORABLE_KILL_AT_AREA:
+            miscValue = criteria->honorable_kill_at_area.areaID;
+            return true;
+        default:
+            return false;
+    }
+}
+
 AchievementCriteriaEntryList const& AchievementGlobalMgr::GetTimedAchievementCriteriaByType(AchievementCriteriaTimedTypes type)
 {
     return m_AchievementCriteriasByTimedType[type];
@@ -2109,6 +2216,13 @@ void AchievementGlobalMgr::LoadAchievementCriteriaList()
         m_AchievementCriteriasByType[criteria->requiredType].push_back(criteria);
         m_AchievementCriteriaListByAchievement[criteria->referredAchievement].push_back(criteria);
 
+        uint32 miscValue = 0;
+        if (GetCriteriaMiscValue(criteria, miscValue))
+        {
+            m_AchievementCriteriaTypeHasMiscIndex[criteria->requiredType] = true;
+            m_AchievementCriteriasByMiscValue[criteria->requiredType][miscValue].push_back(criteria);
+        }
+
         if (criteria->timeLimit)
             m_AchievementCriteriasByTimedType[criteria->timedType].push_back(criteria);
     }
@@ -31,6 +31,7 @@ typedef std::list<AchievementCriteriaEntry const*> AchievementCriteriaEntryList;
 typedef std::list<AchievementEntry const*>         AchievementEntryList;
 
 typedef std::map<uint32,AchievementCriteriaEntryList> AchievementCriteriaListByAchievement;
+typedef UNORDERED_MAP<uint32,AchievementCriteriaEntryList> AchievementCriteriaListByMiscValue;
 typedef std::map<uint32,AchievementEntryList>         AchievementListByReferencedId;
 
 struct CriteriaProgress
@@ -257,7 +258,11 @@ class AchievementMgr
         void CheckAllAchievementCriteria();
         void SendAllAchievementData();
         void SendRespondInspectAchievements(Player* player);
-        bool HasAchieved(AchievementEntry const* achievement) const;
+        bool HasAchieved(AchievementEntry const* achievement) const { return HasAchieved(achievement->ID); }
+        bool HasAchieved(uint32 achievementId) const
+        {
+            return achievementId < m_completedAchievementBits.size() && m_completedAchievementBits[achievementId];
+        }
         Player* GetPlayer() { return m_player; }
         void UpdateTimedAchievements(uint32 timeDiff);
         void StartTimedAchievement(AchievementCriteriaTimedTypes type, uint32 entry, uint32 timeLost = 0);
@@ -275,10 +280,12 @@ class AchievementMgr
         bool IsCompletedAchievement(AchievementEntry const* entry);
         //void CompleteAchievementsWithRefs(AchievementEntry const* entry);
         void BuildAllDataPacket(WorldPacket *data);
+        void SetAchievedBit(uint32 achievementId);
 
         Player* m_player;
         CriteriaProgressMap m_criteriaProgress;
         CompletedAchievementMap m_completedAchievements;
+        std::vector<bool> m_completedAchievementBits; // by achievement id, mirrors m_completedAchievements for fast lookups
         typedef std::map<uint32, uint32> TimedAchievementMap;
         TimedAchievementMap m_timedAchievements;      // Criteria id/time left in MS
 };
@@ -286,11 +293,13 @@ class AchievementMgr
 class AchievementGlobalMgr
 {
         friend class ACE_Singleton<AchievementGlobalMgr, ACE_Null_Mutex>;
-        AchievementGlobalMgr() {}
+        AchievementGlobalMgr() { memset(m_AchievementCriteriaTypeHasMiscIndex, 0, sizeof(m_AchievementCriteriaTypeHasMiscIndex)); }
         ~AchievementGlobalMgr() {}
 
     public:
         AchievementCriteriaEntryList const& GetAchievementCriteriaByType(AchievementCriteriaTypes type);
+        // only the criteria of the type that can match the given misc value, all of the type if it has no misc value index or miscValue is 0
+        AchievementCriteriaEntryList const& GetAchievementCriteriaByType(AchievementCriteriaTypes type, uint32 miscValue);
         AchievementCriteriaEntryList const& GetTimedAchievementCriteriaByType(AchievementCriteriaTimedTypes type);
         AchievementCriteriaEntryList const* GetAchievementCriteriaByAchievement(uint32 id)
         {
@@ -344,6 +353,9 @@ class AchievementGlobalMgr
         // store achievement criterias by type to speed up lookup
         AchievementCriteriaEntryList m_AchievementCriteriasByType[ACHIEVEMENT_CRITERIA_TYPE_TOTAL];
         AchievementCriteriaEntryList m_AchievementCriteriasByTimedType[ACHIEVEMENT_TIMED_TYPE_MAX];
+        // store achievement criterias of types filtered on miscvalue1 by that value (creature entry, item id, spell id...)
+        AchievementCriteriaListByMiscValue m_AchievementCriteriasByMiscValue[ACHIEVEMENT_CRITERIA_TYPE_TOTAL];
+        bool m_AchievementCriteriaTypeHasMiscIndex[ACHIEVEMENT_CRITERIA_TYPE_TOTAL];
         // store achievement criterias by achievement to speed up lookup
         AchievementCriteriaListByAchievement m_AchievementCriteriaListByAchievement;
         // store achievements by referenced achievement id to speed up lookup
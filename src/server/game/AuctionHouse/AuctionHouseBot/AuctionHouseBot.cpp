@@ -554,47 +554,25 @@ void AuctionHouseBot::addNewAuctionBuyerBotBid(Player *AHBplayer, AHBConfig *con
         return;
     }
 
-    QueryResult result = CharacterDatabase.PQuery("SELECT id FROM auctionhouse WHERE itemowner<>%u AND buyguid<>%u", AHBplayerGUID, AHBplayerGUID);
-
-    if (!result)
-        return;
-
-    if (result->GetRowCount() == 0)
-        return;
-
     // Fetches content of selected AH
     AuctionHouseObject* auctionHouse =  sAuctionMgr->GetAuctionsMap(config->GetAHFID());
-    vector<uint32> possibleBids;
-
-    do
-    {
-        uint32 tmpdata = result->Fetch()->GetUInt32();
-        possibleBids.push_back(tmpdata);
-    }while (result->NextRow());
-
-    for (uint32 count = 1; count <= config->GetBidsPerInterval(); ++count)
-    {
-        // Do we have anything to bid? If not, stop here.
-        if (possibleBids.empty())
-        {
-            //if (debug_Out) sLog->outString("AHBuyer: I have no items to bid on.");
-            count = config->GetBidsPerInterval();
-            continue;
-        }
+    if (!auctionHouse)
+        return;
 
-        // Choose random auction from possible auctions
-        uint32 vectorPos = urand(0, possibleBids.size() - 1);
-        vector<uint32>::iterator iter = possibleBids.begin();
-        advance(iter, vectorPos);
+    // Picks the auctions to bid on from the in-memory index of auctions not owned by the bot
+    vector<AuctionEntry*> possibleBids;
+    auctionHouse->SampleBidCandidates(AHBplayerGUID, config->GetBidsPerInterval(), possibleBids);
 
-        // from auctionhousehandler.cpp, creates auction pointer & player pointer
-        AuctionEntry* auction = auctionHouse->GetAuction(*iter);
+    // Do we have anything to bid? If not, stop here.
+    if (possibleBids.empty())
+        return;
 
-        // Erase the auction from the vector to prevent bidding on item in next iteration.
-        possibleBids.erase(iter);
+    // All bids and mails of this interval are written in one go
+    SQLTransaction trans = CharacterDatabase.BeginTransaction();
 
-        if (!auction)
-            continue;
+    for (vector<AuctionEntry*>::const_iterator iter = possibleBids.begin(); iter != possibleBids.end(); ++iter)
+    {
+        AuctionEntry* auction = *iter;
 
         // get exact item information
         Item *pItem =  sAuctionMgr->GetAItem(auction->item_guidlow);
@@ -722,9 +700,7 @@ void AuctionHouseBot::addNewAuctionBuyerBotBid(Player *AHBplayer, AHBConfig *con
                 else
                 {
                     // mail to last bidder and return money
-                    SQLTransaction trans = CharacterDatabase.BeginTransaction();
                     sAuctionMgr->SendAuctionOutbiddedMail(auction , bidprice, session->GetPlayer(), trans);
-                    CharacterDatabase.CommitTransaction(trans);
                     //pl->ModifyMoney(-int32(price));
                 }
            }
@@ -733,11 +709,10 @@ void AuctionHouseBot::addNewAuctionBuyerBotBid(Player *AHBplayer, AHBConfig *con
             auction->bid = bidprice;
 
             // Saving auction into database
-            CharacterDatabase.PExecute("UPDATE auctionhouse SET buyguid = '%u',lastbid = '%u' WHERE id = '%u'", auction->bidder, auction->bid, auction->Id);
+            trans->PAppend("UPDATE auctionhouse SET buyguid = '%u',lastbid = '%u' WHERE id = '%u'", auction->bidder, auction->bid, auction->Id);
         }
         else
         {
-            SQLTransaction trans = CharacterDatabase.BeginTransaction();
             //buyout
             if ((auction->bidder) && (AHBplayer->GetGUIDLow() != auction->bidder))
             {
@@ -754,9 +729,11 @@ void AuctionHouseBot::addNewAuctionBuyerBotBid(Player *AHBplayer, AHBConfig *con
             uint32 item_template = auction->item_template;
             sAuctionMgr->RemoveAItem(auction->item_guidlow);
             auctionHouse->RemoveAuction(auction, item_template);
-            CharacterDatabase.CommitTransaction(trans);
         }
     }
+
+    if (trans->GetSize())
+        CharacterDatabase.CommitTransaction(trans);
 }
 
 void AuctionHouseBot::Update()
@@ -889,6 +866,14 @@ void AuctionHouseBot::Initialize()
     }
     LoadValues(&NeutralConfig);
 
+    // auctions were loaded before the bot knew its character, the bid candidates leave out its own auctions
+    if (!sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_AUCTION))
+    {
+        sAuctionMgr->GetAuctionsMap(AllianceConfig.GetAHFID())->SetBotOwner(AHBplayerGUID);
+        sAuctionMgr->GetAuctionsMap(HordeConfig.GetAHFID())->SetBotOwner(AHBplayerGUID);
+    }
+    sAuctionMgr->GetAuctionsMap(NeutralConfig.GetAHFID())->SetBotOwner(AHBplayerGUID);
+
     //
     // check if the AHBot account/GUID in the config actually exists
     //
@@ -941,19 +926,18 @@ void AuctionHouseBot::Initialize()
 				GlyphBuyOutPriceMax = GlyphBuyOutPriceMin;
 
 
-			results = WorldDatabase.PQuery("SELECT entry FROM item_template WHERE class = 16 AND RequiredLevel >= %u AND RequiredLevel <= %u", DisableGlyphBelowLevel, DisableGlyphAboveLevel);
-			if (results != NULL)
+			// item templates are already in memory, no need to ask the world database
+			for (uint32 itemID = 0; itemID < sItemStorage.MaxEntry; ++itemID)
 			{
-				do
-				{
-					Field* fields = results->Fetch();
-					glyphItems.push_back(fields[0].GetUInt32());
-
-				} while (results->NextRow());
+				ItemPrototype const* prototype = sObjectMgr->GetItemPrototype(itemID);
+				if (prototype && prototype->Class == ITEM_CLASS_GLYPH &&
+					prototype->RequiredLevel >= DisableGlyphBelowLevel && prototype->RequiredLevel <= DisableGlyphAboveLevel)
+					glyphItems.push_back(itemID);
 			}
-			else
+
+			if (glyphItems.empty())
 			{
-				if (debug_Out) sLog->outString("AuctionHouseBot: query glyphs failed");
+				if (debug_Out) sLog->outString("AuctionHouseBot: no glyphs found");
 			}
 		}
 
@@ -1603,17 +1587,20 @@ void AuctionHouseBot::Commands(uint32 command, uint32 ahMapID, uint32 col, char*
             AuctionHouseObject::AuctionEntryMap::iterator itr;
             itr = auctionHouse->GetAuctionsBegin();
 
+            SQLTransaction trans = CharacterDatabase.BeginTransaction();
             while (itr != auctionHouse->GetAuctionsEnd())
             {
                 if (itr->second->owner == AHBplayerGUID)
                 {
-                    itr->second->expire_time = sWorld->GetGameTime();
+                    auctionHouse->SetAuctionExpireTime(itr->second, sWorld->GetGameTime());
                     uint32 id = itr->second->Id;
                     uint32 expire_time = itr->second->expire_time;
-                    CharacterDatabase.PExecute("UPDATE auctionhouse SET time = '%u' WHERE id = '%u'", expire_time, id);
+                    trans->PAppend("UPDATE auctionhouse SET time = '%u' WHERE id = '%u'", expire_time, id);
                 }
                 ++itr;
             }
+            if (trans->GetSize())
+                CharacterDatabase.CommitTransaction(trans);
         }
         break;
     case 1:     //min items
@@ -1758,66 +1745,84 @@ void AuctionHouseBot::Commands(uint32 command, uint32 ahMapID, uint32 col, char*
 
 void AuctionHouseBot::LoadValues(AHBConfig *config)
 {
-    if (debug_Out) sLog->outString(((std::string)("Start Settings for %s Auctionhouses:", CharacterDatabase.PQuery("SELECT name FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetString())).c_str());
+    // all settings of a house come from a single row, fetched once
+    QueryResult result = CharacterDatabase.PQuery("SELECT name, minitems, maxitems, "
+        "percentgreytradegoods, percentwhitetradegoods, percentgreentradegoods, percentbluetradegoods, percentpurpletradegoods, percentorangetradegoods, percentyellowtradegoods, "
+        "percentgreyitems, percentwhiteitems, percentgreenitems, percentblueitems, percentpurpleitems, percentorangeitems, percentyellowitems, "
+        "minpricegrey, maxpricegrey, minpricewhite, maxpricewhite, minpricegreen, maxpricegreen, minpriceblue, maxpriceblue, minpricepurple, maxpricepurple, minpriceorange, maxpriceorange, minpriceyellow, maxpriceyellow, "
+        "minbidpricegrey, maxbidpricegrey, minbidpricewhite, maxbidpricewhite, minbidpricegreen, maxbidpricegreen, minbidpriceblue, maxbidpriceblue, minbidpricepurple, maxbidpricepurple, minbidpriceorange, maxbidpriceorange, minbidpriceyellow, maxbidpriceyellow, "
+        "maxstackgrey, maxstackwhite, maxstackgreen, maxstackblue, maxstackpurple, maxstackorange, maxstackyellow, "
+        "buyerpricegrey, buyerpricewhite, buyerpricegreen, buyerpriceblue, buyerpricepurple, buyerpriceorange, buyerpriceyellow, "
+        "buyerbiddinginterval, buyerbidsperinterval "
+        "FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID());
+    if (!result)
+    {
+        sLog->outError("AuctionHouseBot: no auctionhousebot row for auction house %u", config->GetAHID());
+        return;
+    }
+
+    Field* fields = result->Fetch();
+
+    if (debug_Out) sLog->outString("Start Settings for %s Auctionhouses:", fields[0].GetString().c_str());
     if (AHBSeller)
     {
         //load min and max items
-        config->SetMinItems(CharacterDatabase.PQuery("SELECT minitems FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMaxItems(CharacterDatabase.PQuery("SELECT maxitems FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
+        config->SetMinItems(fields[1].GetUInt32());
+        config->SetMaxItems(fields[2].GetUInt32());
         //load percentages
-        uint32 greytg = CharacterDatabase.PQuery("SELECT percentgreytradegoods FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32();
-        uint32 whitetg = CharacterDatabase.PQuery("SELECT percentwhitetradegoods FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32();
-        uint32 greentg = CharacterDatabase.PQuery("SELECT percentgreentradegoods FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32();
-        uint32 bluetg = CharacterDatabase.PQuery("SELECT percentbluetradegoods FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32();
-        uint32 purpletg = CharacterDatabase.PQuery("SELECT percentpurpletradegoods FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32();
-        uint32 orangetg = CharacterDatabase.PQuery("SELECT percentorangetradegoods FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32();
-        uint32 yellowtg = CharacterDatabase.PQuery("SELECT percentyellowtradegoods FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32();
-        uint32 greyi = CharacterDatabase.PQuery("SELECT percentgreyitems FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32();
-        uint32 whitei = CharacterDatabase.PQuery("SELECT percentwhiteitems FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32();
-        uint32 greeni = CharacterDatabase.PQuery("SELECT percentgreenitems FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32();
-        uint32 bluei = CharacterDatabase.PQuery("SELECT percentblueitems FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32();
-        uint32 purplei = CharacterDatabase.PQuery("SELECT percentpurpleitems FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32();
-        uint32 orangei = CharacterDatabase.PQuery("SELECT percentorangeitems FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32();
-        uint32 yellowi = CharacterDatabase.PQuery("SELECT percentyellowitems FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32();
+        uint32 greytg = fields[3].GetUInt32();
+        uint32 whitetg = fields[4].GetUInt32();
+        uint32 greentg = fields[5].GetUInt32();
+        uint32 bluetg = fields[6].GetUInt32();
+        uint32 purpletg = fields[7].GetUInt32();
+        uint32 orangetg = fields[8].GetUInt32();
+        uint32 yellowtg = fields[9].GetUInt32();
+        uint32 greyi = fields[10].GetUInt32();
+        uint32 whitei = fields[11].GetUInt32();
+        uint32 greeni = fields[12].GetUInt32();
+        uint32 bluei = fields[13].GetUInt32();
+        uint32 purplei = fields[14].GetUInt32();
+        uint32 orangei = fields[15].GetUInt32();
+        uint32 yellowi = fields[16].GetUInt32();
         config->SetPercentages(greytg, whitetg, greentg, bluetg, purpletg, orangetg, yellowtg, greyi, whitei, greeni, bluei, purplei, orangei, yellowi);
         //load min and max prices
-        config->SetMinPrice(AHB_GREY, CharacterDatabase.PQuery("SELECT minpricegrey FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMaxPrice(AHB_GREY, CharacterDatabase.PQuery("SELECT maxpricegrey FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMinPrice(AHB_WHITE, CharacterDatabase.PQuery("SELECT minpricewhite FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMaxPrice(AHB_WHITE, CharacterDatabase.PQuery("SELECT maxpricewhite FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMinPrice(AHB_GREEN, CharacterDatabase.PQuery("SELECT minpricegreen FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMaxPrice(AHB_GREEN, CharacterDatabase.PQuery("SELECT maxpricegreen FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMinPrice(AHB_BLUE, CharacterDatabase.PQuery("SELECT minpriceblue FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMaxPrice(AHB_BLUE, CharacterDatabase.PQuery("SELECT maxpriceblue FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMinPrice(AHB_PURPLE, CharacterDatabase.PQuery("SELECT minpricepurple FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMaxPrice(AHB_PURPLE, CharacterDatabase.PQuery("SELECT maxpricepurple FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMinPrice(AHB_ORANGE, CharacterDatabase.PQuery("SELECT minpriceorange FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMaxPrice(AHB_ORANGE, CharacterDatabase.PQuery("SELECT maxpriceorange FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMinPrice(AHB_YELLOW, CharacterDatabase.PQuery("SELECT minpriceyellow FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMaxPrice(AHB_YELLOW, CharacterDatabase.PQuery("SELECT maxpriceyellow FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
+        config->SetMinPrice(AHB_GREY, fields[17].GetUInt32());
+        config->SetMaxPrice(AHB_GREY, fields[18].GetUInt32());
+        config->SetMinPrice(AHB_WHITE, fields[19].GetUInt32());
+        config->SetMaxPrice(AHB_WHITE, fields[20].GetUInt32());
+        config->SetMinPrice(AHB_GREEN, fields[21].GetUInt32());
+        config->SetMaxPrice(AHB_GREEN, fields[22].GetUInt32());
+        config->SetMinPrice(AHB_BLUE, fields[23].GetUInt32());
+        config->SetMaxPrice(AHB_BLUE, fields[24].GetUInt32());
+        config->SetMinPrice(AHB_PURPLE, fields[25].GetUInt32());
+        config->SetMaxPrice(AHB_PURPLE, fields[26].GetUInt32());
+        config->SetMinPrice(AHB_ORANGE, fields[27].GetUInt32());
+        config->SetMaxPrice(AHB_ORANGE, fields[28].GetUInt32());
+        config->SetMinPrice(AHB_YELLOW, fields[29].GetUInt32());
+        config->SetMaxPrice(AHB_YELLOW, fields[30].GetUInt32());
         //load min and max bid prices
-        config->SetMinBidPrice(AHB_GREY, CharacterDatabase.PQuery("SELECT minbidpricegrey FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMaxBidPrice(AHB_GREY, CharacterDatabase.PQuery("SELECT maxbidpricegrey FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMinBidPrice(AHB_WHITE, CharacterDatabase.PQuery("SELECT minbidpricewhite FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMaxBidPrice(AHB_WHITE, CharacterDatabase.PQuery("SELECT maxbidpricewhite FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMinBidPrice(AHB_GREEN, CharacterDatabase.PQuery("SELECT minbidpricegreen FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMaxBidPrice(AHB_GREEN, CharacterDatabase.PQuery("SELECT maxbidpricegreen FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMinBidPrice(AHB_BLUE, CharacterDatabase.PQuery("SELECT minbidpriceblue FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMaxBidPrice(AHB_BLUE, CharacterDatabase.PQuery("SELECT maxbidpriceblue FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMinBidPrice(AHB_PURPLE, CharacterDatabase.PQuery("SELECT minbidpricepurple FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMaxBidPrice(AHB_PURPLE, CharacterDatabase.PQuery("SELECT maxbidpricepurple FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMinBidPrice(AHB_ORANGE, CharacterDatabase.PQuery("SELECT minbidpriceorange FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMaxBidPrice(AHB_ORANGE, CharacterDatabase.PQuery("SELECT maxbidpriceorange FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMinBidPrice(AHB_YELLOW, CharacterDatabase.PQuery("SELECT minbidpriceyellow FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMaxBidPrice(AHB_YELLOW, CharacterDatabase.PQuery("SELECT maxbidpriceyellow FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
+        config->SetMinBidPrice(AHB_GREY, fields[31].GetUInt32());
+        config->SetMaxBidPrice(AHB_GREY, fields[32].GetUInt32());
+        config->SetMinBidPrice(AHB_WHITE, fields[33].GetUInt32());
+        config->SetMaxBidPrice(AHB_WHITE, fields[34].GetUInt32());
+        config->SetMinBidPrice(AHB_GREEN, fields[35].GetUInt32());
+        config->SetMaxBidPrice(AHB_GREEN, fields[36].GetUInt32());
+        config->SetMinBidPrice(AHB_BLUE, fields[37].GetUInt32());
+        config->SetMaxBidPrice(AHB_BLUE, fields[38].GetUInt32());
+        config->SetMinBidPrice(AHB_PURPLE, fields[39].GetUInt32());
+        config->SetMaxBidPrice(AHB_PURPLE, fields[40].GetUInt32());
+        config->SetMinBidPrice(AHB_ORANGE, fields[41].GetUInt32());
+        config->SetMaxBidPrice(AHB_ORANGE, fields[42].GetUInt32());
+        config->SetMinBidPrice(AHB_YELLOW, fields[43].GetUInt32());
+        config->SetMaxBidPrice(AHB_YELLOW, fields[44].GetUInt32());
         //load max stacks
-        config->SetMaxStack(AHB_GREY, CharacterDatabase.PQuery("SELECT maxstackgrey FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMaxStack(AHB_WHITE, CharacterDatabase.PQuery("SELECT maxstackwhite FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMaxStack(AHB_GREEN, CharacterDatabase.PQuery("SELECT maxstackgreen FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMaxStack(AHB_BLUE, CharacterDatabase.PQuery("SELECT maxstackblue FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMaxStack(AHB_PURPLE, CharacterDatabase.PQuery("SELECT maxstackpurple FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMaxStack(AHB_ORANGE, CharacterDatabase.PQuery("SELECT maxstackorange FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMaxStack(AHB_YELLOW, CharacterDatabase.PQuery("SELECT maxstackyellow FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
+        config->SetMaxStack(AHB_GREY, fields[45].GetUInt32());
+        config->SetMaxStack(AHB_WHITE, fields[46].GetUInt32());
+        config->SetMaxStack(AHB_GREEN, fields[47].GetUInt32());
+        config->SetMaxStack(AHB_BLUE, fields[48].GetUInt32());
+        config->SetMaxStack(AHB_PURPLE, fields[49].GetUInt32());
+        config->SetMaxStack(AHB_ORANGE, fields[50].GetUInt32());
+        config->SetMaxStack(AHB_YELLOW, fields[51].GetUInt32());
         if (debug_Out)
         {
             sLog->outString("minItems                = %u", config->GetMinItems());
@@ -1940,7 +1945,7 @@ void AuctionHouseBot::LoadValues(AHBConfig *config)
         }
         if (debug_Out)
         {
-            sLog->outString(((std::string)("Current Settings for %s Auctionhouses:", CharacterDatabase.PQuery("SELECT name FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetString())).c_str());
+            sLog->outString("Current Settings for %s Auctionhouses:", fields[0].GetString().c_str());
             sLog->outString("Grey Trade Goods\t%u\tGrey Items\t%u", config->GetItemCounts(AHB_GREY_TG), config->GetItemCounts(AHB_GREY_I));
             sLog->outString("White Trade Goods\t%u\tWhite Items\t%u", config->GetItemCounts(AHB_WHITE_TG), config->GetItemCounts(AHB_WHITE_I));
             sLog->outString("Green Trade Goods\t%u\tGreen Items\t%u", config->GetItemCounts(AHB_GREEN_TG), config->GetItemCounts(AHB_GREEN_I));
@@ -1953,17 +1958,17 @@ void AuctionHouseBot::LoadValues(AHBConfig *config)
     if (AHBBuyer)
     {
         //load buyer bid prices
-        config->SetBuyerPrice(AHB_GREY, CharacterDatabase.PQuery("SELECT buyerpricegrey FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
-        config->SetBuyerPrice(AHB_WHITE, CharacterDatabase.PQuery("SELECT buyerpricewhite FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
-        config->SetBuyerPrice(AHB_GREEN, CharacterDatabase.PQuery("SELECT buyerpricegreen FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
-        config->SetBuyerPrice(AHB_BLUE, CharacterDatabase.PQuery("SELECT buyerpriceblue FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
-        config->SetBuyerPrice(AHB_PURPLE, CharacterDatabase.PQuery("SELECT buyerpricepurple FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
-        config->SetBuyerPrice(AHB_ORANGE, CharacterDatabase.PQuery("SELECT buyerpriceorange FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
-        config->SetBuyerPrice(AHB_YELLOW, CharacterDatabase.PQuery("SELECT buyerpriceyellow FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
+        config->SetBuyerPrice(AHB_GREY, fields[52].GetUInt32());
+        config->SetBuyerPrice(AHB_WHITE, fields[53].GetUInt32());
+        config->SetBuyerPrice(AHB_GREEN, fields[54].GetUInt32());
+        config->SetBuyerPrice(AHB_BLUE, fields[55].GetUInt32());
+        config->SetBuyerPrice(AHB_PURPLE, fields[56].GetUInt32());
+        config->SetBuyerPrice(AHB_ORANGE, fields[57].GetUInt32());
+        config->SetBuyerPrice(AHB_YELLOW, fields[58].GetUInt32());
         //load bidding interval
-        config->SetBiddingInterval(CharacterDatabase.PQuery("SELECT buyerbiddinginterval FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
+        config->SetBiddingInterval(fields[59].GetUInt32());
         //load bids per interval
-        config->SetBidsPerInterval(CharacterDatabase.PQuery("SELECT buyerbidsperinterval FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetUInt32());
+        config->SetBidsPerInterval(fields[60].GetUInt32());
         if (debug_Out)
         {
             sLog->outString("buyerPriceGrey          = %u", config->GetBuyerPrice(AHB_GREY));
@@ -1977,5 +1982,5 @@ void AuctionHouseBot::LoadValues(AHBConfig *config)
             sLog->outString("buyerBidsPerInterval    = %u", config->GetBidsPerInterval());
         }
     }
-    if (debug_Out) sLog->outString(((std::string)("End Settings for %s Auctionhouses:", CharacterDatabase.PQuery("SELECT name FROM auctionhousebot WHERE auctionhouse = %u",config->GetAHID())->Fetch()->GetString())).c_str());
+    if (debug_Out) sLog->outString("End Settings for %s Auctionhouses:", fields[0].GetString().c_str());
 }
@@ -32,6 +32,7 @@
 #include "Language.h"
 #include "Logging/Log.h"
 #include <vector>
+#include <algorithm>
 
 enum eAuctionHouse
 {
@@ -465,6 +466,9 @@ void AuctionHouseObject::AddAuction(AuctionEntry *auction)
     ASSERT(auction);
 
     AuctionsMap[auction->Id] = auction;
+    m_expiryQueue.insert(AuctionExpiryQueue::value_type(auction->expire_time, auction->Id));
+    _AddToIndexes(auction);
+    _AddBidCandidate(auction);
     sScriptMgr->OnAuctionAdd(this, auction);
 	auctionbot.IncrementItemCounts(auction);
 
@@ -475,6 +479,19 @@ bool AuctionHouseObject::RemoveAuction(AuctionEntry *auction, uint32 item_templa
 	auctionbot.DecrementItemCounts(auction, item_template);
     bool wasInMap = AuctionsMap.erase(auction->Id) ? true : false;
 
+    std::pair<AuctionExpiryQueue::iterator, AuctionExpiryQueue::iterator> range = m_expiryQueue.equal_range(auction->expire_time);
+    for (AuctionExpiryQueue::iterator itr = range.first; itr != range.second; ++itr)
+    {
+        if (itr->second == auction->Id)
+        {
+            m_expiryQueue.erase(itr);
+            break;
+        }
+    }
+
+    _RemoveFromIndexes(auction);
+    _RemoveBidCandidate(auction);
+
     sScriptMgr->OnAuctionRemove(this, auction);
 
     // we need to delete the entry, it is not referenced any more
@@ -482,27 +499,135 @@ bool AuctionHouseObject::RemoveAuction(AuctionEntry *auction, uint32 item_templa
     return wasInMap;
 }
 
-void AuctionHouseObject::Update()
+void AuctionHouseObject::SetAuctionExpireTime(AuctionEntry* auction, time_t expireTime)
 {
-    time_t curTime = sWorld->GetGameTime();
-    ///- Handle expired auctions
+    std::pair<AuctionExpiryQueue::iterator, AuctionExpiryQueue::iterator> range = m_expiryQueue.equal_range(auction->expire_time);
+    for (AuctionExpiryQueue::iterator itr = range.first; itr != range.second; ++itr)
+    {
+        if (itr->second == auction->Id)
+        {
+            m_expiryQueue.erase(itr);
+            break;
+        }
+    }
+
+    auction->expire_time = expireTime;
+    m_expiryQueue.insert(AuctionExpiryQueue::value_type(expireTime, auction->Id));
+}
 
-    // If storage is empty, no need to update. next == NULL in this case.
-    if (AuctionsMap.empty())
+void AuctionHouseObject::_AddToIndexes(AuctionEntry* auction)
+{
+    ItemPrototype const* proto = sObjectMgr->GetItemPrototype(auction->item_template);
+    if (!proto)
         return;
 
-    QueryResult result = CharacterDatabase.PQuery("SELECT id FROM auctionhouse WHERE time <= %u ORDER BY TIME ASC", (uint32)curTime+60);
+    AuctionSearchInfo& info = m_searchInfo[auction->Id];
+    info.itemClass = proto->Class;
+    info.itemSubClass = proto->SubClass;
+    info.inventoryType = proto->InventoryType;
+    info.quality = proto->Quality;
+    info.requiredLevel = proto->RequiredLevel;
+    info.names.clear();
 
-    if (!result)
+    m_searchIndex[MakeSearchKey(info.itemClass, info.itemSubClass, info.inventoryType)].insert(auction->Id);
+}
+
+void AuctionHouseObject::_RemoveFromIndexes(AuctionEntry* auction)
+{
+    AuctionSearchInfoMap::iterator itr = m_searchInfo.find(auction->Id);
+    if (itr == m_searchInfo.end())
         return;
 
-    do
+    AuctionSearchIndex::iterator bucket = m_searchIndex.find(MakeSearchKey(itr->second.itemClass, itr->second.itemSubClass, itr->second.inventoryType));
+    if (bucket != m_searchIndex.end())
+    {
+        bucket->second.erase(auction->Id);
+        if (bucket->second.empty())
+            m_searchIndex.erase(bucket);
+    }
+
+    m_searchInfo.erase(itr);
+}
+
+void AuctionHouseObject::_AddBidCandidate(AuctionEntry* auction)
+{
+    if (m_botOwner && auction->owner == m_botOwner)
+        return;
+
+    if (m_bidCandidateSlots.find(auction->Id) != m_bidCandidateSlots.end())
+        return;
+
+    m_bidCandidateSlots[auction->Id] = m_bidCandidates.size();
+    m_bidCandidates.push_back(auction->Id);
+}
+
+void AuctionHouseObject::_RemoveBidCandidate(AuctionEntry* auction)
+{
+    UNORDERED_MAP<uint32, uint32>::iterator itr = m_bidCandidateSlots.find(auction->Id);
+    if (itr == m_bidCandidateSlots.end())
+        return;
+
+    uint32 slot = itr->second;
+    m_bidCandidateSlots.erase(itr);
+
+    uint32 lastId = m_bidCandidates.back();
+    m_bidCandidates.pop_back();
+    if (slot < m_bidCandidates.size())
+    {
+        m_bidCandidates[slot] = lastId;
+        m_bidCandidateSlots[lastId] = slot;
+    }
+}
+
+void AuctionHouseObject::SetBotOwner(uint32 ownerGuid)
+{
+    m_botOwner = ownerGuid;
+
+    // auctions are loaded before the bot knows its character, so the candidates are rebuilt here
+    m_bidCandidates.clear();
+    m_bidCandidateSlots.clear();
+    m_bidCandidates.reserve(AuctionsMap.size());
+    for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
+        _AddBidCandidate(itr->second);
+}
+
+void AuctionHouseObject::SampleBidCandidates(uint32 bidderGuid, uint32 count, std::vector<AuctionEntry*>& auctions) const
+{
+    if (m_bidCandidates.empty() || !count)
+        return;
+
+    // random probing with a bounded number of tries, so a house full of our own bids does not spin
+    std::set<uint32> picked;
+    uint32 attempts = count * 4;
+    while (auctions.size() < count && picked.size() < m_bidCandidates.size() && attempts--)
+    {
+        uint32 slot = urand(0, m_bidCandidates.size() - 1);
+        if (!picked.insert(slot).second)
+            continue;
+
+        AuctionEntry* auction = GetAuction(m_bidCandidates[slot]);
+        if (!auction || auction->bidder == bidderGuid)
+            continue;
+
+        auctions.push_back(auction);
+    }
+}
+
+void AuctionHouseObject::Update()
+{
+    time_t curTime = sWorld->GetGameTime();
+    ///- Handle expired auctions
+
+    // the queue is ordered by expire time, everything due within the next minute is handled like before
+    while (!m_expiryQueue.empty() && m_expiryQueue.begin()->first <= curTime + 60)
     {
-        // from auctionhousehandler.cpp, creates auction pointer & player pointer
-        AuctionEntry* auction = GetAuction(result->Fetch()->GetUInt32());
+        AuctionEntry* auction = GetAuction(m_expiryQueue.begin()->second);
 
         if (!auction)
+        {
+            m_expiryQueue.erase(m_expiryQueue.begin());
             continue;
+        }
 
         SQLTransaction trans = CharacterDatabase.BeginTransaction();
 
@@ -529,10 +654,10 @@ void AuctionHouseObject::Update()
         auction->DeleteFromDB(trans);
         CharacterDatabase.CommitTransaction(trans);
 
+        uint32 itemGuidLow = auction->item_guidlow;
         RemoveAuction(auction, item_template);
-        sAuctionMgr->RemoveAItem(auction->item_guidlow);
+        sAuctionMgr->RemoveAItem(itemGuidLow);
     }
-    while (result->NextRow());
 }
 
 void AuctionHouseObject::BuildListBidderItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount)
@@ -565,6 +690,60 @@ void AuctionHouseObject::BuildListOwnerItems(WorldPacket& data, Player* player,
     }
 }
 
+std::wstring const& AuctionHouseObject::_GetSearchName(AuctionSearchInfo& info, Item* item, int locIdx, int locdbcIdx)
+{
+    uint32 key = (uint32(locIdx + 1) << 16) | uint32(locdbcIdx + 1);
+    std::map<uint32, std::wstring>::iterator itr = info.names.find(key);
+    if (itr != info.names.end())
+        return itr->second;
+
+    std::wstring& wname = info.names[key];
+
+    ItemPrototype const* proto = item->GetProto();
+    std::string name = proto->Name1;
+    if (name.empty())
+        return wname;
+
+    // local name
+    if (locIdx >= 0)
+        if (ItemLocale const *il = sObjectMgr->GetItemLocale(proto->ItemId))
+            sObjectMgr->GetLocaleString(il->Name, locIdx, name);
+
+    // DO NOT use GetItemEnchantMod(proto->RandomProperty) as it may return a result
+    //  that matches the search but it may not equal item->GetItemRandomPropertyId()
+    //  used in BuildAuctionInfo() which then causes wrong items to be listed
+    int32 propRefID = item->GetItemRandomPropertyId();
+
+    if (propRefID)
+    {
+        // Append the suffix to the name (ie: of the Monkey) if one exists
+        // These are found in ItemRandomProperties.dbc, not ItemRandomSuffix.dbc
+        //  even though the DBC names seem misleading
+        const ItemRandomPropertiesEntry *itemRandProp = sItemRandomPropertiesStore.LookupEntry(propRefID);
+
+        if (itemRandProp)
+        {
+            char* const* temp = itemRandProp->nameSuffix;
+
+            // dbc local name
+            if (temp)
+            {
+                // Append the suffix (ie: of the Monkey) to the name using localization,
+                // invalid localization uses the default enUS
+                name += " ";
+                name += temp[locdbcIdx >= 0 ? locdbcIdx : LOCALE_enUS];
+            }
+        }
+    }
+
+    if (Utf8toWStr(name, wname))
+        wstrToLower(wname);
+    else
+        wname.clear();
+
+    return wname;
+}
+
 void AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, Player* player,
     std::wstring const& wsearchedname, uint32 listfrom, uint8 levelmin, uint8 levelmax, uint8 usable,
     uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality,
@@ -573,28 +752,87 @@ void AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, Player* player
     int loc_idx = player->GetSession()->GetSessionDbLocaleIndex();
     int locdbc_idx = player->GetSession()->GetSessionDbcLocale();
 
-    for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
+    // Narrow the candidates down with the (class, subclass, inventory type) index when the client filters on
+    // a class, the results have to stay in auction id order for paging
+    std::vector<uint32> candidates;
+    bool useIndex = itemClass != 0xffffffff;
+    if (useIndex)
     {
-        AuctionEntry *Aentry = itr->second;
-        Item *item = sAuctionMgr->GetAItem(Aentry->item_guidlow);
-        if (!item)
+        AuctionSearchIndex::const_iterator begin, end;
+        if (itemSubClass != 0xffffffff && inventoryType != 0xffffffff)
+        {
+            begin = m_searchIndex.find(MakeSearchKey(itemClass, itemSubClass, inventoryType));
+            end = begin;
+            if (end != m_searchIndex.end())
+                ++end;
+        }
+        else if (itemSubClass != 0xffffffff)
+        {
+            begin = m_searchIndex.lower_bound(MakeSearchKey(itemClass, itemSubClass, 0));
+            end = m_searchIndex.lower_bound(MakeSearchKey(itemClass, itemSubClass + 1, 0));
+        }
+        else
+        {
+            begin = m_searchIndex.lower_bound(MakeSearchKey(itemClass, 0, 0));
+            end = m_searchIndex.lower_bound(MakeSearchKey(itemClass + 1, 0, 0));
+        }
+
+        size_t buckets = 0;
+        for (AuctionSearchIndex::const_iterator itr = begin; itr != end; ++itr, ++buckets)
+        {
+            if (inventoryType != 0xffffffff && uint32(itr->first & 0xFFFFF) != inventoryType)
+                continue;
+
+            candidates.insert(candidates.end(), itr->second.begin(), itr->second.end());
+        }
+
+        if (buckets > 1)
+            std::sort(candidates.begin(), candidates.end());
+    }
+
+    AuctionEntryMap::const_iterator mapItr = AuctionsMap.begin();
+    std::vector<uint32>::const_iterator candItr = candidates.begin();
+    for (;;)
+    {
+        AuctionEntry *Aentry;
+        if (useIndex)
+        {
+            if (candItr == candidates.end())
+                break;
+            Aentry = GetAuction(*candItr++);
+            if (!Aentry)
+                continue;
+        }
+        else
+        {
+            if (mapItr == AuctionsMap.end())
+                break;
+            Aentry = (mapItr++)->second;
+        }
+
+        AuctionSearchInfoMap::iterator infoItr = m_searchInfo.find(Aentry->Id);
+        if (infoItr == m_searchInfo.end())
             continue;
 
-        ItemPrototype const *proto = item->GetProto();
+        AuctionSearchInfo& info = infoItr->second;
 
-        if (itemClass != 0xffffffff && proto->Class != itemClass)
+        if (itemClass != 0xffffffff && info.itemClass != itemClass)
             continue;
 
-        if (itemSubClass != 0xffffffff && proto->SubClass != itemSubClass)
+        if (itemSubClass != 0xffffffff && info.itemSubClass != itemSubClass)
             continue;
 
-        if (inventoryType != 0xffffffff && proto->InventoryType != inventoryType)
+        if (inventoryType != 0xffffffff && info.inventoryType != inventoryType)
             continue;
 
-        if (quality != 0xffffffff && proto->Quality != quality)
+        if (quality != 0xffffffff && info.quality != quality)
             continue;
 
-        if (levelmin != 0x00 && (proto->RequiredLevel < levelmin || (levelmax != 0x00 && proto->RequiredLevel > levelmax)))
+        if (levelmin != 0x00 && (info.requiredLevel < levelmin || (levelmax != 0x00 && info.requiredLevel > levelmax)))
+            continue;
+
+        Item *item = sAuctionMgr->GetAItem(Aentry->item_guidlow);
+        if (!item)
             continue;
 
         if (usable != 0x00 && player->CanUseItem(item) != EQUIP_ERR_OK)
@@ -604,53 +842,8 @@ void AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, Player* player
         // No need to do any of this if no search term was entered
         if (!wsearchedname.empty())
         {
-            std::string name = proto->Name1;
-            if (name.empty())
-                continue;
-
-            // local name
-            if (loc_idx >= 0)
-                if (ItemLocale const *il = sObjectMgr->GetItemLocale(proto->ItemId))
-                    sObjectMgr->GetLocaleString(il->Name, loc_idx, name);
-
-            // DO NOT use GetItemEnchantMod(proto->RandomProperty) as it may return a result
-            //  that matches the search but it may not equal item->GetItemRandomPropertyId()
-            //  used in BuildAuctionInfo() which then causes wrong items to be listed
-            int32 propRefID = item->GetItemRandomPropertyId();
-
-            if (propRefID)
-            {
-                // Append the suffix to the name (ie: of the Monkey) if one exists
-                // These are found in ItemRandomProperties.dbc, not ItemRandomSuffix.dbc
-                //  even though the DBC names seem misleading
-                const ItemRandomPropertiesEntry *itemRandProp = sItemRandomPropertiesStore.LookupEntry(propRefID);
-
-                if (itemRandProp)
-                {
-                    char* const* temp = itemRandProp->nameSuffix;
-                    //char* temp = itemRandProp->nameSuffix;
-
-                    // dbc local name
-                    if (temp)
-                    {
-                        if (locdbc_idx >= 0)
-                        {
-                            // Append the suffix (ie: of the Monkey) to the name using localization
-                            name += " ";
-                            name += temp[locdbc_idx];
-                        }
-                        else
-                        {
-                            // Invalid localization? Append the suffix using default enUS
-                            name += " ";
-                            name += temp[LOCALE_enUS];
-                        }
-                    }
-                }
-            }
-
-            // Perform the search (with or without suffix)
-            if (!Utf8FitTo(name, wsearchedname))
+            std::wstring const& name = _GetSearchName(info, item, loc_idx, locdbc_idx);
+            if (name.empty() || name.find(wsearchedname) == std::wstring::npos)
                 continue;
         }
 
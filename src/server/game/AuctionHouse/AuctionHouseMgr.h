@@ -80,7 +80,7 @@ class AuctionHouseObject
 {
   public:
     // Initialize storage
-    AuctionHouseObject() { next = AuctionsMap.begin(); }
+    AuctionHouseObject() : m_botOwner(0) { next = AuctionsMap.begin(); }
     ~AuctionHouseObject()
     {
         for (AuctionEntryMap::iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
@@ -88,6 +88,7 @@ class AuctionHouseObject
     }
 
     typedef std::map<uint32, AuctionEntry*> AuctionEntryMap;
+    typedef std::multimap<time_t, uint32> AuctionExpiryQueue;
 
     uint32 Getcount() { return AuctionsMap.size(); }
 
@@ -104,8 +105,17 @@ class AuctionHouseObject
 
     bool RemoveAuction(AuctionEntry *auction, uint32 item_template);
 
+    // expire_time must only be changed through this, the auction is keyed by it in the expiry queue
+    void SetAuctionExpireTime(AuctionEntry* auction, time_t expireTime);
+
     void Update();
 
+    // Auctions owned by this character are left out of the bid candidates, set by the auction house bot
+    void SetBotOwner(uint32 ownerGuid);
+    // Picks up to 'count' distinct random auctions not owned by the bot and not already bid on by 'bidderGuid'
+    void SampleBidCandidates(uint32 bidderGuid, uint32 count, std::vector<AuctionEntry*>& auctions) const;
+    uint32 GetBidCandidateCount() const { return m_bidCandidates.size(); }
+
     void BuildListBidderItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount);
     void BuildListOwnerItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount);
     void BuildListAuctionItems(WorldPacket& data, Player* player,
@@ -114,7 +124,43 @@ class AuctionHouseObject
         uint32& count, uint32& totalcount);
 
   private:
+    // Item template data of an auction needed by browse searches, kept so that a search
+    // does not have to look up the item and its prototype for every auction
+    struct AuctionSearchInfo
+    {
+        uint32 itemClass;
+        uint32 itemSubClass;
+        uint32 inventoryType;
+        uint32 quality;
+        uint32 requiredLevel;
+        std::map<uint32, std::wstring> names;               // lower case name with suffix, per (db locale, dbc locale) pair
+    };
+
+    typedef UNORDERED_MAP<uint32, AuctionSearchInfo> AuctionSearchInfoMap;
+    typedef std::set<uint32> AuctionIdSet;
+    typedef std::map<uint64, AuctionIdSet> AuctionSearchIndex;  // (class, subclass, inventory type) -> auction ids
+
+    static uint64 MakeSearchKey(uint32 itemClass, uint32 itemSubClass, uint32 inventoryType)
+    {
+        return (uint64(itemClass) << 40) | (uint64(itemSubClass) << 20) | uint64(inventoryType);
+    }
+
+    void _AddToIndexes(AuctionEntry* auction);
+    void _RemoveFromIndexes(AuctionEntry* auction);
+    void _AddBidCandidate(AuctionEntry* auction);
+    void _RemoveBidCandidate(AuctionEntry* auction);
+    std::wstring const& _GetSearchName(AuctionSearchInfo& info, Item* item, int locIdx, int locdbcIdx);
+
     AuctionEntryMap AuctionsMap;
+    AuctionExpiryQueue m_expiryQueue;
+    AuctionSearchInfoMap m_searchInfo;
+    AuctionSearchIndex m_searchIndex;
+
+    // ids of auctions the bot may bid on, a flat array so that random picks are O(1),
+    // with the slot of every id so that removal is a swap with the last element
+    uint32 m_botOwner;
+    std::vector<uint32> m_bidCandidates;
+    UNORDERED_MAP<uint32, uint32> m_bidCandidateSlots;
 
     // storage for "next" auction item for next Update()
     AuctionEntryMap::const_iterator next;
@@ -22,6 +22,7 @@
 #include "ArenaTeam.h"
 #include "World.h"
 #include "Group.h"
+#include "CharacterCache.h"
 
 void ArenaTeamMember::ModifyPersonalRating(Player* plr, int32 mod, uint32 slot)
 {
@@ -124,16 +125,15 @@ bool ArenaTeam::AddMember(const uint64& PlayerGuid)
     }
     else
     {
-        //                                                     0     1
-        QueryResult result = CharacterDatabase.PQuery("SELECT name, class FROM characters WHERE guid='%u'", GUID_LOPART(PlayerGuid));
-        if (!result)
+        CharacterCacheEntry entry;
+        if (!sCharacterCache->GetCharacter(GUID_LOPART(PlayerGuid), entry))
             return false;
 
-        plName = (*result)[0].GetString();
-        plClass = (*result)[1].GetUInt8();
+        plName = entry.name;
+        plClass = entry.playerClass;
 
         // check if player already in arenateam of that size
-        if (Player::GetArenaTeamIdFromDB(PlayerGuid, GetType()) != 0)
+        if (entry.arenaTeamId[GetSlot()] != 0)
         {
             sLog->outError("Arena::AddMember() : player already in this sized team");
             return false;
@@ -172,6 +172,7 @@ bool ArenaTeam::AddMember(const uint64& PlayerGuid)
     m_members.push_back(newmember);
 
     CharacterDatabase.PExecute("INSERT INTO arena_team_member (arenateamid, guid) VALUES ('%u', '%u')", m_TeamId, GUID_LOPART(newmember.guid));
+    sCharacterCache->UpdateArenaTeam(GUID_LOPART(newmember.guid), GetSlot(), m_TeamId);
 
     if (pl)
     {
@@ -328,6 +329,7 @@ void ArenaTeam::DelMember(uint64 guid)
         sLog->outArena("Player: %s [GUID: %u] left arena team type: %u [Id: %u].", player->GetName(), player->GetGUIDLow(), GetType(), GetId());
     }
     CharacterDatabase.PExecute("DELETE FROM arena_team_member WHERE arenateamid = '%u' AND guid = '%u'", GetId(), GUID_LOPART(guid));
+    sCharacterCache->UpdateArenaTeam(GUID_LOPART(guid), GetSlot(), 0);
 }
 
 void ArenaTeam::Disband(WorldSession *session)
@@ -1601,7 +1601,7 @@ void Battleground::SpawnBGCreature(uint32 type, uint32 respawntime)
         {
             //obj->Respawn();                               // bugged
             obj->SetRespawnTime(0);
-            sObjectMgr->RemoveCreatureRespawnTime(obj->GetGUIDLow(), GetInstanceID());
+            map->RemoveCreatureRespawnTime(obj->GetGUIDLow());
             map->Add(obj);
         }
     }
@@ -22,6 +22,7 @@
 #include "SocialMgr.h"
 #include "World.h"
 #include "DatabaseEnv.h"
+#include "ChannelBroadcaster.h"
 
 Channel::Channel(const std::string& name, uint32 channel_id, uint32 Team)
  : m_announce(true), m_ownership(true), m_name(name), m_password(""), m_flags(0), m_channelId(channel_id), m_ownerGUID(0), m_Team(Team)
@@ -192,10 +193,7 @@ void Channel::Join(uint64 p, const char *pass)
 
     data.clear();
 
-    PlayerInfo pinfo;
-    pinfo.player = p;
-    pinfo.flags = MEMBER_FLAG_NONE;
-    players[p] = pinfo;
+    AddMember(p, plr ? plr->GetSession() : NULL);
 
     MakeYouJoined(&data);
     SendToOne(&data, p);
@@ -245,7 +243,7 @@ void Channel::Leave(uint64 p, bool send)
 
         bool changeowner = players[p].IsOwner();
 
-        players.erase(p);
+        RemoveMember(p);
         if (m_announce && (!plr || plr->GetSession()->GetSecurity() < SEC_GAMEMASTER || !sWorld->getBoolConfig(CONFIG_SILENTLY_GM_JOIN_TO_CHANNEL)))
         {
             WorldPacket data;
@@ -322,7 +320,7 @@ void Channel::KickOrBan(uint64 good, const char *badname, bool ban)
                 MakePlayerKicked(&data, bad->GetGUID(), good);
 
             SendToAll(&data);
-            players.erase(bad->GetGUID());
+            RemoveMember(bad->GetGUID());
             bad->LeftChannel(this);
 
             if (changeowner && m_ownership && !players.empty())
@@ -564,7 +562,7 @@ void Channel::List(Player* player)
         uint32 count  = 0;
         for (PlayerList::const_iterator i = players.begin(); i != players.end(); ++i)
         {
-            Player *plr = sObjectMgr->GetPlayer(i->first);
+            Player *plr = i->second.session ? i->second.session->GetPlayer() : NULL;
 
             // PLAYER can't see MODERATOR, GAME MASTER, ADMINISTRATOR characters
             // MODERATOR, GAME MASTER, ADMINISTRATOR can see all
@@ -746,36 +744,93 @@ void Channel::SetOwner(uint64 guid, bool exclaim)
     }
 }
 
-void Channel::SendToAll(WorldPacket *data, uint64 p)
+void Channel::AddMember(uint64 guid, WorldSession* session)
+{
+    PlayerInfo pinfo;
+    pinfo.player = guid;
+    pinfo.flags = MEMBER_FLAG_NONE;
+    pinfo.session = session;
+    pinfo.memberSlot = m_members.size();
+    players[guid] = pinfo;
+
+    ChannelMember member;
+    member.guid = guid;
+    member.session = session;
+    m_members.push_back(member);
+}
+
+void Channel::RemoveMember(uint64 guid)
 {
-    for (PlayerList::const_iterator i = players.begin(); i != players.end(); ++i)
+    PlayerList::iterator itr = players.find(guid);
+    if (itr == players.end())
+        return;
+
+    uint32 slot = itr->second.memberSlot;
+    players.erase(itr);
+
+    if (slot >= m_members.size() || m_members[slot].guid != guid)
+        return;
+
+    // keep the list dense, the last member takes the freed slot
+    if (slot != m_members.size() - 1)
     {
-        Player *plr = sObjectMgr->GetPlayer(i->first);
-        if (plr)
-        {
-            if (!p || !plr->GetSocial()->HasIgnore(GUID_LOPART(p)))
-                plr->GetSession()->SendPacket(data);
-        }
+        m_members[slot] = m_members.back();
+        players[m_members[slot].guid].memberSlot = slot;
     }
+    m_members.pop_back();
 }
 
-void Channel::SendToAllButOne(WorldPacket *data, uint64 who)
+WorldSession* Channel::GetMemberSession(uint64 guid) const
 {
-    for (PlayerList::const_iterator i = players.begin(); i != players.end(); ++i)
+    PlayerList::const_iterator itr = players.find(guid);
+    return itr != players.end() ? itr->second.session : NULL;
+}
+
+void Channel::SendToAll(WorldPacket *data, uint64 p)
+{
+    // large channels only collect the sockets here, the packets are written by the broadcaster thread
+    uint32 threshold = sWorld->getIntConfig(CONFIG_CHANNEL_BROADCAST_THRESHOLD);
+    bool async = threshold && m_members.size() >= threshold && sChannelBroadcaster->IsActive();
+
+    BroadcastSocketList sockets;
+    if (async)
+        sockets.reserve(m_members.size());
+
+    for (MemberList::const_iterator i = m_members.begin(); i != m_members.end(); ++i)
     {
-        if (i->first != who)
+        WorldSession* session = i->session;
+        if (!session)
+            continue;
+
+        if (p)
         {
-            Player *plr = sObjectMgr->GetPlayer(i->first);
-            if (plr)
-                plr->GetSession()->SendPacket(data);
+            Player* plr = session->GetPlayer();
+            if (!plr || plr->GetSocial()->HasIgnore(GUID_LOPART(p)))
+                continue;
         }
+
+        if (!async)
+            session->SendPacket(data);
+        else if (WorldSocket* socket = session->AcquireSocket())
+            sockets.push_back(socket);
     }
+
+    if (async)
+        sChannelBroadcaster->Broadcast(*data, sockets);
+}
+
+void Channel::SendToAllButOne(WorldPacket *data, uint64 who)
+{
+    for (MemberList::const_iterator i = m_members.begin(); i != m_members.end(); ++i)
+        if (i->guid != who && i->session)
+            i->session->SendPacket(data);
 }
 
 void Channel::SendToOne(WorldPacket *data, uint64 who)
 {
-    Player *plr = sObjectMgr->GetPlayer(who);
-    if (plr)
+    if (WorldSession* session = GetMemberSession(who))
+        session->SendPacket(data);
+    else if (Player *plr = sObjectMgr->GetPlayer(who))
         plr->GetSession()->SendPacket(data);
 }
 
@@ -22,6 +22,7 @@
 #include <list>
 #include <map>
 #include <string>
+#include <vector>
 
 #include "Common.h"
 
@@ -122,6 +123,8 @@ class Channel
     {
         uint64 player;
         uint8 flags;
+        WorldSession* session;                              // cached at join, members leave before their session is deleted
+        uint32 memberSlot;                                  // index in m_members
 
         bool HasFlag(uint8 flag) const { return flags & flag; }
         void SetFlag(uint8 flag) { if (!HasFlag(flag)) flags |= flag; }
@@ -147,6 +150,16 @@ class Channel
 
     typedef     std::map<uint64, PlayerInfo> PlayerList;
     PlayerList  players;
+
+    // dense copy of the member sessions for broadcasts, kept in sync with players
+    struct ChannelMember
+    {
+        uint64 guid;
+        WorldSession* session;
+    };
+    typedef     std::vector<ChannelMember> MemberList;
+    MemberList  m_members;
+
     typedef     std::set<uint64> BannedList;
     BannedList  banned;
     bool        m_announce;
@@ -197,6 +210,10 @@ class Channel
         void MakeVoiceOn(WorldPacket *data, uint64 guid);                       //+ 0x22
         void MakeVoiceOff(WorldPacket *data, uint64 guid);                      //+ 0x23
 
+        void AddMember(uint64 guid, WorldSession* session);
+        void RemoveMember(uint64 guid);
+        WorldSession* GetMemberSession(uint64 guid) const;
+
         void SendToAll(WorldPacket *data, uint64 p = 0);
         void SendToAllButOne(WorldPacket *data, uint64 who);
         void SendToOne(WorldPacket *data, uint64 who);
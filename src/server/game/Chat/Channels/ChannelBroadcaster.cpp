@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ChannelBroadcaster.h"
+#include "WorldPacket.h"
+#include "WorldSocket.h"
+
+class ChannelBroadcastRequest : public ACE_Method_Request
+{
+    public:
+        ChannelBroadcastRequest(WorldPacket const& packet, BroadcastSocketList& sockets) : m_packet(packet)
+        {
+            m_sockets.swap(sockets);
+        }
+
+        ~ChannelBroadcastRequest()
+        {
+            for (BroadcastSocketList::const_iterator itr = m_sockets.begin(); itr != m_sockets.end(); ++itr)
+                (*itr)->RemoveReference();
+        }
+
+        virtual int call()
+        {
+            for (BroadcastSocketList::const_iterator itr = m_sockets.begin(); itr != m_sockets.end(); ++itr)
+                if ((*itr)->SendPacket(m_packet) == -1)
+                    (*itr)->CloseSocket();
+
+            return 0;
+        }
+
+    private:
+        WorldPacket m_packet;
+        BroadcastSocketList m_sockets;
+};
+
+void ChannelBroadcaster::Activate()
+{
+    if (!m_executor.activated())
+        m_executor.activate(1);
+}
+
+void ChannelBroadcaster::Deactivate()
+{
+    if (m_executor.activated())
+        m_executor.deactivate();
+}
+
+void ChannelBroadcaster::Broadcast(WorldPacket const& packet, BroadcastSocketList& sockets)
+{
+    if (sockets.empty())
+        return;
+
+    // on failure the executor deletes the request, which releases the sockets
+    m_executor.execute(new ChannelBroadcastRequest(packet, sockets));
+}
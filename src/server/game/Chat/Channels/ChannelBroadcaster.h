@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_CHANNELBROADCASTER_H
+#define TRINITY_CHANNELBROADCASTER_H
+
+#include "Define.h"
+#include "DelayExecutor.h"
+#include <ace/Singleton.h>
+#include <vector>
+
+class WorldPacket;
+class WorldSocket;
+
+typedef std::vector<WorldSocket*> BroadcastSocketList;
+
+/*
+ * Thread that writes messages of large chat channels to the client sockets.
+ *
+ * The channel picks the recipients on the world thread, where membership and
+ * ignore lists are consistent, and takes a reference on each recipient's
+ * socket. Copying the packet into every socket's output buffer is then done
+ * here. A socket that gets closed in the meantime simply refuses the packet,
+ * the reference keeps it alive until the broadcast is done.
+ */
+class ChannelBroadcaster
+{
+    friend class ACE_Singleton<ChannelBroadcaster, ACE_Null_Mutex>;
+    ChannelBroadcaster() {}
+
+    public:
+        void Activate();
+        void Deactivate();
+        bool IsActive() { return m_executor.activated(); }
+
+        // Sends a copy of the packet to all sockets and drops the references the caller took on them
+        void Broadcast(WorldPacket const& packet, BroadcastSocketList& sockets);
+
+    private:
+        DelayExecutor m_executor;
+};
+
+#define sChannelBroadcaster ACE_Singleton<ChannelBroadcaster, ACE_Null_Mutex>::instance()
+
+#endif
@@ -62,6 +62,7 @@
 #include "SmartAI.h"
 #include "Group.h"
 #include "ChannelMgr.h"
+#include "CharacterCache.h"
 
 bool ChatHandler::HandleAHBotOptionsCommand(const char *args)
 {
@@ -2697,6 +2698,7 @@ void ChatHandler::HandleCharacterLevel(Player* player, uint64 player_guid, uint3
     {
         // update level and XP at level, all other will be updated at loading
         CharacterDatabase.PExecute("UPDATE characters SET level = '%u', xp = 0 WHERE guid = '%u'", newlevel, GUID_LOPART(player_guid));
+        sCharacterCache->UpdateLevel(GUID_LOPART(player_guid), newlevel);
     }
 }
 
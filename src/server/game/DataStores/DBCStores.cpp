@@ -23,7 +23,11 @@
 #include "SpellMgr.h"
 
 #include "DBCfmt.h"
+#include "DelayExecutor.h"
 
+#include <ace/Condition_Thread_Mutex.h>
+#include <ace/Guard_T.h>
+#include <ace/Method_Request.h>
 #include <map>
 
 typedef std::map<uint16,uint32> AreaFlagByAreaID;
@@ -199,48 +203,172 @@ static bool LoadDBC_assert_print(uint32 fsize,uint32 rsize, const std::string& f
     return false;
 }
 
+class DBCThreadStartReq : public ACE_Method_Request
+{
+    public:
+        virtual int call()
+        {
+            MySQL::Thread_Init();
+            return 0;
+        }
+};
+
+class DBCThreadEndReq : public ACE_Method_Request
+{
+    public:
+        virtual int call()
+        {
+            MySQL::Thread_End();
+            return 0;
+        }
+};
+
 template<class T>
-inline void LoadDBC(uint32& availableDbcLocales, StoreProblemList& errlist, DBCStorage<T>& storage, const std::string& dbc_path, const std::string& filename, const std::string * custom_entries = NULL, const std::string * idname = NULL)
+class DBCLoadRequest;
+
+// Loads dbc stores, on a pool of threads if more than one is requested
+class DBCLoader
 {
-    // compatibility format and C++ structure sizes
-    ASSERT(DBCFileLoader::GetFormatRecordSize(storage.GetFormat()) == sizeof(T) || LoadDBC_assert_print(DBCFileLoader::GetFormatRecordSize(storage.GetFormat()),sizeof(T),filename));
+    public:
+        DBCLoader(std::string const& dbcPath, uint32 threads)
+            : m_dbcPath(dbcPath), m_availableDbcLocales(0xFFFFFFFF), m_condition(m_mutex), m_pending(0)
+        {
+            if (threads > 1)
+                m_executor.activate(int(threads), new DBCThreadStartReq, new DBCThreadEndReq);
+        }
 
-    std::string dbc_filename = dbc_path + filename;
-    SqlDbc * sql = NULL;
-    if (custom_entries)
-        sql = new SqlDbc(&filename,custom_entries, idname,storage.GetFormat());
+        ~DBCLoader()
+        {
+            Wait();
+            m_executor.deactivate();
+        }
 
-    if (storage.Load(dbc_filename.c_str(), sql))
-    {
-        for (uint8 i = 0; i < TOTAL_LOCALES; ++i)
+        template<class T>
+        void Load(DBCStorage<T>& storage, std::string const& filename, std::string const* custom_entries = NULL, std::string const* idname = NULL)
         {
-            if (!(availableDbcLocales & (1 << i)))
-                continue;
+            if (!m_executor.activated())
+            {
+                LoadStorage(storage, filename, custom_entries, idname);
+                return;
+            }
 
-            std::string dbc_filename_loc = dbc_path + localeNames[i] + "/" + filename;
-            if (!storage.LoadStringsFrom(dbc_filename_loc.c_str()))
-                availableDbcLocales &= ~(1<<i);             // mark as not available for speedup next checks
+            ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+            ++m_pending;
+            if (m_executor.execute(new DBCLoadRequest<T>(*this, storage, filename, custom_entries, idname)) == -1)
+            {
+                --m_pending;
+                guard.release();
+                LoadStorage(storage, filename, custom_entries, idname);
+            }
         }
-    }
-    else
-    {
-        // sort problematic dbc to (1) non compatible and (2) non-existed
-        FILE * f=fopen(dbc_filename.c_str(),"rb");
-        if (f)
+
+        // Blocks until every store handed to Load is loaded
+        void Wait()
         {
-            char buf[100];
-            snprintf(buf,100," (exist, but have %d fields instead " SIZEFMTD ") Wrong client version DBC file?",storage.GetFieldCount(),strlen(storage.GetFormat()));
-            errlist.push_back(dbc_filename + buf);
-            fclose(f);
+            ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+
+            while (m_pending > 0)
+                m_condition.wait();
         }
-        else
-            errlist.push_back(dbc_filename);
-    }
 
-    delete sql;
-}
+        StoreProblemList const& GetProblems() const { return m_problems; }
+
+        template<class T>
+        void LoadStorage(DBCStorage<T>& storage, std::string const& filename, std::string const* custom_entries, std::string const* idname)
+        {
+            // compatibility format and C++ structure sizes
+            ASSERT(DBCFileLoader::GetFormatRecordSize(storage.GetFormat()) == sizeof(T) || LoadDBC_assert_print(DBCFileLoader::GetFormatRecordSize(storage.GetFormat()),sizeof(T),filename));
+
+            std::string dbc_filename = m_dbcPath + filename;
+            SqlDbc * sql = NULL;
+            if (custom_entries)
+                sql = new SqlDbc(&filename,custom_entries, idname,storage.GetFormat());
+
+            if (storage.Load(dbc_filename.c_str(), sql))
+            {
+                for (uint8 i = 0; i < TOTAL_LOCALES; ++i)
+                {
+                    if (!(GetAvailableDbcLocales() & (1 << i)))
+                        continue;
+
+                    std::string dbc_filename_loc = m_dbcPath + localeNames[i] + "/" + filename;
+                    if (!storage.LoadStringsFrom(dbc_filename_loc.c_str()))
+                    {
+                        ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+                        m_availableDbcLocales &= ~(1<<i);           // mark as not available for speedup next checks
+                    }
+                }
+            }
+            else
+            {
+                // sort problematic dbc to (1) non compatible and (2) non-existed
+                std::string problem = dbc_filename;
+                FILE * f=fopen(dbc_filename.c_str(),"rb");
+                if (f)
+                {
+                    char buf[100];
+                    snprintf(buf,100," (exist, but have %d fields instead " SIZEFMTD ") Wrong client version DBC file?",storage.GetFieldCount(),strlen(storage.GetFormat()));
+                    problem += buf;
+                    fclose(f);
+                }
+
+                ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+                m_problems.push_back(problem);
+            }
+
+            delete sql;
+        }
+
+        void LoadFinished()
+        {
+            ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+
+            --m_pending;
+            m_condition.broadcast();
+        }
+
+    private:
+        uint32 GetAvailableDbcLocales()
+        {
+            ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, 0);
+            return m_availableDbcLocales;
+        }
+
+        std::string m_dbcPath;
+        uint32 m_availableDbcLocales;
+        StoreProblemList m_problems;
+
+        DelayExecutor m_executor;
+        ACE_Thread_Mutex m_mutex;
+        ACE_Condition_Thread_Mutex m_condition;
+        uint32 m_pending;
+};
+
+template<class T>
+class DBCLoadRequest : public ACE_Method_Request
+{
+    public:
+        DBCLoadRequest(DBCLoader& loader, DBCStorage<T>& storage, std::string const& filename, std::string const* custom_entries, std::string const* idname)
+            : m_loader(loader), m_storage(storage), m_filename(filename), m_customEntries(custom_entries), m_idName(idname)
+        {
+        }
 
-void LoadDBCStores(const std::string& dataPath)
+        virtual int call()
+        {
+            m_loader.LoadStorage(m_storage, m_filename, m_customEntries, m_idName);
+            m_loader.LoadFinished();
+            return 0;
+        }
+
+    private:
+        DBCLoader& m_loader;
+        DBCStorage<T>& m_storage;
+        std::string m_filename;
+        std::string const* m_customEntries;
+        std::string const* m_idName;
+};
+
+void LoadDBCStores(const std::string& dataPath, uint32 threads)
 {
     uint32 oldMSTime = getMSTime();
 
@@ -248,12 +376,105 @@ void LoadDBCStores(const std::string& dataPath)
 
     const uint32 DBCFilesCount = 90;
 
-    StoreProblemList bad_dbc_files;
-    uint32 availableDbcLocales = 0xFFFFFFFF;
+    DBCLoader loader(dbcPath, threads);
+
+    loader.Load(sAreaStore,                "AreaTable.dbc");
+    loader.Load(sAchievementStore,         "Achievement.dbc");
+    loader.Load(sAchievementCriteriaStore, "Achievement_Criteria.dbc");
+    loader.Load(sAreaTriggerStore,         "AreaTrigger.dbc");
+    loader.Load(sAreaGroupStore,           "AreaGroup.dbc");
+    loader.Load(sAreaPOIStore,             "AreaPOI.dbc");
+    loader.Load(sAuctionHouseStore,        "AuctionHouse.dbc");
+    loader.Load(sBankBagSlotPricesStore,   "BankBagSlotPrices.dbc");
+    loader.Load(sBattlemasterListStore,    "BattlemasterList.dbc");
+    loader.Load(sBarberShopStyleStore,     "BarberShopStyle.dbc");
+    loader.Load(sCharStartOutfitStore,     "CharStartOutfit.dbc");
+    loader.Load(sCharTitlesStore,          "CharTitles.dbc");
+    loader.Load(sChatChannelsStore,        "ChatChannels.dbc");
+    loader.Load(sChrClassesStore,          "ChrClasses.dbc");
+    loader.Load(sChrRacesStore,            "ChrRaces.dbc");
+    loader.Load(sCinematicSequencesStore,  "CinematicSequences.dbc");
+    loader.Load(sCreatureDisplayInfoStore, "CreatureDisplayInfo.dbc");
+    loader.Load(sCreatureFamilyStore,      "CreatureFamily.dbc");
+    loader.Load(sCreatureSpellDataStore,   "CreatureSpellData.dbc");
+    loader.Load(sCreatureTypeStore,        "CreatureType.dbc");
+    loader.Load(sCurrencyTypesStore,       "CurrencyTypes.dbc");
+    loader.Load(sDurabilityCostsStore,     "DurabilityCosts.dbc");
+    loader.Load(sDurabilityQualityStore,   "DurabilityQuality.dbc");
+    loader.Load(sEmotesStore,              "Emotes.dbc");
+    loader.Load(sEmotesTextStore,          "EmotesText.dbc");
+    loader.Load(sFactionStore,             "Faction.dbc");
+    loader.Load(sFactionTemplateStore,     "FactionTemplate.dbc");
+    loader.Load(sGameObjectDisplayInfoStore, "GameObjectDisplayInfo.dbc");
+    loader.Load(sGemPropertiesStore,       "GemProperties.dbc");
+    loader.Load(sGlyphPropertiesStore,     "GlyphProperties.dbc");
+    loader.Load(sGlyphSlotStore,           "GlyphSlot.dbc");
+    loader.Load(sGtBarberShopCostBaseStore,"gtBarberShopCostBase.dbc");
+    loader.Load(sGtCombatRatingsStore,     "gtCombatRatings.dbc");
+    loader.Load(sGtChanceToMeleeCritBaseStore, "gtChanceToMeleeCritBase.dbc");
+    loader.Load(sGtChanceToMeleeCritStore, "gtChanceToMeleeCrit.dbc");
+    loader.Load(sGtChanceToSpellCritBaseStore, "gtChanceToSpellCritBase.dbc");
+    loader.Load(sGtChanceToSpellCritStore, "gtChanceToSpellCrit.dbc");
+    loader.Load(sGtOCTRegenHPStore,        "gtOCTRegenHP.dbc");
+    //loader.Load(sGtOCTRegenMPStore,        "gtOCTRegenMP.dbc");       -- not used currently
+    loader.Load(sGtRegenHPPerSptStore,     "gtRegenHPPerSpt.dbc");
+    loader.Load(sGtRegenMPPerSptStore,     "gtRegenMPPerSpt.dbc");
+    loader.Load(sHolidaysStore,            "Holidays.dbc");
+    loader.Load(sItemStore,                "Item.dbc");
+    loader.Load(sItemBagFamilyStore,       "ItemBagFamily.dbc");
+    //loader.Load(sItemDisplayInfoStore,     "ItemDisplayInfo.dbc");     -- not used currently
+    //loader.Load(sItemCondExtCostsStore,    "ItemCondExtCosts.dbc");
+    loader.Load(sItemExtendedCostStore,    "ItemExtendedCost.dbc");
+    loader.Load(sItemLimitCategoryStore,   "ItemLimitCategory.dbc");
+    loader.Load(sItemRandomPropertiesStore,"ItemRandomProperties.dbc");
+    loader.Load(sItemRandomSuffixStore,    "ItemRandomSuffix.dbc");
+    loader.Load(sItemSetStore,             "ItemSet.dbc");
+    loader.Load(sLFGDungeonStore,          "LFGDungeons.dbc");
+    loader.Load(sLockStore,                "Lock.dbc");
+    loader.Load(sMailTemplateStore,        "MailTemplate.dbc");
+    loader.Load(sMapStore,                 "Map.dbc");
+    loader.Load(sMapDifficultyStore,       "MapDifficulty.dbc");
+    loader.Load(sMovieStore,               "Movie.dbc");
+    loader.Load(sOverrideSpellDataStore,   "OverrideSpellData.dbc");
+    loader.Load(sQuestSortStore,           "QuestSort.dbc");
+    loader.Load(sPvPDifficultyStore,       "PvpDifficulty.dbc");
+    loader.Load(sQuestXPStore,             "QuestXP.dbc");
+    loader.Load(sQuestFactionRewardStore,  "QuestFactionReward.dbc");
+    loader.Load(sRandomPropertiesPointsStore, "RandPropPoints.dbc");
+    loader.Load(sScalingStatDistributionStore, "ScalingStatDistribution.dbc");
+    loader.Load(sScalingStatValuesStore,   "ScalingStatValues.dbc");
+    loader.Load(sSkillLineStore,           "SkillLine.dbc");
+    loader.Load(sSkillLineAbilityStore,    "SkillLineAbility.dbc");
+    loader.Load(sSoundEntriesStore,        "SoundEntries.dbc");
+    loader.Load(sSpellStore,               "Spell.dbc", &CustomSpellEntryfmt, &CustomSpellEntryIndex);
+    loader.Load(sSpellCastTimesStore,      "SpellCastTimes.dbc");
+    loader.Load(sSpellDifficultyStore,     "SpellDifficulty.dbc", &CustomSpellDifficultyfmt, &CustomSpellDifficultyIndex);
+    loader.Load(sSpellDurationStore,       "SpellDuration.dbc");
+    loader.Load(sSpellFocusObjectStore,    "SpellFocusObject.dbc");
+    loader.Load(sSpellItemEnchantmentStore,"SpellItemEnchantment.dbc");
+    loader.Load(sSpellItemEnchantmentConditionStore,"SpellItemEnchantmentCondition.dbc");
+    loader.Load(sSpellRadiusStore,         "SpellRadius.dbc");
+    loader.Load(sSpellRangeStore,          "SpellRange.dbc");
+    loader.Load(sSpellRuneCostStore,       "SpellRuneCost.dbc");
+    loader.Load(sSpellShapeshiftStore,     "SpellShapeshiftForm.dbc");
+    loader.Load(sStableSlotPricesStore,    "StableSlotPrices.dbc");
+    loader.Load(sSummonPropertiesStore,    "SummonProperties.dbc");
+    loader.Load(sTalentStore,              "Talent.dbc");
+    loader.Load(sTalentTabStore,           "TalentTab.dbc");
+    loader.Load(sTaxiNodesStore,           "TaxiNodes.dbc");
+    loader.Load(sTaxiPathStore,            "TaxiPath.dbc");
+    loader.Load(sTaxiPathNodeStore,        "TaxiPathNode.dbc");
+    loader.Load(sTotemCategoryStore,       "TotemCategory.dbc");
+    loader.Load(sVehicleStore,             "Vehicle.dbc");
+    loader.Load(sVehicleSeatStore,         "VehicleSeat.dbc");
+    loader.Load(sWMOAreaTableStore,        "WMOAreaTable.dbc");
+    loader.Load(sWorldMapAreaStore,        "WorldMapArea.dbc");
+    loader.Load(sWorldMapOverlayStore,     "WorldMapOverlay.dbc");
+    loader.Load(sWorldSafeLocsStore,       "WorldSafeLocs.dbc");
+
+    // all stores are loaded from here on, build the derived tables
+    loader.Wait();
 
-    LoadDBC(availableDbcLocales, bad_dbc_files, sAreaStore, dbcPath, "AreaTable.dbc");
-
-    // must be after sAreaStore loading
     for (uint32 i = 0; i < sAreaStore.GetNumRows(); ++i)           // areaflag numbered from 0
     {
         if (AreaTableEntry const* area = sAreaStore.LookupEntry(i))
@@ -267,31 +488,6 @@ void LoadDBCStores(const std::string& dataPath)
         }
     }
 
-    LoadDBC(availableDbcLocales,bad_dbc_files,sAchievementStore,         dbcPath,"Achievement.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sAchievementCriteriaStore, dbcPath,"Achievement_Criteria.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sAreaTriggerStore,         dbcPath,"AreaTrigger.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sAreaGroupStore,           dbcPath,"AreaGroup.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sAreaPOIStore,             dbcPath,"AreaPOI.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sAuctionHouseStore,        dbcPath,"AuctionHouse.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sBankBagSlotPricesStore,   dbcPath,"BankBagSlotPrices.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sBattlemasterListStore,    dbcPath,"BattlemasterList.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sBarberShopStyleStore,     dbcPath,"BarberShopStyle.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sCharStartOutfitStore,     dbcPath,"CharStartOutfit.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sCharTitlesStore,          dbcPath,"CharTitles.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sChatChannelsStore,        dbcPath,"ChatChannels.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sChrClassesStore,          dbcPath,"ChrClasses.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sChrRacesStore,            dbcPath,"ChrRaces.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sCinematicSequencesStore,  dbcPath,"CinematicSequences.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sCreatureDisplayInfoStore, dbcPath,"CreatureDisplayInfo.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sCreatureFamilyStore,      dbcPath,"CreatureFamily.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sCreatureSpellDataStore,   dbcPath,"CreatureSpellData.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sCreatureTypeStore,        dbcPath,"CreatureType.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sCurrencyTypesStore,       dbcPath,"CurrencyTypes.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sDurabilityCostsStore,     dbcPath,"DurabilityCosts.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sDurabilityQualityStore,   dbcPath,"DurabilityQuality.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sEmotesStore,              dbcPath,"Emotes.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sEmotesTextStore,          dbcPath,"EmotesText.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sFactionStore,             dbcPath,"Faction.dbc");
     for (uint32 i=0; i<sFactionStore.GetNumRows(); ++i)
     {
         FactionEntry const * faction = sFactionStore.LookupEntry(i);
@@ -302,8 +498,6 @@ void LoadDBCStores(const std::string& dataPath)
         }
     }
 
-    LoadDBC(availableDbcLocales,bad_dbc_files,sFactionTemplateStore,     dbcPath,"FactionTemplate.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sGameObjectDisplayInfoStore, dbcPath,"GameObjectDisplayInfo.dbc");
     for (uint32 i = 0; i < sGameObjectDisplayInfoStore.GetNumRows(); ++i)
     {
         if (GameObjectDisplayInfoEntry const * info = sGameObjectDisplayInfoStore.LookupEntry(i))
@@ -317,63 +511,17 @@ void LoadDBCStores(const std::string& dataPath)
         }
     }
 
-    LoadDBC(availableDbcLocales,bad_dbc_files,sGemPropertiesStore,       dbcPath,"GemProperties.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sGlyphPropertiesStore,     dbcPath,"GlyphProperties.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sGlyphSlotStore,           dbcPath,"GlyphSlot.dbc");
-
-    LoadDBC(availableDbcLocales,bad_dbc_files,sGtBarberShopCostBaseStore,dbcPath,"gtBarberShopCostBase.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sGtCombatRatingsStore,     dbcPath,"gtCombatRatings.dbc");
-
-    LoadDBC(availableDbcLocales,bad_dbc_files,sGtChanceToMeleeCritBaseStore, dbcPath,"gtChanceToMeleeCritBase.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sGtChanceToMeleeCritStore, dbcPath,"gtChanceToMeleeCrit.dbc");
-
-    LoadDBC(availableDbcLocales,bad_dbc_files,sGtChanceToSpellCritBaseStore, dbcPath,"gtChanceToSpellCritBase.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sGtChanceToSpellCritStore, dbcPath,"gtChanceToSpellCrit.dbc");
-
-    LoadDBC(availableDbcLocales,bad_dbc_files,sGtOCTRegenHPStore,        dbcPath,"gtOCTRegenHP.dbc");
-    //LoadDBC(availableDbcLocales,bad_dbc_files,sGtOCTRegenMPStore,        dbcPath,"gtOCTRegenMP.dbc");       -- not used currently
-    LoadDBC(availableDbcLocales,bad_dbc_files,sGtRegenHPPerSptStore,     dbcPath,"gtRegenHPPerSpt.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sGtRegenMPPerSptStore,     dbcPath,"gtRegenMPPerSpt.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sHolidaysStore,            dbcPath,"Holidays.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sItemStore,                dbcPath,"Item.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sItemBagFamilyStore,       dbcPath,"ItemBagFamily.dbc");
-    //LoadDBC(availableDbcLocales,bad_dbc_files,sItemDisplayInfoStore,     dbcPath,"ItemDisplayInfo.dbc");     -- not used currently
-    //LoadDBC(availableDbcLocales,bad_dbc_files,sItemCondExtCostsStore,    dbcPath,"ItemCondExtCosts.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sItemExtendedCostStore,    dbcPath,"ItemExtendedCost.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sItemLimitCategoryStore,   dbcPath,"ItemLimitCategory.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sItemRandomPropertiesStore,dbcPath,"ItemRandomProperties.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sItemRandomSuffixStore,    dbcPath,"ItemRandomSuffix.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sItemSetStore,             dbcPath,"ItemSet.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sLFGDungeonStore,          dbcPath,"LFGDungeons.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sLockStore,                dbcPath,"Lock.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sMailTemplateStore,        dbcPath,"MailTemplate.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sMapStore,                 dbcPath,"Map.dbc");
-
-    LoadDBC(availableDbcLocales,bad_dbc_files,sMapDifficultyStore,       dbcPath,"MapDifficulty.dbc");
     // fill data
     for (uint32 i = 1; i < sMapDifficultyStore.GetNumRows(); ++i)
         if (MapDifficultyEntry const* entry = sMapDifficultyStore.LookupEntry(i))
             sMapDifficultyMap[MAKE_PAIR32(entry->MapId,entry->Difficulty)] = MapDifficulty(entry->resetTime,entry->maxPlayers,strlen(entry->areaTriggerText)>0);
     sMapDifficultyStore.Clear();
 
-    LoadDBC(availableDbcLocales,bad_dbc_files,sMovieStore,               dbcPath,"Movie.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sOverrideSpellDataStore,   dbcPath,"OverrideSpellData.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sQuestSortStore,           dbcPath,"QuestSort.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sPvPDifficultyStore,       dbcPath,"PvpDifficulty.dbc");
     for (uint32 i = 0; i < sPvPDifficultyStore.GetNumRows(); ++i)
         if (PvPDifficultyEntry const* entry = sPvPDifficultyStore.LookupEntry(i))
             if (entry->bracketId > MAX_BATTLEGROUND_BRACKETS)
                 ASSERT(false && "Need update MAX_BATTLEGROUND_BRACKETS by DBC data");
 
-    LoadDBC(availableDbcLocales,bad_dbc_files,sQuestXPStore,             dbcPath,"QuestXP.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sQuestFactionRewardStore,  dbcPath,"QuestFactionReward.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sRandomPropertiesPointsStore, dbcPath,"RandPropPoints.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sScalingStatDistributionStore, dbcPath,"ScalingStatDistribution.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sScalingStatValuesStore,   dbcPath,"ScalingStatValues.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sSkillLineStore,           dbcPath,"SkillLine.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sSkillLineAbilityStore,    dbcPath,"SkillLineAbility.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sSoundEntriesStore,        dbcPath,"SoundEntries.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sSpellStore,               dbcPath,"Spell.dbc", &CustomSpellEntryfmt, &CustomSpellEntryIndex);
     for (uint32 i = 1; i < sSpellStore.GetNumRows(); ++i)
     {
         SpellEntry const * spell = sSpellStore.LookupEntry(i);
@@ -411,20 +559,6 @@ void LoadDBCStores(const std::string& dataPath)
         }
     }
 
-    LoadDBC(availableDbcLocales,bad_dbc_files,sSpellCastTimesStore,      dbcPath,"SpellCastTimes.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sSpellDifficultyStore,     dbcPath,"SpellDifficulty.dbc", &CustomSpellDifficultyfmt, &CustomSpellDifficultyIndex);
-    LoadDBC(availableDbcLocales,bad_dbc_files,sSpellDurationStore,       dbcPath,"SpellDuration.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sSpellFocusObjectStore,    dbcPath,"SpellFocusObject.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sSpellItemEnchantmentStore,dbcPath,"SpellItemEnchantment.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sSpellItemEnchantmentConditionStore,dbcPath,"SpellItemEnchantmentCondition.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sSpellRadiusStore,         dbcPath,"SpellRadius.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sSpellRangeStore,          dbcPath,"SpellRange.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sSpellRuneCostStore,       dbcPath,"SpellRuneCost.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sSpellShapeshiftStore,     dbcPath,"SpellShapeshiftForm.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sStableSlotPricesStore,    dbcPath,"StableSlotPrices.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sSummonPropertiesStore,    dbcPath,"SummonProperties.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sTalentStore,              dbcPath,"Talent.dbc");
-
     // Create Spelldifficulty searcher
     for (uint32 i = 0; i < sSpellDifficultyStore.GetNumRows(); ++i)
     {
@@ -462,8 +596,6 @@ void LoadDBCStores(const std::string& dataPath)
                 sTalentSpellPosMap[talentInfo->RankID[j]] = TalentSpellPos(i,j);
     }
 
-    LoadDBC(availableDbcLocales,bad_dbc_files,sTalentTabStore,           dbcPath,"TalentTab.dbc");
-
     // prepare fast data access to bit pos of talent ranks for use at inspecting
     {
         // now have all max ranks (and then bit amount used for store talent ranks in inspect)
@@ -485,16 +617,12 @@ void LoadDBCStores(const std::string& dataPath)
         }
     }
 
-    LoadDBC(availableDbcLocales,bad_dbc_files,sTaxiNodesStore,           dbcPath,"TaxiNodes.dbc");
-
-    LoadDBC(availableDbcLocales,bad_dbc_files,sTaxiPathStore,            dbcPath,"TaxiPath.dbc");
     for (uint32 i = 1; i < sTaxiPathStore.GetNumRows(); ++i)
         if (TaxiPathEntry const* entry = sTaxiPathStore.LookupEntry(i))
             sTaxiPathSetBySource[entry->from][entry->to] = TaxiPathBySourceAndDestination(entry->ID,entry->price);
     uint32 pathCount = sTaxiPathStore.GetNumRows();
 
     //## TaxiPathNode.dbc ## Loaded only for initialization different structures
-    LoadDBC(availableDbcLocales,bad_dbc_files,sTaxiPathNodeStore,        dbcPath,"TaxiPathNode.dbc");
     // Calculate path nodes count
     std::vector<uint32> pathLength;
     pathLength.resize(pathCount);                           // 0 and some other indexes not used
@@ -575,10 +703,6 @@ void LoadDBCStores(const std::string& dataPath)
         }
     }
 
-    LoadDBC(availableDbcLocales,bad_dbc_files,sTotemCategoryStore,       dbcPath,"TotemCategory.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sVehicleStore,             dbcPath,"Vehicle.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sVehicleSeatStore,         dbcPath,"VehicleSeat.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sWMOAreaTableStore,        dbcPath,"WMOAreaTable.dbc");
     for(uint32 i = 0; i < sWMOAreaTableStore.GetNumRows(); ++i)
     {
         if(WMOAreaTableEntry const* entry = sWMOAreaTableStore.LookupEntry(i))
@@ -586,11 +710,9 @@ void LoadDBCStores(const std::string& dataPath)
             sWMOAreaInfoByTripple.insert(WMOAreaInfoByTripple::value_type(WMOAreaTableTripple(entry->rootId, entry->adtId, entry->groupId), entry));
         }
     }
-    LoadDBC(availableDbcLocales,bad_dbc_files,sWorldMapAreaStore,        dbcPath,"WorldMapArea.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sWorldMapOverlayStore,     dbcPath,"WorldMapOverlay.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sWorldSafeLocsStore,       dbcPath,"WorldSafeLocs.dbc");
 
     // error checks
+    StoreProblemList const& bad_dbc_files = loader.GetProblems();
     if (bad_dbc_files.size() >= DBCFilesCount)
     {
         sLog->outError("\nIncorrect DataDir value in worldserver.conf or ALL required *.dbc files (%d) not found by path: %sdbc",DBCFilesCount,dataPath.c_str());
@@ -599,7 +721,7 @@ void LoadDBCStores(const std::string& dataPath)
     else if (!bad_dbc_files.empty())
     {
         std::string str;
-        for (std::list<std::string>::iterator i = bad_dbc_files.begin(); i != bad_dbc_files.end(); ++i)
+        for (StoreProblemList::const_iterator i = bad_dbc_files.begin(); i != bad_dbc_files.end(); ++i)
             str += *i + "\n";
 
         sLog->outError("\nSome required *.dbc files (%u from %d) not found or not compatible:\n%s",(uint32)bad_dbc_files.size(),DBCFilesCount,str.c_str());
@@ -32,7 +32,7 @@
 
 LFGMgr::LFGMgr(): m_update(true), m_QueueTimer(0), m_lfgProposalId(1),
 m_WaitTimeAvg(-1), m_WaitTimeTank(-1), m_WaitTimeHealer(-1), m_WaitTimeDps(-1),
-m_NumWaitTimeAvg(0), m_NumWaitTimeTank(0), m_NumWaitTimeHealer(0), m_NumWaitTimeDps(0)
+m_NumWaitTimeAvg(0), m_NumWaitTimeTank(0), m_NumWaitTimeHealer(0), m_NumWaitTimeDps(0), m_NextQueueSlot(1)
 {
     m_update = sWorld->getBoolConfig(CONFIG_DUNGEON_FINDER_ENABLE);
     if (m_update)
@@ -264,8 +264,8 @@ void LFGMgr::Update(uint32 diff)
             firstNew.push_back(frontguid);
             newToQueue.pop_front();
 
-            LfgGuidList temporalList = currentQueue;
-            if (LfgProposal* pProposal = FindNewGroups(firstNew, temporalList)) // Group found!
+            LfgGuidList::const_iterator itAll = currentQueue.begin();
+            if (LfgProposal* pProposal = FindNewGroups(firstNew, itAll, currentQueue.end())) // Group found!
             {
                 // Remove groups in the proposal from new and current queues (not from queue map)
                 for (LfgGuidList::const_iterator itQueue = pProposal->queues.begin(); itQueue != pProposal->queues.end(); ++itQueue)
@@ -367,6 +367,8 @@ void LFGMgr::AddToQueue(const uint64& guid, uint8 queueId)
     if (sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_GROUP))
         queueId = 0;
 
+    AssignQueueSlot(guid);
+
     LfgGuidList& list = m_newToQueue[queueId];
     if (std::find(list.begin(), list.end(), guid) != list.end())
         sLog->outDebug("LFGMgr::AddToQueue: [" UI64FMTD "] already in new queue. ignoring", guid);
@@ -781,23 +783,25 @@ void LFGMgr::OfferContinue(Group* grp)
    Checks que main queue to try to form a Lfg group. Returns first match found (if any)
 
    @param[in]     check List of guids trying to match with other groups
-   @param[in]     all List of all other guids in main queue to match against
+   @param[in,out] itAll Next guid in main queue to match against, shared by all recursion levels
+   @param[in]     itEnd End of the main queue
    @return Pointer to proposal, if match is found
 */
-LfgProposal* LFGMgr::FindNewGroups(LfgGuidList& check, LfgGuidList& all)
+LfgProposal* LFGMgr::FindNewGroups(LfgGuidList& check, LfgGuidList::const_iterator& itAll, LfgGuidList::const_iterator const& itEnd)
 {
-    sLog->outDebug("LFGMgr::FindNewGroup: (%s) - all(%s)", ConcatenateGuids(check).c_str(), ConcatenateGuids(all).c_str());
+    if (sLog->IsOutDebug())
+        sLog->outDebug("LFGMgr::FindNewGroup: (%s) - remaining(%u)", ConcatenateGuids(check).c_str(), uint32(std::distance(itAll, itEnd)));
 
     LfgProposal* pProposal = NULL;
     if (!check.size() || check.size() > MAXGROUPSIZE || !CheckCompatibility(check, pProposal))
         return NULL;
 
-    // Try to match with queued groups
-    while (!pProposal && all.size() > 0)
+    // Try to match with queued groups, every queued guid is tried once
+    while (!pProposal && itAll != itEnd)
     {
-        check.push_back(all.front());
-        all.pop_front();
-        pProposal = FindNewGroups(check, all);
+        check.push_back(*itAll);
+        ++itAll;
+        pProposal = FindNewGroups(check, itAll, itEnd);
         check.pop_back();
     }
     return pProposal;
@@ -815,7 +819,8 @@ bool LFGMgr::CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal)
     if (pProposal)                                         // Do not check anything if we already have a proposal
         return false;
 
-    std::string strGuids = ConcatenateGuids(check);
+    // only needed for debug output
+    std::string strGuids = sLog->IsOutDebug() ? ConcatenateGuids(check) : "";
 
     if (check.size() > MAXGROUPSIZE || !check.size())
     {
@@ -827,7 +832,8 @@ bool LFGMgr::CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal)
         return true;
 
     // Previously cached?
-    LfgAnswer answer = GetCompatibles(strGuids);
+    uint64 key = GetCompatibleKey(check);
+    LfgAnswer answer = GetCompatibles(key);
     if (answer != LFG_ANSWER_PENDING)
     {
         sLog->outDebug("LFGMgr::CheckCompatibility: (%s) compatibles (cached): %d", strGuids.c_str(), answer);
@@ -844,7 +850,7 @@ bool LFGMgr::CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal)
         if (!CheckCompatibility(check, pProposal))          // Group not compatible
         {
             sLog->outDebug("LFGMgr::CheckCompatibility: (%s) not compatibles (%s not compatibles)", strGuids.c_str(), ConcatenateGuids(check).c_str());
-            SetCompatibles(strGuids, false);
+            SetCompatibles(key, false);
             return false;
         }
         check.push_front(frontGuid);
@@ -887,7 +893,7 @@ bool LFGMgr::CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal)
     // Do not match - groups already in a lfgDungeon or too much players
     if (numLfgGroups > 1 || numPlayers > MAXGROUPSIZE)
     {
-        SetCompatibles(strGuids, false);
+        SetCompatibles(key, false);
         if (numLfgGroups > 1)
             sLog->outDebug("LFGMgr::CheckCompatibility: (%s) More than one Lfggroup (%u)", strGuids.c_str(), numLfgGroups);
         else
@@ -941,7 +947,7 @@ bool LFGMgr::CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal)
     {
         if (players.size() == numPlayers)
             sLog->outDebug("LFGMgr::CheckCompatibility: (%s) Roles not compatible", strGuids.c_str());
-        SetCompatibles(strGuids, false);
+        SetCompatibles(key, false);
         return false;
     }
 
@@ -965,10 +971,10 @@ bool LFGMgr::CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal)
 
     if (compatibleDungeons.empty())
     {
-        SetCompatibles(strGuids, false);
+        SetCompatibles(key, false);
         return false;
     }
-    SetCompatibles(strGuids, true);
+    SetCompatibles(key, true);
 
     // ----- Group is compatible, if we have MAXGROUPSIZE members then match is found
     if (numPlayers != MAXGROUPSIZE)
@@ -1147,44 +1153,130 @@ void LFGMgr::UpdateRoleCheck(uint64& gguid, uint64 guid /* = 0 */, uint8 roles /
 
 /**
    Remove from cached compatible dungeons any entry that contains the given guid
+   and release its queue slot
 
    @param[in]     guid Guid to remove from compatible cache
 */
 void LFGMgr::RemoveFromCompatibles(uint64 guid)
 {
-    std::stringstream out;
-    out << guid;
-    std::string strGuid = out.str();
+    UNORDERED_MAP<uint64, uint16>::iterator itSlot = m_QueueSlots.find(guid);
+    if (itSlot == m_QueueSlots.end())
+        return;
+
+    uint16 slot = itSlot->second;
+    m_QueueSlots.erase(itSlot);
+
+    sLog->outDebug("LFGMgr::RemoveFromCompatibles: Removing [" UI64FMTD "] (slot %u)", guid, slot);
+    if (slot < m_CompatibleKeysBySlot.size())
+    {
+        // keys of other slots may still be listed here, erasing them again is harmless
+        std::vector<uint64>& keys = m_CompatibleKeysBySlot[slot];
+        for (std::vector<uint64>::const_iterator it = keys.begin(); it != keys.end(); ++it)
+            m_CompatibleMap.erase(*it);
+        std::vector<uint64>().swap(keys);
+    }
+
+    m_FreeQueueSlots.push_back(slot);
+}
+
+/**
+   Gives a queued guid a compact id used to build compatible keys. Guids keep
+   their slot until they leave the queue, proposals that fail reuse it.
+
+   @param[in]     guid Player or group guid
+   @return Slot of the guid, 0 if all slots are in use
+*/
+uint16 LFGMgr::AssignQueueSlot(uint64 guid)
+{
+    UNORDERED_MAP<uint64, uint16>::const_iterator itSlot = m_QueueSlots.find(guid);
+    if (itSlot != m_QueueSlots.end())
+        return itSlot->second;
+
+    uint16 slot = 0;
+    if (!m_FreeQueueSlots.empty())
+    {
+        slot = m_FreeQueueSlots.back();
+        m_FreeQueueSlots.pop_back();
+    }
+    else if (m_NextQueueSlot <= LFG_MAX_QUEUE_SLOT)
+        slot = m_NextQueueSlot++;
+    else
+    {
+        sLog->outDebug("LFGMgr::AssignQueueSlot: [" UI64FMTD "] no free queue slot, compatibilities will not be cached", guid);
+        return 0;
+    }
+
+    m_QueueSlots[guid] = slot;
+    return slot;
+}
+
+/**
+   Builds the compatible key of a list of guids: their queue slots sorted and
+   packed, so the same guids give the same key in any order
 
-    sLog->outDebug("LFGMgr::RemoveFromCompatibles: Removing [" UI64FMTD "]", guid);
-    for (LfgCompatibleMap::iterator itNext = m_CompatibleMap.begin(); itNext != m_CompatibleMap.end();)
+   @param[in]     check List of guids
+   @return Compatible key, 0 if any guid has no queue slot
+*/
+uint64 LFGMgr::GetCompatibleKey(const LfgGuidList& check)
+{
+    uint16 slots[MAXGROUPSIZE];
+    uint8 count = 0;
+    for (LfgGuidList::const_iterator it = check.begin(); it != check.end() && count < MAXGROUPSIZE; ++it)
     {
-        LfgCompatibleMap::iterator it = itNext++;
-        if (it->first.find(strGuid) != std::string::npos)  // Found, remove it
-            m_CompatibleMap.erase(it);
+        UNORDERED_MAP<uint64, uint16>::const_iterator itSlot = m_QueueSlots.find(*it);
+        if (itSlot == m_QueueSlots.end())
+            return 0;
+        slots[count++] = itSlot->second;
     }
+
+    std::sort(slots, slots + count);
+
+    uint64 key = 0;
+    for (uint8 i = 0; i < count; ++i)
+        key = (key << LFG_QUEUE_SLOT_BITS) | slots[i];
+    return key;
 }
 
 /**
    Stores the compatibility of a list of guids
 
-   @param[in]     key String concatenation of guids (| used as separator)
+   @param[in]     key Compatible key of the guids (see GetCompatibleKey)
    @param[in]     compatibles Compatibles or not
 */
-void LFGMgr::SetCompatibles(std::string key, bool compatibles)
+void LFGMgr::SetCompatibles(uint64 key, bool compatibles)
 {
-    m_CompatibleMap[key] = LfgAnswer(compatibles);
+    if (!key)
+        return;
+
+    std::pair<LfgCompatibleMap::iterator, bool> result = m_CompatibleMap.insert(LfgCompatibleMap::value_type(key, LfgAnswer(compatibles)));
+    if (!result.second)
+    {
+        result.first->second = LfgAnswer(compatibles);
+        return;
+    }
+
+    // remember the key in every slot it contains so that it can be dropped when one of them leaves
+    for (uint64 rest = key; rest; rest >>= LFG_QUEUE_SLOT_BITS)
+    {
+        uint16 slot = uint16(rest & LFG_MAX_QUEUE_SLOT);
+        if (slot >= m_CompatibleKeysBySlot.size())
+            m_CompatibleKeysBySlot.resize(slot + 1);
+        m_CompatibleKeysBySlot[slot].push_back(key);
+    }
 }
 
 /**
    Get the compatibility of a group of guids
 
-   @param[in]     key String concatenation of guids (| used as separator)
+   @param[in]     key Compatible key of the guids (see GetCompatibleKey)
    @return 1 (Compatibles), 0 (Not compatibles), -1 (Not set)
 */
-LfgAnswer LFGMgr::GetCompatibles(std::string key)
+LfgAnswer LFGMgr::GetCompatibles(uint64 key)
 {
     LfgAnswer answer = LFG_ANSWER_PENDING;
+    if (!key)
+        return answer;
+
     LfgCompatibleMap::iterator it = m_CompatibleMap.find(key);
     if (it != m_CompatibleMap.end())
         answer = it->second;
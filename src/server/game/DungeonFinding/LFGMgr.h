@@ -116,6 +116,10 @@ enum LfgAnswer
 };
 
 
+/// Queue slots are packed 12 bits each into a 64 bit compatible key (up to MAXGROUPSIZE of them)
+#define LFG_QUEUE_SLOT_BITS  12
+#define LFG_MAX_QUEUE_SLOT   ((1 << LFG_QUEUE_SLOT_BITS) - 1)
+
 // Forward declaration (just to have all typedef together)
 struct LfgReward;
 struct LfgLockStatus;
@@ -132,7 +136,7 @@ typedef std::set<Player*> PlayerSet;
 typedef std::list<Player*> LfgPlayerList;
 typedef std::multimap<uint32, LfgReward const*> LfgRewardMap;
 typedef std::pair<LfgRewardMap::const_iterator, LfgRewardMap::const_iterator> LfgRewardMapBounds;
-typedef std::map<std::string, LfgAnswer> LfgCompatibleMap;
+typedef UNORDERED_MAP<uint64, LfgAnswer> LfgCompatibleMap;
 typedef std::map<uint64, LfgDungeonSet> LfgDungeonMap;
 typedef std::map<uint64, uint8> LfgRolesMap;
 typedef std::map<uint64, LfgAnswer> LfgAnswerMap;
@@ -320,13 +324,15 @@ class LFGMgr
         void RemoveProposal(LfgProposalMap::iterator itProposal, LfgUpdateType type);
 
         // Group Matching
-        LfgProposal* FindNewGroups(LfgGuidList& check, LfgGuidList& all);
+        LfgProposal* FindNewGroups(LfgGuidList& check, LfgGuidList::const_iterator& itAll, LfgGuidList::const_iterator const& itEnd);
         bool CheckGroupRoles(LfgRolesMap &groles, bool removeLeaderFlag = true);
         bool CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal);
         void GetCompatibleDungeons(LfgDungeonSet& dungeons, const PlayerSet& players, LfgLockPartyMap& lockMap);
-        void SetCompatibles(std::string concatenatedGuids, bool compatibles);
-        LfgAnswer GetCompatibles(std::string concatenatedGuids);
+        void SetCompatibles(uint64 key, bool compatibles);
+        LfgAnswer GetCompatibles(uint64 key);
         void RemoveFromCompatibles(uint64 guid);
+        uint16 AssignQueueSlot(uint64 guid);
+        uint64 GetCompatibleKey(const LfgGuidList& check);
 
         // Generic
         const LfgDungeonSet& GetDungeonsByRandom(uint32 randomdungeon);
@@ -353,7 +359,11 @@ class LFGMgr
         LfgQueueInfoMap m_QueueInfoMap;                    ///< Queued groups
         LfgGuidListMap m_currentQueue;                     ///< Ordered list. Used to find groups
         LfgGuidListMap m_newToQueue;                       ///< New groups to add to queue
-        LfgCompatibleMap m_CompatibleMap;                  ///< Compatible dungeons
+        LfgCompatibleMap m_CompatibleMap;                  ///< Compatible dungeons, keyed by the sorted queue slots of the checked guids
+        UNORDERED_MAP<uint64, uint16> m_QueueSlots;        ///< Compact id (1..LFG_MAX_QUEUE_SLOT) of every queued guid, used to build compatible keys
+        std::vector<uint16> m_FreeQueueSlots;              ///< Released queue slots, reused before new ones are handed out
+        uint16 m_NextQueueSlot;                            ///< Next never used queue slot
+        std::vector<std::vector<uint64> > m_CompatibleKeysBySlot; ///< Compatible keys each queue slot takes part in
         // Rolecheck - Proposal - Vote Kicks
         LfgRoleCheckMap m_RoleChecks;                      ///< Current Role checks
         LfgProposalMap m_Proposals;                        ///< Current Proposals
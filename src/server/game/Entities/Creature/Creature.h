@@ -407,6 +407,10 @@ class Creature : public Unit, public GridObject<Creature>
         explicit Creature();
         virtual ~Creature();
 
+        // served from the creature ObjectPool, derived classes bigger than Creature declare their own
+        static void* operator new(size_t size);
+        static void operator delete(void* ptr, size_t size);
+
         void AddToWorld();
         void RemoveFromWorld();
 
@@ -666,6 +670,8 @@ class Creature : public Unit, public GridObject<Creature>
         static float _GetDamageMod(int32 Rank);
 
         float m_SightDistance, m_CombatDistance;
+        // changes m_SightDistance and the map area that triggers MoveInLineOfSight
+        void SetSightDistance(float dist);
 
         void SetGUIDTransport(uint32 guid) { guid_transport=guid; }
         uint32 GetGUIDTransport() { return guid_transport; }
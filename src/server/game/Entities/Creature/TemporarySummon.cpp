@@ -21,6 +21,30 @@
 #include "CreatureAI.h"
 #include "ObjectMgr.h"
 #include "TemporarySummon.h"
+#include "Totem.h"
+#include "ObjectPool.h"
+
+static size_t GetLargestSummonSize()
+{
+    size_t size = sizeof(TempSummon);
+    size = std::max(size, sizeof(Minion));
+    size = std::max(size, sizeof(Guardian));
+    size = std::max(size, sizeof(Puppet));
+    size = std::max(size, sizeof(Totem));
+    return size;
+}
+
+static ObjectPool* const sSummonPool = new ObjectPool("TempSummon", GetLargestSummonSize(), 64);
+
+void* TempSummon::operator new(size_t size)
+{
+    return sSummonPool->Allocate(size);
+}
+
+void TempSummon::operator delete(void* ptr, size_t size)
+{
+    sSummonPool->Deallocate(ptr, size);
+}
 
 TempSummon::TempSummon(SummonPropertiesEntry const *properties, Unit *owner) :
 Creature(), m_Properties(properties), m_type(TEMPSUMMON_MANUAL_DESPAWN),
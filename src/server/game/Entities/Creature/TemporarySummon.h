@@ -26,6 +26,10 @@ class TempSummon : public Creature
     public:
         explicit TempSummon(SummonPropertiesEntry const *properties, Unit *owner);
         virtual ~TempSummon() {}
+
+        // shared by all summon types, pets are bigger and fall back to the global allocator
+        static void* operator new(size_t size);
+        static void operator delete(void* ptr, size_t size);
         void Update(uint32 time);
         virtual void InitStats(uint32 lifetime);
         virtual void InitSummon();
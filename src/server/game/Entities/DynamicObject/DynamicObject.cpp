@@ -26,6 +26,19 @@
 #include "CellImpl.h"
 #include "GridNotifiersImpl.h"
 #include "ScriptMgr.h"
+#include "ObjectPool.h"
+
+static ObjectPool* const sDynamicObjectPool = new ObjectPool("DynamicObject", sizeof(DynamicObject), 64);
+
+void* DynamicObject::operator new(size_t size)
+{
+    return sDynamicObjectPool->Allocate(size);
+}
+
+void DynamicObject::operator delete(void* ptr, size_t size)
+{
+    sDynamicObjectPool->Deallocate(ptr, size);
+}
 
 DynamicObject::DynamicObject() : WorldObject()
 {
@@ -30,6 +30,9 @@ class DynamicObject : public WorldObject, public GridObject<DynamicObject>
     public:
         explicit DynamicObject();
 
+        static void* operator new(size_t size);
+        static void operator delete(void* ptr, size_t size);
+
         void AddToWorld();
         void RemoveFromWorld();
 
@@ -601,6 +601,9 @@ class GameObject : public WorldObject, public GridObject<GameObject>
         explicit GameObject();
         ~GameObject();
 
+        static void* operator new(size_t size);
+        static void operator delete(void* ptr, size_t size);
+
         void AddToWorld();
         void RemoveFromWorld();
         void CleanupsBeforeDelete(bool finalCleanup = true);
@@ -91,6 +91,10 @@ WorldObject::~WorldObject()
         }
         ResetMap();
     }
+
+    // objects deleted while still linked to a grid (grid unload)
+    if (m_gridPositionIndex)
+        m_gridPositionIndex->Remove(this);
 }
 
 Object::~Object()
@@ -1222,7 +1226,7 @@ void MovementInfo::OutDebug()
 WorldObject::WorldObject(): WorldLocation(),
 m_isWorldObject(false), m_name(""), m_isActive(false), m_zoneScript(NULL),
 m_transport(NULL), m_currMap(NULL), m_InstanceId(0),
-m_phaseMask(PHASEMASK_NORMAL), m_notifyflags(0), m_executed_notifies(0)
+m_phaseMask(PHASEMASK_NORMAL), m_gridPositionIndex(NULL), m_gridPositionSlot(0), m_notifyflags(0), m_executed_notifies(0)
 {
     m_serverSideVisibility.SetValue(SERVERSIDE_VISIBILITY_GHOST, GHOST_VISIBILITY_ALIVE | GHOST_VISIBILITY_GHOST);
     m_serverSideVisibilityDetect.SetValue(SERVERSIDE_VISIBILITY_GHOST, GHOST_VISIBILITY_ALIVE);
@@ -2633,6 +2637,9 @@ void WorldObject::SetPhaseMask(uint32 newPhaseMask, bool update)
 {
     m_phaseMask = newPhaseMask;
 
+    if (m_gridPositionIndex)
+        m_gridPositionIndex->SetPhaseMask(this);
+
     if (update && IsInWorld())
         UpdateObjectVisibility();
 }
@@ -23,6 +23,7 @@
 #include "UpdateFields.h"
 #include "UpdateData.h"
 #include "GridReference.h"
+#include "GridPositionIndex.h"
 #include "ObjectDefines.h"
 #include "GridDefines.h"
 #include "Map.h"
@@ -576,11 +577,26 @@ class FlaggedValuesArray32
 
 class WorldObject : public Object, public WorldLocation
 {
+    friend class GridPositionIndex;
     protected:
         explicit WorldObject();
     public:
         virtual ~WorldObject();
 
+        // hide Position::Relocate to keep the position index of the current grid cell up to date
+        void Relocate(float x, float y)
+            { Position::Relocate(x, y); _UpdateGridPosition(); }
+        void Relocate(float x, float y, float z)
+            { Position::Relocate(x, y, z); _UpdateGridPosition(); }
+        void Relocate(float x, float y, float z, float orientation)
+            { Position::Relocate(x, y, z, orientation); _UpdateGridPosition(); }
+        void Relocate(const Position &pos)
+            { Position::Relocate(pos); _UpdateGridPosition(); }
+        void Relocate(const Position *pos)
+            { Position::Relocate(pos); _UpdateGridPosition(); }
+        void RelocateOffset(const Position &offset)
+            { Position::RelocateOffset(offset); _UpdateGridPosition(); }
+
         virtual void Update (uint32 /*time_diff*/) { }
 
         void _Create(uint32 guidlow, HighGuid guidhigh, uint32 phaseMask);
@@ -873,6 +889,10 @@ class WorldObject : public Object, public WorldLocation
         uint32 m_InstanceId;                                // in map copy with instance id
         uint32 m_phaseMask;                                 // in area phase state
 
+        GridPositionIndex* m_gridPositionIndex;             // position index of the grid cell the object is linked to
+        uint32 m_gridPositionSlot;
+        void _UpdateGridPosition() { if (m_gridPositionIndex) m_gridPositionIndex->Relocate(this); }
+
         uint16 m_notifyflags;
         uint16 m_executed_notifies;
 };
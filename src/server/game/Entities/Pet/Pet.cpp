@@ -76,6 +76,7 @@ void Pet::AddToWorld()
         sObjectAccessor->AddObject(this);
         Unit::AddToWorld();
         AIM_Initialize();
+        GetMap()->UpdateSightTrigger(this);
     }
 
     // Prevent stuck pets when zoning. Pets default to "follow" when added to world
@@ -97,6 +98,7 @@ void Pet::RemoveFromWorld()
     {
         ///- Don't call the function for Creature, normal mobs + totems go in a different storage
         Unit::RemoveFromWorld();
+        GetMap()->RemoveSightTrigger(this);
         sObjectAccessor->RemoveObject(this);
     }
 }
@@ -68,6 +68,8 @@
 #include "WeatherMgr.h"
 #include "LFGMgr.h"
 #include "CharacterDatabaseCleaner.h"
+#include "CharacterCache.h"
+#include "WhoListCache.h"
 #include <cmath>
 
 // Playerbot mod
@@ -2273,6 +2275,7 @@ void Player::AddToWorld()
     ///- It will crash when updating the ObjectAccessor
     ///- The player should only be added when logging in
     Unit::AddToWorld();
+    sWhoListCache->AddPlayer(this);
 
     for (uint8 i = PLAYER_SLOT_START; i < PLAYER_SLOT_END; ++i)
         if (m_items[i])
@@ -2295,6 +2298,7 @@ void Player::RemoveFromWorld()
     ///- It will crash when updating the ObjectAccessor
     ///- The player should only be removed when logging out
     Unit::RemoveFromWorld();
+    sWhoListCache->RemovePlayer(GetGUIDLow());
 
     for (uint8 i = PLAYER_SLOT_START; i < PLAYER_SLOT_END; ++i)
     {
@@ -3819,6 +3823,13 @@ void Player::SetGMVisible(bool on)
 
         m_serverSideVisibility.SetValue(SERVERSIDE_VISIBILITY_GM, GetSession()->GetSecurity());
     }
+
+    sWhoListCache->UpdateVisibility(GetGUIDLow(), IsVisible());
+}
+
+void Player::SetInGuild(uint32 GuildId)
+{
+    SetUInt32Value(PLAYER_GUILDID, GuildId);
 }
 
 bool Player::IsGroupVisibleFor(Player const* p) const
@@ -4021,6 +4032,7 @@ void Player::GiveLevel(uint8 level)
     _ApplyAllLevelScaleItemMods(false);
 
     SetLevel(level);
+    sCharacterCache->UpdateLevel(GetGUIDLow(), level);
 
     UpdateSkillsForLevel();
 
@@ -5912,6 +5924,9 @@ void Player::DeleteFromDB(uint64 playerguid, uint32 accountId, bool updateRealmC
             sLog->outError("Player::DeleteFromDB: Unsupported delete method: %u.", charDelete_method);
     }
 
+    // removed and unlinked characters are both gone for the game, an unlinked one can only come back by restore
+    sCharacterCache->DeleteCharacter(guid);
+
     if (updateRealmChars)
         sWorld->UpdateRealmCharCount(accountId);
 }
@@ -8262,52 +8277,51 @@ void Player::ModifyArenaPoints(int32 value)
 
 uint32 Player::GetGuildIdFromDB(uint64 guid)
 {
-    QueryResult result = CharacterDatabase.PQuery("SELECT guildid FROM guild_member WHERE guid='%u'", GUID_LOPART(guid));
-    if (!result)
+    CharacterCacheEntry entry;
+    if (!sCharacterCache->GetCharacter(GUID_LOPART(guid), entry))
         return 0;
 
-    uint32 id = result->Fetch()[0].GetUInt32();
-    return id;
+    return entry.guildId;
 }
 
 uint8 Player::GetRankFromDB(uint64 guid)
 {
-    QueryResult result = CharacterDatabase.PQuery("SELECT rank FROM guild_member WHERE guid='%u'", GUID_LOPART(guid));
-    if (result)
-    {
-        uint32 v = result->Fetch()[0].GetUInt8();
-        return v;
-    }
-    else
+    CharacterCacheEntry entry;
+    if (!sCharacterCache->GetCharacter(GUID_LOPART(guid), entry))
         return 0;
+
+    return entry.guildRank;
 }
 
 uint32 Player::GetArenaTeamIdFromDB(uint64 guid, uint8 type)
 {
-    QueryResult result = CharacterDatabase.PQuery("SELECT arena_team_member.arenateamid FROM arena_team_member JOIN arena_team ON arena_team_member.arenateamid = arena_team.arenateamid WHERE guid='%u' AND type='%u' LIMIT 1", GUID_LOPART(guid), type);
-    if (!result)
+    uint8 slot = ArenaTeam::GetSlotByType(type);
+    if (slot >= MAX_ARENA_SLOT)
         return 0;
 
-    uint32 id = (*result)[0].GetUInt32();
-    return id;
+    CharacterCacheEntry entry;
+    if (!sCharacterCache->GetCharacter(GUID_LOPART(guid), entry))
+        return 0;
+
+    return entry.arenaTeamId[slot];
 }
 
 uint32 Player::GetZoneIdFromDB(uint64 guid)
 {
     uint32 guidLow = GUID_LOPART(guid);
-    QueryResult result = CharacterDatabase.PQuery("SELECT zone FROM characters WHERE guid='%u'", guidLow);
-    if (!result)
+    CharacterCacheEntry entry;
+    if (!sCharacterCache->GetCharacter(guidLow, entry))
         return 0;
-    Field* fields = result->Fetch();
-    uint32 zone = fields[0].GetUInt32();
+
+    uint32 zone = entry.zoneId;
 
     if (!zone)
     {
         // stored zone is zero, use generic and slow zone detection
-        result = CharacterDatabase.PQuery("SELECT map,position_x,position_y,position_z FROM characters WHERE guid='%u'", guidLow);
+        QueryResult result = CharacterDatabase.PQuery("SELECT map,position_x,position_y,position_z FROM characters WHERE guid='%u'", guidLow);
         if (!result)
             return 0;
-        fields = result->Fetch();
+        Field* fields = result->Fetch();
         uint32 map = fields[0].GetUInt32();
         float posx = fields[1].GetFloat();
         float posy = fields[2].GetFloat();
@@ -8316,7 +8330,10 @@ uint32 Player::GetZoneIdFromDB(uint64 guid)
         zone = sMapMgr->GetZoneId(map,posx,posy,posz);
 
         if (zone > 0)
+        {
             CharacterDatabase.PExecute("UPDATE characters SET zone='%u' WHERE guid='%u'", zone, guidLow);
+            sCharacterCache->UpdateZone(guidLow, zone);
+        }
     }
 
     return zone;
@@ -8324,14 +8341,11 @@ uint32 Player::GetZoneIdFromDB(uint64 guid)
 
 uint32 Player::GetLevelFromDB(uint64 guid)
 {
-    QueryResult result = CharacterDatabase.PQuery("SELECT level FROM characters WHERE guid='%u'", GUID_LOPART(guid));
-    if (!result)
+    CharacterCacheEntry entry;
+    if (!sCharacterCache->GetCharacter(GUID_LOPART(guid), entry))
         return 0;
 
-    Field* fields = result->Fetch();
-    uint8 level = fields[0].GetUInt8();
-
-    return level;
+    return entry.level;
 }
 
 void Player::UpdateArea(uint32 newArea)
@@ -8354,6 +8368,7 @@ void Player::UpdateZone(uint32 newZone, uint32 newArea)
         sOutdoorPvPMgr->HandlePlayerLeaveZone(this, m_zoneUpdateId);
         sOutdoorPvPMgr->HandlePlayerEnterZone(this, newZone);
         SendInitWorldStates(newZone, newArea);              // only if really enters to new zone, not just area change, works strange...
+        sWhoListCache->UpdateZone(GetGUIDLow(), newZone);
     }
 
     m_zoneUpdateId    = newZone;
@@ -19404,6 +19419,9 @@ void Player::SaveToDB()
 
     CharacterDatabase.CommitTransaction(trans);
 
+    sCharacterCache->UpdateLevel(GetGUIDLow(), getLevel());
+    sCharacterCache->UpdateZone(GetGUIDLow(), GetZoneId());
+
     // save pet (hunter pet level and experience and all type pets health/mana).
     if (Pet* pet = GetPet())
         pet->SavePetToDB(PET_SAVE_AS_CURRENT);
@@ -19928,6 +19946,7 @@ void Player::SavePositionInDB(uint32 mapid, float x,float y,float z,float o,uint
         << "transguid='0',taxi_path='' WHERE guid='"<< GUID_LOPART(guid) <<"'";
     sLog->outDebug("%s", ss.str().c_str());
     CharacterDatabase.Execute(ss.str().c_str());
+    sCharacterCache->UpdateZone(GUID_LOPART(guid), zone);
 }
 
 void Player::SetUInt32ValueInArray(Tokens& tokens,uint16 index, uint32 value)
@@ -19955,6 +19974,7 @@ void Player::Customize(uint64 guid, uint8 gender, uint8 skin, uint8 face, uint8
     player_bytes2 |= facialHair;
 
     CharacterDatabase.PExecute("UPDATE characters SET gender = '%u', playerBytes = '%u', playerBytes2 = '%u' WHERE guid = '%u'", gender, skin | (face << 8) | (hairStyle << 16) | (hairColor << 24), player_bytes2, GUID_LOPART(guid));
+    sCharacterCache->UpdateGender(GUID_LOPART(guid), gender);
 }
 
 void Player::SendAttackSwingDeadTarget()
@@ -22009,27 +22029,27 @@ bool Player::IsVisibleGloballyFor(Player* u) const
 }
 
 template<class T>
-inline void UpdateVisibilityOf_helper(std::set<uint64>& s64, T* target, std::set<Unit*>& /*v*/)
+inline void UpdateVisibilityOf_helper(Player::ClientGUIDs& s64, T* target, std::set<Unit*>& /*v*/)
 {
     s64.insert(target->GetGUID());
 }
 
 template<>
-inline void UpdateVisibilityOf_helper(std::set<uint64>& s64, GameObject* target, std::set<Unit*>& /*v*/)
+inline void UpdateVisibilityOf_helper(Player::ClientGUIDs& s64, GameObject* target, std::set<Unit*>& /*v*/)
 {
     if (!target->IsTransport())
         s64.insert(target->GetGUID());
 }
 
 template<>
-inline void UpdateVisibilityOf_helper(std::set<uint64>& s64, Creature* target, std::set<Unit*>& v)
+inline void UpdateVisibilityOf_helper(Player::ClientGUIDs& s64, Creature* target, std::set<Unit*>& v)
 {
     s64.insert(target->GetGUID());
     v.insert(target);
 }
 
 template<>
-inline void UpdateVisibilityOf_helper(std::set<uint64>& s64, Player* target, std::set<Unit*>& v)
+inline void UpdateVisibilityOf_helper(Player::ClientGUIDs& s64, Player* target, std::set<Unit*>& v)
 {
     s64.insert(target->GetGUID());
     v.insert(target);
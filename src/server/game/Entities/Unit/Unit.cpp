@@ -53,8 +53,10 @@
 #include "TemporarySummon.h"
 #include "Vehicle.h"
 #include "Transport.h"
+#include "WhoListCache.h"
 
 #include <math.h>
+#include <algorithm>
 
 float baseMoveSpeed[MAX_MOVE_TYPE] =
 {
@@ -135,9 +137,11 @@ m_vehicleKit(NULL), m_unitTypeMask(UNIT_MASK_NONE), m_HostileRefManager(this)
 
     m_ObjectSlot[0] = m_ObjectSlot[1] = m_ObjectSlot[2] = m_ObjectSlot[3] = 0;
 
-    m_auraUpdateIterator = m_ownedAuras.end();
+    m_auraUpdateClock = 0;
 
     m_interruptMask = 0;
+    m_procAuraBuckets = NULL;
+    m_procAuraMask = 0;
     m_transform = 0;
     m_canModifyStats = false;
 
@@ -210,6 +214,7 @@ Unit::~Unit()
 
     delete m_charmInfo;
     delete m_vehicleKit;
+    delete[] m_procAuraBuckets;
 
     ASSERT(!m_duringRemoveFromWorld);
     ASSERT(!m_attacking);
@@ -218,6 +223,7 @@ Unit::~Unit()
     ASSERT(m_Controlled.empty());
     ASSERT(m_appliedAuras.empty());
     ASSERT(m_ownedAuras.empty());
+    ASSERT(m_auraUpdateSchedule.empty());
     ASSERT(m_removedAuras.empty());
 }
 
@@ -2786,21 +2792,37 @@ void Unit::_UpdateSpells(uint32 time)
         }
     }
 
-    // m_auraUpdateIterator can be updated in indirect called code at aura remove to skip next planned to update but removed auras
-    for (m_auraUpdateIterator = m_ownedAuras.begin(); m_auraUpdateIterator != m_ownedAuras.end();)
+    // only auras with a due timer are updated, each with the time passed since its own last update
+    // auras rescheduled as due by other aura updates are picked up in the same pass, removed auras are unscheduled
+    uint64 updateClock = m_auraUpdateClock + time;
+    std::vector<Aura*> updatedAuras;
+    while (!m_auraUpdateSchedule.empty() && m_auraUpdateSchedule.begin()->first <= updateClock)
     {
-        Aura * i_aura = m_auraUpdateIterator->second;
-        ++m_auraUpdateIterator;                            // need shift to next for allow update if need into aura update
-        i_aura->UpdateOwner(time, this);
+        Aura * i_aura = m_auraUpdateSchedule.begin()->second;
+        m_auraUpdateSchedule.erase(m_auraUpdateSchedule.begin());
+        i_aura->SetScheduledUpdate(false);
+
+        if (i_aura->GetUpdateClock() < updateClock)
+        {
+            uint32 diff = uint32(updateClock - i_aura->GetUpdateClock());
+            i_aura->SetUpdateClock(updateClock);
+            i_aura->UpdateOwner(diff, this);
+        }
+        updatedAuras.push_back(i_aura);
     }
+    m_auraUpdateClock = updateClock;
 
     // remove expired auras - do that after updates(used in scripts?)
-    for (AuraMap::iterator i = m_ownedAuras.begin(); i != m_ownedAuras.end();)
+    for (std::vector<Aura*>::const_iterator itr = updatedAuras.begin(); itr != updatedAuras.end(); ++itr)
     {
-        if (i->second->IsExpired())
-            RemoveOwnedAura(i, AURA_REMOVE_BY_EXPIRE);
+        Aura * i_aura = *itr;
+        if (i_aura->IsRemoved())
+            continue;
+
+        if (i_aura->IsExpired())
+            RemoveOwnedAura(i_aura, AURA_REMOVE_BY_EXPIRE);
         else
-            ++i;
+            _ScheduleAuraUpdate(i_aura);
     }
 
     for (VisibleAuraMap::iterator itr = m_visibleAuras.begin(); itr != m_visibleAuras.end(); ++itr)
@@ -3116,6 +3138,8 @@ void Unit::_AddAura(UnitAura * aura, Unit * caster)
     if (aura->IsRemoved())
         return;
 
+    _ScheduleAuraUpdate(aura);
+
     aura->SetIsSingleTarget(caster && IsSingleTargetSpell(aura->GetSpellProto()));
     if (aura->IsSingleTarget())
     {
@@ -3172,6 +3196,13 @@ AuraApplication * Unit::_CreateAuraApplication(Aura * aura, uint8 effMask)
     if (AuraState aState = GetSpellAuraState(aura->GetSpellProto()))
         m_auraStateAuras.insert(AuraStateAurasMap::value_type(aState, aurApp));
 
+    // auras without proc flags never pass IsTriggeredAtSpellProcEvent, keep them out of the proc buckets
+    if (uint32 procFlags = sSpellMgr->GetSpellProcFlags(aurSpellInfo))
+    {
+        aurApp->m_procFlags = procFlags;
+        _AddProcAura(aurApp);
+    }
+
     aura->_ApplyForTarget(this, caster, aurApp);
     return aurApp;
 }
@@ -3225,6 +3256,75 @@ void Unit::_ApplyAura(AuraApplication * aurApp, uint8 effMask)
     }
 }
 
+void Unit::_AddProcAura(AuraApplication * aurApp)
+{
+    if (!m_procAuraBuckets)
+        m_procAuraBuckets = new ProcAuraBucket[MAX_PROC_FLAG_BITS];
+
+    uint32 procFlags = aurApp->GetProcFlags();
+    for (uint8 i = 0; i < MAX_PROC_FLAG_BITS; ++i)
+    {
+        if (!(procFlags & (1 << i)))
+            continue;
+
+        m_procAuraBuckets[i].push_back(aurApp);
+        m_procAuraMask |= 1 << i;
+    }
+}
+
+void Unit::_RemoveProcAura(AuraApplication * aurApp)
+{
+    uint32 procFlags = aurApp->GetProcFlags();
+    for (uint8 i = 0; i < MAX_PROC_FLAG_BITS; ++i)
+    {
+        if (!(procFlags & (1 << i)))
+            continue;
+
+        // order inside a bucket does not matter, candidates are sorted on use
+        ProcAuraBucket& bucket = m_procAuraBuckets[i];
+        ProcAuraBucket::iterator itr = std::find(bucket.begin(), bucket.end(), aurApp);
+        if (itr == bucket.end())
+            continue;
+
+        *itr = bucket.back();
+        bucket.pop_back();
+        if (bucket.empty())
+            m_procAuraMask &= ~(1 << i);
+    }
+}
+
+struct ProcAuraCandidateOrder
+{
+    bool operator()(AuraApplication const* left, AuraApplication const* right) const
+    {
+        if (left->GetBase()->GetId() != right->GetBase()->GetId())
+            return left->GetBase()->GetId() < right->GetBase()->GetId();
+        return left < right;
+    }
+};
+
+void Unit::_GetProcAuraCandidates(uint32 procFlag, std::vector<AuraApplication*>& candidates) const
+{
+    uint32 flags = procFlag & m_procAuraMask;
+    if (!flags)
+        return;
+
+    uint8 buckets = 0;
+    for (uint8 i = 0; i < MAX_PROC_FLAG_BITS; ++i)
+    {
+        if (!(flags & (1 << i)))
+            continue;
+
+        candidates.insert(candidates.end(), m_procAuraBuckets[i].begin(), m_procAuraBuckets[i].end());
+        ++buckets;
+    }
+
+    // same order as a walk over m_appliedAuras, an aura subscribed to several flags of the event is checked once
+    std::sort(candidates.begin(), candidates.end(), ProcAuraCandidateOrder());
+    if (buckets > 1)
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+}
+
 // removes aura application from lists and unapplies effects
 void Unit::_UnapplyAura(AuraApplicationMap::iterator &i, AuraRemoveMode removeMode)
 {
@@ -3272,6 +3372,9 @@ void Unit::_UnapplyAura(AuraApplicationMap::iterator &i, AuraRemoveMode removeMo
         }
     }
 
+    if (aurApp->GetProcFlags())
+        _RemoveProcAura(aurApp);
+
     aurApp->_Remove();
     aura->_UnapplyForTarget(this, caster, aurApp);
 
@@ -3298,6 +3401,10 @@ void Unit::_UnapplyAura(AuraApplicationMap::iterator &i, AuraRemoveMode removeMo
 
     aura->HandleAuraSpecificMods(aurApp, caster, false);
 
+    // owned aura lost its owner application, it has to refresh its targets again
+    if (aura->GetOwner() == this && !aura->IsRemoved())
+        _ScheduleAuraUpdate(aura);
+
     // only way correctly remove all auras from list
     //if (removedAuras != m_removedAurasCount) new aura may be added
         i = m_appliedAuras.begin();
@@ -3432,10 +3539,75 @@ bool Unit::_IsNoStackAuraDueToAura(Aura * appliedAura, Aura * existingAura) cons
 
 void Unit::_RegisterAuraEffect(AuraEffect * aurEff, bool apply)
 {
+    AuraType auraType = aurEff->GetAuraType();
     if (apply)
-        m_modAuras[aurEff->GetAuraType()].push_back(aurEff);
+    {
+        m_modAuras[auraType].push_back(aurEff);
+
+        // appending keeps the unfiltered aggregate exact (same order as walking the list), filtered ones are rebuilt on use
+        AuraModifierAggregateTypeMap::iterator itr = m_modAuraAggregates.find(auraType);
+        bool valid = itr != m_modAuraAggregates.end();
+        AuraModifierAggregate aggregate = valid ? itr->second : AuraModifierAggregate();
+        _InvalidateAuraModifiers(auraType);
+        if (valid)
+        {
+            aggregate.Add(aurEff->GetAmount());
+            m_modAuraAggregates[auraType] = aggregate;
+        }
+    }
     else
-        m_modAuras[aurEff->GetAuraType()].remove(aurEff);
+    {
+        m_modAuras[auraType].remove(aurEff);
+        _InvalidateAuraModifiers(auraType);
+    }
+}
+
+void Unit::_InvalidateAuraModifiers(AuraType auraType)
+{
+    m_modAuraAggregates.erase(auraType);
+
+    AuraModifierAggregateMap::iterator lower = m_modAuraAggregatesByMiscValue.lower_bound(MAKE_PAIR64(0, auraType));
+    AuraModifierAggregateMap::iterator upper = m_modAuraAggregatesByMiscValue.lower_bound(MAKE_PAIR64(0, auraType + 1));
+    m_modAuraAggregatesByMiscValue.erase(lower, upper);
+
+    lower = m_modAuraAggregatesByMiscMask.lower_bound(MAKE_PAIR64(0, auraType));
+    upper = m_modAuraAggregatesByMiscMask.lower_bound(MAKE_PAIR64(0, auraType + 1));
+    m_modAuraAggregatesByMiscMask.erase(lower, upper);
+}
+
+void Unit::_ScheduleAuraUpdate(Aura * aura)
+{
+    ASSERT(aura->GetOwner() == this);
+
+    _UnscheduleAuraUpdate(aura);
+
+    if (aura->IsRemoved())
+        return;
+
+    // auras without running timers (passives, permanent buffs) are never updated
+    uint32 delay;
+    if (!aura->GetNextUpdateDelay(delay))
+        return;
+
+    uint64 updateTime = aura->GetUpdateClock() + delay;
+    m_auraUpdateSchedule.insert(AuraUpdateSchedule::value_type(updateTime, aura));
+    aura->SetScheduledUpdate(true, updateTime);
+}
+
+void Unit::_UnscheduleAuraUpdate(Aura * aura)
+{
+    if (!aura->IsUpdateScheduled())
+        return;
+
+    uint64 updateTime = aura->GetScheduledUpdateTime();
+    for (AuraUpdateSchedule::iterator itr = m_auraUpdateSchedule.lower_bound(updateTime); itr != m_auraUpdateSchedule.upper_bound(updateTime); ++itr)
+        if (itr->second == aura)
+        {
+            m_auraUpdateSchedule.erase(itr);
+            break;
+        }
+
+    aura->SetScheduledUpdate(false);
 }
 
 // All aura base removes should go threw this function!
@@ -3444,9 +3616,7 @@ void Unit::RemoveOwnedAura(AuraMap::iterator &i, AuraRemoveMode removeMode)
     Aura * aura = i->second;
     ASSERT(!aura->IsRemoved());
 
-    // if unit currently update aura list then make safe update iterator shift to next
-    if (m_auraUpdateIterator == i)
-        ++m_auraUpdateIterator;
+    _UnscheduleAuraUpdate(aura);
 
     m_ownedAuras.erase(i);
     m_removedAuras.push_back(aura);
@@ -4267,82 +4437,112 @@ uint32 Unit::GetDoTsByCaster(uint64 casterGUID) const
     return dots;
 }
 
-int32 Unit::GetTotalAuraModifier(AuraType auratype) const
+void AuraModifierAggregate::Add(int32 amount)
 {
-    int32 modifier = 0;
+    total += amount;
+    AddPctN(multiplier, amount);
+    if (amount > maxPositive)
+        maxPositive = amount;
+    if (amount < maxNegative)
+        maxNegative = amount;
+}
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        modifier += (*i)->GetAmount();
+AuraModifierAggregate const& Unit::_GetAuraModifierAggregate(AuraType auraType) const
+{
+    static AuraModifierAggregate const emptyAggregate;
 
-    return modifier;
+    AuraEffectList const& auraList = GetAuraEffectsByType(auraType);
+    if (auraList.empty())
+        return emptyAggregate;
+
+    AuraModifierAggregateTypeMap::iterator itr = m_modAuraAggregates.find(auraType);
+    if (itr != m_modAuraAggregates.end())
+        return itr->second;
+
+    AuraModifierAggregate& aggregate = m_modAuraAggregates[auraType];
+    for (AuraEffectList::const_iterator i = auraList.begin(); i != auraList.end(); ++i)
+        aggregate.Add((*i)->GetAmount());
+
+    return aggregate;
 }
 
-float Unit::GetTotalAuraMultiplier(AuraType auratype) const
+AuraModifierAggregate const& Unit::_GetAuraModifierAggregateByMiscValue(AuraType auraType, int32 miscValue) const
 {
-    float multiplier = 1.0f;
+    static AuraModifierAggregate const emptyAggregate;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        AddPctN(multiplier, (*i)->GetAmount());
+    AuraEffectList const& auraList = GetAuraEffectsByType(auraType);
+    if (auraList.empty())
+        return emptyAggregate;
 
-    return multiplier;
+    uint64 key = MAKE_PAIR64(miscValue, auraType);
+    AuraModifierAggregateMap::iterator itr = m_modAuraAggregatesByMiscValue.find(key);
+    if (itr != m_modAuraAggregatesByMiscValue.end())
+        return itr->second;
+
+    AuraModifierAggregate& aggregate = m_modAuraAggregatesByMiscValue[key];
+    for (AuraEffectList::const_iterator i = auraList.begin(); i != auraList.end(); ++i)
+        if ((*i)->GetMiscValue() == miscValue)
+            aggregate.Add((*i)->GetAmount());
+
+    return aggregate;
 }
 
-int32 Unit::GetMaxPositiveAuraModifier(AuraType auratype)
+AuraModifierAggregate const& Unit::_GetAuraModifierAggregateByMiscMask(AuraType auraType, uint32 miscMask) const
 {
-    int32 modifier = 0;
+    static AuraModifierAggregate const emptyAggregate;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        if ((*i)->GetAmount() > modifier)
-            modifier = (*i)->GetAmount();
-    }
+    AuraEffectList const& auraList = GetAuraEffectsByType(auraType);
+    if (auraList.empty())
+        return emptyAggregate;
 
-    return modifier;
+    uint64 key = MAKE_PAIR64(miscMask, auraType);
+    AuraModifierAggregateMap::iterator itr = m_modAuraAggregatesByMiscMask.find(key);
+    if (itr != m_modAuraAggregatesByMiscMask.end())
+        return itr->second;
+
+    AuraModifierAggregate& aggregate = m_modAuraAggregatesByMiscMask[key];
+    for (AuraEffectList::const_iterator i = auraList.begin(); i != auraList.end(); ++i)
+        if ((*i)->GetMiscValue() & miscMask)
+            aggregate.Add((*i)->GetAmount());
+
+    return aggregate;
 }
 
-int32 Unit::GetMaxNegativeAuraModifier(AuraType auratype) const
+int32 Unit::GetTotalAuraModifier(AuraType auratype) const
 {
-    int32 modifier = 0;
+    return _GetAuraModifierAggregate(auratype).total;
+}
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        if ((*i)->GetAmount() < modifier)
-            modifier = (*i)->GetAmount();
+float Unit::GetTotalAuraMultiplier(AuraType auratype) const
+{
+    return _GetAuraModifierAggregate(auratype).multiplier;
+}
 
-    return modifier;
+int32 Unit::GetMaxPositiveAuraModifier(AuraType auratype)
+{
+    return _GetAuraModifierAggregate(auratype).maxPositive;
 }
 
-int32 Unit::GetTotalAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask) const
+int32 Unit::GetMaxNegativeAuraModifier(AuraType auratype) const
 {
-    int32 modifier = 0;
+    return _GetAuraModifierAggregate(auratype).maxNegative;
+}
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        if ((*i)->GetMiscValue()& misc_mask)
-            modifier += (*i)->GetAmount();
-    }
-    return modifier;
+int32 Unit::GetTotalAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask) const
+{
+    return _GetAuraModifierAggregateByMiscMask(auratype, misc_mask).total;
 }
 
 float Unit::GetTotalAuraMultiplierByMiscMask(AuraType auratype, uint32 misc_mask) const
 {
-    float multiplier = 1.0f;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        if ((*i)->GetMiscValue()& misc_mask)
-            AddPctN(multiplier, (*i)->GetAmount());
-    }
-    return multiplier;
+    return _GetAuraModifierAggregateByMiscMask(auratype, misc_mask).multiplier;
 }
 
 int32 Unit::GetMaxPositiveAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask, const AuraEffect* except) const
 {
+    if (!except)
+        return _GetAuraModifierAggregateByMiscMask(auratype, misc_mask).maxPositive;
+
     int32 modifier = 0;
 
     AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
@@ -4357,70 +4557,27 @@ int32 Unit::GetMaxPositiveAuraModifierByMiscMask(AuraType auratype, uint32 misc_
 
 int32 Unit::GetMaxNegativeAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask) const
 {
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        if ((*i)->GetMiscValue()& misc_mask && (*i)->GetAmount() < modifier)
-            modifier = (*i)->GetAmount();
-    }
-
-    return modifier;
+    return _GetAuraModifierAggregateByMiscMask(auratype, misc_mask).maxNegative;
 }
 
 int32 Unit::GetTotalAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const
 {
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        if ((*i)->GetMiscValue() == misc_value)
-            modifier += (*i)->GetAmount();
-    }
-    return modifier;
+    return _GetAuraModifierAggregateByMiscValue(auratype, misc_value).total;
 }
 
 float Unit::GetTotalAuraMultiplierByMiscValue(AuraType auratype, int32 misc_value) const
 {
-    float multiplier = 1.0f;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        if ((*i)->GetMiscValue() == misc_value)
-            AddPctN(multiplier, (*i)->GetAmount());
-    }
-    return multiplier;
+    return _GetAuraModifierAggregateByMiscValue(auratype, misc_value).multiplier;
 }
 
 int32 Unit::GetMaxPositiveAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const
 {
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        if ((*i)->GetMiscValue() == misc_value && (*i)->GetAmount() > modifier)
-            modifier = (*i)->GetAmount();
-    }
-
-    return modifier;
+    return _GetAuraModifierAggregateByMiscValue(auratype, misc_value).maxPositive;
 }
 
 int32 Unit::GetMaxNegativeAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const
 {
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        if ((*i)->GetMiscValue() == misc_value && (*i)->GetAmount() < modifier)
-            modifier = (*i)->GetAmount();
-    }
-
-    return modifier;
+    return _GetAuraModifierAggregateByMiscValue(auratype, misc_value).maxNegative;
 }
 
 int32 Unit::GetTotalAuraModifierByAffectMask(AuraType auratype, SpellEntry const * affectedSpell) const
@@ -12007,6 +12164,9 @@ void Unit::SetVisible(bool x)
     else
         m_serverSideVisibility.SetValue(SERVERSIDE_VISIBILITY_GM, SEC_PLAYER);
 
+    if (GetTypeId() == TYPEID_PLAYER)
+        sWhoListCache->UpdateVisibility(GetGUIDLow(), x);
+
     UpdateObjectVisibility();
 }
 
@@ -13116,6 +13276,9 @@ void Unit::SetLevel(uint8 lvl)
     // group update
     if (GetTypeId() == TYPEID_PLAYER && this->ToPlayer()->GetGroup())
         this->ToPlayer()->SetGroupUpdateFlag(GROUP_UPDATE_FLAG_LEVEL);
+
+    if (GetTypeId() == TYPEID_PLAYER)
+        sWhoListCache->UpdateLevel(GetGUIDLow(), lvl);
 }
 
 void Unit::SetHealth(uint32 val)
@@ -13824,19 +13987,25 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit * pTarget, uint32 procFlag,
         }
     }
 
+    // Defensive procs are active on absorbs (so absorption effects are not a hindrance)
+    bool active = (damage > 0) || (procExtra & (PROC_EX_ABSORB|PROC_EX_BLOCK) && isVictim);
+    if (isVictim)
+        procExtra &= ~PROC_EX_INTERNAL_REQ_FAMILY;
+
+    // Only auras subscribed to one of the event's proc flags can trigger
+    std::vector<AuraApplication*> procAuras;
+    _GetProcAuraCandidates(procFlag, procAuras);
+
     ProcTriggeredList procTriggered;
     // Fill procTriggered list
-    for (AuraApplicationMap::const_iterator itr = GetAppliedAuras().begin(); itr!= GetAppliedAuras().end(); ++itr)
+    for (std::vector<AuraApplication*>::const_iterator itr = procAuras.begin(); itr != procAuras.end(); ++itr)
     {
+        AuraApplication* aurApp = *itr;
         // Do not allow auras to proc from effect triggered by itself
-        if (procAura && procAura->Id == itr->first)
+        if (procAura && procAura->Id == aurApp->GetBase()->GetId())
             continue;
-        ProcTriggeredData triggerData(itr->second->GetBase());
-        // Defensive procs are active on absorbs (so absorption effects are not a hindrance)
-        bool active = (damage > 0) || (procExtra & (PROC_EX_ABSORB|PROC_EX_BLOCK) && isVictim);
-        if (isVictim)
-            procExtra &= ~PROC_EX_INTERNAL_REQ_FAMILY;
-        SpellEntry const* spellProto = itr->second->GetBase()->GetSpellProto();
+        ProcTriggeredData triggerData(aurApp->GetBase());
+        SpellEntry const* spellProto = aurApp->GetBase()->GetSpellProto();
         if(!IsTriggeredAtSpellProcEvent(pTarget, triggerData.aura, procSpell, procFlag, procExtra, attType, isVictim, active, triggerData.spellProcEvent))
             continue;
 
@@ -13846,9 +14015,9 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit * pTarget, uint32 procFlag,
 
         for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
         {
-            if (itr->second->HasEffect(i))
+            if (aurApp->HasEffect(i))
             {
-                AuraEffect * aurEff = itr->second->GetBase()->GetEffect(i);
+                AuraEffect * aurEff = aurApp->GetBase()->GetEffect(i);
                 // Skip this auras
                 if (isNonTriggerAura[aurEff->GetAuraType()])
                     continue;
@@ -14155,6 +14324,9 @@ void Unit::SendPetAIReaction(uint64 guid)
 
 void Unit::StopMoving()
 {
+    // stop where the client sees us, not at the last path update
+    GetMotionMaster()->SyncOwnerPosition();
+
     ClearUnitState(UNIT_STAT_MOVING);
 
     // send explicit stop packet
@@ -14654,12 +14826,8 @@ bool Unit::IsTriggeredAtSpellProcEvent(Unit *pVictim, Aura * aura, SpellEntry co
     // Get proc Event Entry
     spellProcEvent = sSpellMgr->GetSpellProcEvent(spellProto->Id);
 
-    // Get EventProcFlag
-    uint32 EventProcFlag;
-    if (spellProcEvent && spellProcEvent->procFlags) // if exist get custom spellProcEvent->procFlags
-        EventProcFlag = spellProcEvent->procFlags;
-    else
-        EventProcFlag = spellProto->procFlags;       // else get from spell proto
+    // Get EventProcFlag, custom spellProcEvent->procFlags if exist else from spell proto
+    uint32 EventProcFlag = sSpellMgr->GetSpellProcFlags(spellProto);
     // Continue if no trigger exist
     if (!EventProcFlag)
         return false;
@@ -16002,8 +16170,7 @@ void Unit::UpdateObjectVisibility(bool forced)
     {
         WorldObject::UpdateObjectVisibility(true);
         // call MoveInLineOfSight for nearby creatures
-        Trinity::AIRelocationNotifier notifier(*this);
-        VisitNearbyObject(GetVisibilityRange(), notifier);
+        GetMap()->NotifySightTriggers(this, false);
     }
 }
 
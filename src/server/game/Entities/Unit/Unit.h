@@ -1121,6 +1121,19 @@ enum PlayerTotemType
 #define ATTACK_DISPLAY_DELAY 200
 #define MAX_PLAYER_STEALTH_DETECT_RANGE 30.0f               // max distance for detection targets by player
 
+// Cached result of walking one m_modAuras list (optionally filtered by misc value/mask)
+struct AuraModifierAggregate
+{
+    AuraModifierAggregate() : total(0), multiplier(1.0f), maxPositive(0), maxNegative(0) {}
+
+    void Add(int32 amount);
+
+    int32 total;                                            // sum of amounts
+    float multiplier;                                       // product of (100 + amount) / 100
+    int32 maxPositive;                                      // highest amount, at least 0
+    int32 maxNegative;                                      // lowest amount, at most 0
+};
+
 struct SpellProcEventEntry;                                 // used only privately
 
 class Unit : public WorldObject
@@ -1130,6 +1143,7 @@ class Unit : public WorldObject
         typedef std::set<Unit*> ControlList;
         typedef std::pair<uint32, uint8> spellEffectPair;
         typedef std::multimap<uint32,  Aura*> AuraMap;
+        typedef std::multimap<uint64,  Aura*> AuraUpdateSchedule;
         typedef std::multimap<uint32,  AuraApplication*> AuraApplicationMap;
         typedef std::multimap<AuraState,  AuraApplication*> AuraStateAurasMap;
         typedef std::list<AuraEffect *> AuraEffectList;
@@ -1610,13 +1624,23 @@ class Unit : public WorldObject
         void _UnapplyAura(AuraApplication * aurApp, AuraRemoveMode removeMode);
         void _RemoveNoStackAuraApplicationsDueToAura(Aura * aura);
         void _RemoveNoStackAurasDueToAura(Aura * aura);
+        void _AddProcAura(AuraApplication * aurApp);
+        void _RemoveProcAura(AuraApplication * aurApp);
+        // applications subscribed to at least one of the given proc flags, each once, ordered by spell id
+        void _GetProcAuraCandidates(uint32 procFlag, std::vector<AuraApplication*>& candidates) const;
         bool _IsNoStackAuraDueToAura(Aura * appliedAura, Aura * existingAura) const;
         void _RegisterAuraEffect(AuraEffect * aurEff, bool apply);
+        void _InvalidateAuraModifiers(AuraType auraType);
 
         // m_ownedAuras container management
         AuraMap      & GetOwnedAuras()       { return m_ownedAuras; }
         AuraMap const& GetOwnedAuras() const { return m_ownedAuras; }
 
+        // owned auras with a running timer, updated only when it is due
+        uint64 GetAuraUpdateClock() const { return m_auraUpdateClock; }
+        void _ScheduleAuraUpdate(Aura * aura);
+        void _UnscheduleAuraUpdate(Aura * aura);
+
         void RemoveOwnedAura(AuraMap::iterator &i, AuraRemoveMode removeMode = AURA_REMOVE_BY_DEFAULT);
         void RemoveOwnedAura(uint32 spellId, uint64 caster = 0, uint8 reqEffMask = 0, AuraRemoveMode removeMode = AURA_REMOVE_BY_DEFAULT);
         void RemoveOwnedAura(Aura * aura, AuraRemoveMode removeMode = AURA_REMOVE_BY_DEFAULT);
@@ -2090,12 +2114,23 @@ class Unit : public WorldObject
         AuraMap m_ownedAuras;
         AuraApplicationMap m_appliedAuras;
         AuraList m_removedAuras;
-        AuraMap::iterator m_auraUpdateIterator;
+        uint64 m_auraUpdateClock;                           // total time passed through _UpdateSpells
+        AuraUpdateSchedule m_auraUpdateSchedule;            // aura clock time of next due timer -> owned aura
         uint32 m_removedAurasCount;
 
         AuraEffectList m_modAuras[TOTAL_AURAS];
+        // aggregates of m_modAuras, updated on apply and rebuilt on next use after remove or amount change,
+        // only held for aura types present on the unit
+        typedef std::map<uint32/*aura type*/, AuraModifierAggregate> AuraModifierAggregateTypeMap;
+        typedef std::map<uint64/*(misc value or mask, aura type) pair*/, AuraModifierAggregate> AuraModifierAggregateMap;
+        mutable AuraModifierAggregateTypeMap m_modAuraAggregates;
+        mutable AuraModifierAggregateMap m_modAuraAggregatesByMiscValue;
+        mutable AuraModifierAggregateMap m_modAuraAggregatesByMiscMask;
         AuraList m_scAuras;                        // casted singlecast auras
         AuraApplicationList m_interruptableAuras;             // auras which have interrupt mask applied on unit
+        typedef std::vector<AuraApplication*> ProcAuraBucket;
+        ProcAuraBucket* m_procAuraBuckets;                    // per proc flag bit, auras that can trigger on it; allocated with the first such aura
+        uint32 m_procAuraMask;                                // proc flags with a non empty bucket
         AuraStateAurasMap m_auraStateAuras;        // Used for improve performance of aura state checks on aura apply/remove
         uint32 m_interruptMask;
 
@@ -2131,6 +2166,10 @@ class Unit : public WorldObject
 
         bool isAlwaysDetectableFor(WorldObject const* seer) const;
     private:
+        AuraModifierAggregate const& _GetAuraModifierAggregate(AuraType auraType) const;
+        AuraModifierAggregate const& _GetAuraModifierAggregateByMiscValue(AuraType auraType, int32 miscValue) const;
+        AuraModifierAggregate const& _GetAuraModifierAggregateByMiscMask(AuraType auraType, uint32 miscMask) const;
+
         bool IsTriggeredAtSpellProcEvent(Unit *pVictim, Aura * aura, SpellEntry const * procSpell, uint32 procFlag, uint32 procExtra, WeaponAttackType attType, bool isVictim, bool active, SpellProcEventEntry const *& spellProcEvent);
         bool HandleDummyAuraProc(Unit *pVictim, uint32 damage, AuraEffect* triggeredByAura, SpellEntry const *procSpell, uint32 procFlag, uint32 procEx, uint32 cooldown);
         bool HandleHasteAuraProc(Unit *pVictim, uint32 damage, AuraEffect* triggeredByAura, SpellEntry const *procSpell, uint32 procFlag, uint32 procEx, uint32 cooldown);
@@ -0,0 +1,304 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CharacterCache.h"
+#include "DatabaseEnv.h"
+#include "ObjectMgr.h"
+#include "ArenaTeam.h"
+#include "Util.h"
+#include "Timer.h"
+#include <ace/Guard_T.h>
+
+std::string CharacterCache::GetNameKey(std::string const& name)
+{
+    return Utf8ToLowerKey(name);
+}
+
+void CharacterCache::_RemoveName(CharacterCacheEntry const& entry)
+{
+    NameIndex::iterator itr = m_nameIndex.find(GetNameKey(entry.name));
+    if (itr != m_nameIndex.end() && itr->second == entry.guid)
+        m_nameIndex.erase(itr);
+}
+
+void CharacterCache::_AddCharacter(CharacterCacheEntry const& entry)
+{
+    CharacterMap::iterator itr = m_characters.find(entry.guid);
+    if (itr != m_characters.end())
+        _RemoveName(itr->second);
+
+    m_characters[entry.guid] = entry;
+
+    // a character imported with a name already in use keeps it until the forced rename, the name stays with the old owner
+    if (!entry.name.empty())
+        m_nameIndex.insert(NameIndex::value_type(GetNameKey(entry.name), entry.guid));
+}
+
+void CharacterCache::LoadFromDB()
+{
+    uint32 oldMSTime = getMSTime();
+
+    ACE_WRITE_GUARD(ACE_RW_Thread_Mutex, guard, m_lock);
+
+    m_characters.clear();
+    m_nameIndex.clear();
+
+    //                                                     0     1     2        3     4      5       6      7
+    QueryResult result = CharacterDatabase.Query("SELECT guid, name, account, race, class, gender, level, zone FROM characters WHERE deleteDate IS NULL");
+    if (!result)
+    {
+        sLog->outString(">> Loaded 0 characters into the character cache. DB table `characters` is empty.");
+        sLog->outString();
+        return;
+    }
+
+    do
+    {
+        Field* fields = result->Fetch();
+
+        CharacterCacheEntry entry;
+        entry.guid        = fields[0].GetUInt32();
+        entry.name        = fields[1].GetString();
+        entry.account     = fields[2].GetUInt32();
+        entry.race        = fields[3].GetUInt8();
+        entry.playerClass = fields[4].GetUInt8();
+        entry.gender      = fields[5].GetUInt8();
+        entry.level       = fields[6].GetUInt8();
+        entry.zoneId      = fields[7].GetUInt32();
+        _AddCharacter(entry);
+    }
+    while (result->NextRow());
+
+    //                                        0     1        2
+    result = CharacterDatabase.Query("SELECT guid, guildid, rank FROM guild_member");
+    if (result)
+    {
+        do
+        {
+            Field* fields = result->Fetch();
+            CharacterMap::iterator itr = m_characters.find(fields[0].GetUInt32());
+            if (itr == m_characters.end())
+                continue;
+
+            itr->second.guildId   = fields[1].GetUInt32();
+            itr->second.guildRank = fields[2].GetUInt8();
+        }
+        while (result->NextRow());
+    }
+
+    //                                                           0                               1                  2
+    result = CharacterDatabase.Query("SELECT arena_team_member.guid, arena_team_member.arenateamid, arena_team.type FROM arena_team_member "
+        "JOIN arena_team ON arena_team_member.arenateamid = arena_team.arenateamid");
+    if (result)
+    {
+        do
+        {
+            Field* fields = result->Fetch();
+            CharacterMap::iterator itr = m_characters.find(fields[0].GetUInt32());
+            if (itr == m_characters.end())
+                continue;
+
+            uint8 slot = ArenaTeam::GetSlotByType(fields[2].GetUInt8());
+            if (slot < MAX_CHARACTER_CACHE_ARENA_SLOT)
+                itr->second.arenaTeamId[slot] = fields[1].GetUInt32();
+        }
+        while (result->NextRow());
+    }
+
+    sLog->outString(">> Loaded %u characters into the character cache in %u ms", uint32(m_characters.size()), GetMSTimeDiffToNow(oldMSTime));
+    sLog->outString();
+}
+
+void CharacterCache::LoadCharacterFromDB(uint32 guidLow)
+{
+    QueryResult result = CharacterDatabase.PQuery("SELECT guid, name, account, race, class, gender, level, zone FROM characters WHERE guid = '%u' AND deleteDate IS NULL", guidLow);
+    if (!result)
+    {
+        DeleteCharacter(guidLow);
+        return;
+    }
+
+    Field* fields = result->Fetch();
+
+    CharacterCacheEntry entry;
+    entry.guid        = fields[0].GetUInt32();
+    entry.name        = fields[1].GetString();
+    entry.account     = fields[2].GetUInt32();
+    entry.race        = fields[3].GetUInt8();
+    entry.playerClass = fields[4].GetUInt8();
+    entry.gender      = fields[5].GetUInt8();
+    entry.level       = fields[6].GetUInt8();
+    entry.zoneId      = fields[7].GetUInt32();
+
+    if (QueryResult guildResult = CharacterDatabase.PQuery("SELECT guildid, rank FROM guild_member WHERE guid = '%u'", guidLow))
+    {
+        entry.guildId   = (*guildResult)[0].GetUInt32();
+        entry.guildRank = (*guildResult)[1].GetUInt8();
+    }
+
+    if (QueryResult arenaResult = CharacterDatabase.PQuery("SELECT arena_team_member.arenateamid, arena_team.type FROM arena_team_member "
+        "JOIN arena_team ON arena_team_member.arenateamid = arena_team.arenateamid WHERE guid = '%u'", guidLow))
+    {
+        do
+        {
+            uint8 slot = ArenaTeam::GetSlotByType((*arenaResult)[1].GetUInt8());
+            if (slot < MAX_CHARACTER_CACHE_ARENA_SLOT)
+                entry.arenaTeamId[slot] = (*arenaResult)[0].GetUInt32();
+        }
+        while (arenaResult->NextRow());
+    }
+
+    ACE_WRITE_GUARD(ACE_RW_Thread_Mutex, guard, m_lock);
+    _AddCharacter(entry);
+}
+
+void CharacterCache::AddCharacter(uint32 guidLow, std::string const& name, uint32 account, uint8 race, uint8 playerClass, uint8 gender, uint8 level, uint32 zoneId)
+{
+    CharacterCacheEntry entry;
+    entry.guid        = guidLow;
+    entry.name        = name;
+    entry.account     = account;
+    entry.race        = race;
+    entry.playerClass = playerClass;
+    entry.gender      = gender;
+    entry.level       = level;
+    entry.zoneId      = zoneId;
+
+    ACE_WRITE_GUARD(ACE_RW_Thread_Mutex, guard, m_lock);
+    _AddCharacter(entry);
+}
+
+void CharacterCache::DeleteCharacter(uint32 guidLow)
+{
+    ACE_WRITE_GUARD(ACE_RW_Thread_Mutex, guard, m_lock);
+
+    CharacterMap::iterator itr = m_characters.find(guidLow);
+    if (itr == m_characters.end())
+        return;
+
+    _RemoveName(itr->second);
+    m_characters.erase(itr);
+}
+
+void CharacterCache::UpdateName(uint32 guidLow, std::string const& name)
+{
+    ACE_WRITE_GUARD(ACE_RW_Thread_Mutex, guard, m_lock);
+
+    CharacterMap::iterator itr = m_characters.find(guidLow);
+    if (itr == m_characters.end())
+        return;
+
+    _RemoveName(itr->second);
+    itr->second.name = name;
+    m_nameIndex[GetNameKey(name)] = guidLow;
+}
+
+void CharacterCache::UpdateRace(uint32 guidLow, uint8 race)
+{
+    ACE_WRITE_GUARD(ACE_RW_Thread_Mutex, guard, m_lock);
+
+    CharacterMap::iterator itr = m_characters.find(guidLow);
+    if (itr != m_characters.end())
+        itr->second.race = race;
+}
+
+void CharacterCache::UpdateGender(uint32 guidLow, uint8 gender)
+{
+    ACE_WRITE_GUARD(ACE_RW_Thread_Mutex, guard, m_lock);
+
+    CharacterMap::iterator itr = m_characters.find(guidLow);
+    if (itr != m_characters.end())
+        itr->second.gender = gender;
+}
+
+void CharacterCache::UpdateLevel(uint32 guidLow, uint8 level)
+{
+    ACE_WRITE_GUARD(ACE_RW_Thread_Mutex, guard, m_lock);
+
+    CharacterMap::iterator itr = m_characters.find(guidLow);
+    if (itr != m_characters.end())
+        itr->second.level = level;
+}
+
+void CharacterCache::UpdateZone(uint32 guidLow, uint32 zoneId)
+{
+    ACE_WRITE_GUARD(ACE_RW_Thread_Mutex, guard, m_lock);
+
+    CharacterMap::iterator itr = m_characters.find(guidLow);
+    if (itr != m_characters.end())
+        itr->second.zoneId = zoneId;
+}
+
+void CharacterCache::UpdateGuild(uint32 guidLow, uint32 guildId, uint8 rank)
+{
+    ACE_WRITE_GUARD(ACE_RW_Thread_Mutex, guard, m_lock);
+
+    CharacterMap::iterator itr = m_characters.find(guidLow);
+    if (itr == m_characters.end())
+        return;
+
+    itr->second.guildId = guildId;
+    itr->second.guildRank = rank;
+}
+
+void CharacterCache::UpdateArenaTeam(uint32 guidLow, uint8 slot, uint32 arenaTeamId)
+{
+    if (slot >= MAX_CHARACTER_CACHE_ARENA_SLOT)
+        return;
+
+    ACE_WRITE_GUARD(ACE_RW_Thread_Mutex, guard, m_lock);
+
+    CharacterMap::iterator itr = m_characters.find(guidLow);
+    if (itr != m_characters.end())
+        itr->second.arenaTeamId[slot] = arenaTeamId;
+}
+
+bool CharacterCache::GetCharacter(uint32 guidLow, CharacterCacheEntry& entry) const
+{
+    ACE_READ_GUARD_RETURN(ACE_RW_Thread_Mutex, guard, m_lock, false);
+
+    CharacterMap::const_iterator itr = m_characters.find(guidLow);
+    if (itr == m_characters.end())
+        return false;
+
+    entry = itr->second;
+    return true;
+}
+
+bool CharacterCache::HasCharacter(uint32 guidLow) const
+{
+    ACE_READ_GUARD_RETURN(ACE_RW_Thread_Mutex, guard, m_lock, false);
+
+    return m_characters.find(guidLow) != m_characters.end();
+}
+
+uint32 CharacterCache::GetGuidByName(std::string const& name) const
+{
+    std::string key = GetNameKey(name);
+
+    ACE_READ_GUARD_RETURN(ACE_RW_Thread_Mutex, guard, m_lock, 0);
+
+    NameIndex::const_iterator itr = m_nameIndex.find(key);
+    return itr != m_nameIndex.end() ? itr->second : 0;
+}
+
+uint32 CharacterCache::GetSize() const
+{
+    ACE_READ_GUARD_RETURN(ACE_RW_Thread_Mutex, guard, m_lock, 0);
+
+    return uint32(m_characters.size());
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_CHARACTERCACHE_H
+#define TRINITY_CHARACTERCACHE_H
+
+#include "Define.h"
+#include "UnorderedMap.h"
+#include <ace/Singleton.h>
+#include <ace/RW_Thread_Mutex.h>
+#include <string>
+
+#define MAX_CHARACTER_CACHE_ARENA_SLOT 3                    // same as MAX_ARENA_SLOT
+
+struct CharacterCacheEntry
+{
+    CharacterCacheEntry() : guid(0), account(0), race(0), playerClass(0), gender(0), level(0), zoneId(0), guildId(0), guildRank(0)
+    {
+        for (uint8 i = 0; i < MAX_CHARACTER_CACHE_ARENA_SLOT; ++i)
+            arenaTeamId[i] = 0;
+    }
+
+    uint32 guid;
+    std::string name;
+    uint32 account;
+    uint8 race;
+    uint8 playerClass;
+    uint8 gender;
+    uint8 level;
+    uint32 zoneId;
+    uint32 guildId;
+    uint8 guildRank;
+    uint32 arenaTeamId[MAX_CHARACTER_CACHE_ARENA_SLOT];
+};
+
+/*
+ * Realm-wide cache of the basic data of every character, online or not.
+ *
+ * Loaded once at startup and kept current by the code that changes the
+ * underlying rows (character create/delete/rename, level and zone on save,
+ * guild and arena team membership), so lookups about offline characters do
+ * not have to query the character database. Entries are looked up by low guid
+ * or by name; the name index is case insensitive like the database collation.
+ *
+ * Map threads read and update the cache concurrently, all access goes through
+ * a RW lock and lookups return copies.
+ */
+class CharacterCache
+{
+    friend class ACE_Singleton<CharacterCache, ACE_Null_Mutex>;
+    CharacterCache() {}
+
+    public:
+        void LoadFromDB();
+        // Reloads a single character, for rows written outside of the normal code paths (dump import, restore)
+        void LoadCharacterFromDB(uint32 guidLow);
+
+        void AddCharacter(uint32 guidLow, std::string const& name, uint32 account, uint8 race, uint8 playerClass, uint8 gender, uint8 level, uint32 zoneId);
+        void DeleteCharacter(uint32 guidLow);
+
+        void UpdateName(uint32 guidLow, std::string const& name);
+        void UpdateRace(uint32 guidLow, uint8 race);
+        void UpdateGender(uint32 guidLow, uint8 gender);
+        void UpdateLevel(uint32 guidLow, uint8 level);
+        void UpdateZone(uint32 guidLow, uint32 zoneId);
+        void UpdateGuild(uint32 guidLow, uint32 guildId, uint8 rank);
+        void UpdateArenaTeam(uint32 guidLow, uint8 slot, uint32 arenaTeamId);
+
+        bool GetCharacter(uint32 guidLow, CharacterCacheEntry& entry) const;
+        bool HasCharacter(uint32 guidLow) const;
+        // Returns the low guid of the character with that name or 0
+        uint32 GetGuidByName(std::string const& name) const;
+
+        uint32 GetSize() const;
+
+    private:
+        typedef UNORDERED_MAP<uint32, CharacterCacheEntry> CharacterMap;
+        typedef UNORDERED_MAP<std::string, uint32> NameIndex;
+
+        static std::string GetNameKey(std::string const& name);
+        void _AddCharacter(CharacterCacheEntry const& entry);
+        void _RemoveName(CharacterCacheEntry const& entry);
+
+        CharacterMap m_characters;
+        NameIndex m_nameIndex;
+        mutable ACE_RW_Thread_Mutex m_lock;
+};
+
+#define sCharacterCache ACE_Singleton<CharacterCache, ACE_Null_Mutex>::instance()
+
+#endif
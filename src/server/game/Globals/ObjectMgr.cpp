@@ -20,6 +20,7 @@
 #include "DatabaseEnv.h"
 #include "SQLStorage.h"
 #include "SQLStorageImpl.h"
+#include "Fingerprint.h"
 #include "Log.h"
 #include "MapManager.h"
 #include "ObjectMgr.h"
@@ -46,6 +47,7 @@
 #include "ScriptMgr.h"
 #include "SpellScript.h"
 #include "PoolMgr.h"
+#include "CharacterCache.h"
 
 ScriptMapMap sQuestEndScripts;
 ScriptMapMap sQuestStartScripts;
@@ -1608,8 +1610,7 @@ void ObjectMgr::AddCreatureToGrid(uint32 guid, CreatureData const* data)
             CellPair cell_pair = Trinity::ComputeCellPair(data->posX, data->posY);
             uint32 cell_id = (cell_pair.y_coord*TOTAL_NUMBER_OF_CELLS_PER_MAP) + cell_pair.x_coord;
 
-            CellObjectGuids& cell_guids = mMapObjectGuids[MAKE_PAIR32(data->mapid,i)][cell_id];
-            cell_guids.creatures.insert(guid);
+            mSpawnIndex.AddSpawn(SPAWN_INDEX_CREATURE, MAKE_PAIR32(data->mapid,i), cell_id, guid);
         }
     }
 }
@@ -1624,8 +1625,7 @@ void ObjectMgr::RemoveCreatureFromGrid(uint32 guid, CreatureData const* data)
             CellPair cell_pair = Trinity::ComputeCellPair(data->posX, data->posY);
             uint32 cell_id = (cell_pair.y_coord*TOTAL_NUMBER_OF_CELLS_PER_MAP) + cell_pair.x_coord;
 
-            CellObjectGuids& cell_guids = mMapObjectGuids[MAKE_PAIR32(data->mapid,i)][cell_id];
-            cell_guids.creatures.erase(guid);
+            mSpawnIndex.RemoveSpawn(SPAWN_INDEX_CREATURE, MAKE_PAIR32(data->mapid,i), cell_id, guid);
         }
     }
 }
@@ -1923,8 +1923,7 @@ void ObjectMgr::AddGameobjectToGrid(uint32 guid, GameObjectData const* data)
             CellPair cell_pair = Trinity::ComputeCellPair(data->posX, data->posY);
             uint32 cell_id = (cell_pair.y_coord*TOTAL_NUMBER_OF_CELLS_PER_MAP) + cell_pair.x_coord;
 
-            CellObjectGuids& cell_guids = mMapObjectGuids[MAKE_PAIR32(data->mapid,i)][cell_id];
-            cell_guids.gameobjects.insert(guid);
+            mSpawnIndex.AddSpawn(SPAWN_INDEX_GAMEOBJECT, MAKE_PAIR32(data->mapid,i), cell_id, guid);
         }
     }
 }
@@ -1939,8 +1938,7 @@ void ObjectMgr::RemoveGameobjectFromGrid(uint32 guid, GameObjectData const* data
             CellPair cell_pair = Trinity::ComputeCellPair(data->posX, data->posY);
             uint32 cell_id = (cell_pair.y_coord*TOTAL_NUMBER_OF_CELLS_PER_MAP) + cell_pair.x_coord;
 
-            CellObjectGuids& cell_guids = mMapObjectGuids[MAKE_PAIR32(data->mapid,i)][cell_id];
-            cell_guids.gameobjects.erase(guid);
+            mSpawnIndex.RemoveSpawn(SPAWN_INDEX_GAMEOBJECT, MAKE_PAIR32(data->mapid,i), cell_id, guid);
         }
     }
 }
@@ -1969,12 +1967,16 @@ void ObjectMgr::LoadCreatureRespawnTimes()
         uint64 respawn_time = fields[1].GetUInt64();
         uint32 instance     = fields[2].GetUInt32();
 
-        mCreatureRespawnTimes[MAKE_PAIR64(loguid,instance)] = time_t(respawn_time);
+        CreatureData const* data = GetCreatureData(loguid);
+        if (!data)
+            continue;
+
+        mStoredCreatureRespawnTimes[MAKE_PAIR64(data->mapid,instance)][loguid] = time_t(respawn_time);
 
         ++count;
     } while (result->NextRow());
 
-    sLog->outString(">> Loaded %lu creature respawn times in %u ms", (unsigned long)mCreatureRespawnTimes.size(), GetMSTimeDiffToNow(oldMSTime));
+    sLog->outString(">> Loaded %u creature respawn times in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
     sLog->outString();
 }
 
@@ -2006,13 +2008,17 @@ void ObjectMgr::LoadGameobjectRespawnTimes()
         uint64 respawn_time = fields[1].GetUInt64();
         uint32 instance     = fields[2].GetUInt32();
 
-        mGORespawnTimes[MAKE_PAIR64(loguid,instance)] = time_t(respawn_time);
+        GameObjectData const* data = GetGOData(loguid);
+        if (!data)
+            continue;
+
+        mStoredGORespawnTimes[MAKE_PAIR64(data->mapid,instance)][loguid] = time_t(respawn_time);
 
         ++count;
     } while (result->NextRow());
 
     sLog->outString();
-    sLog->outString(">> Loaded %lu gameobject respawn times in %u ms", (unsigned long)mGORespawnTimes.size(), GetMSTimeDiffToNow(oldMSTime));
+    sLog->outString(">> Loaded %u gameobject respawn times in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
 }
 
 Player* ObjectMgr::GetPlayerByLowGUID(uint32 lowguid) const
@@ -2024,83 +2030,65 @@ Player* ObjectMgr::GetPlayerByLowGUID(uint32 lowguid) const
 // name must be checked to correctness (if received) before call this function
 uint64 ObjectMgr::GetPlayerGUIDByName(std::string name) const
 {
-    uint64 guid = 0;
+    if (uint32 guidLow = sCharacterCache->GetGuidByName(name))
+        return MAKE_NEW_GUID(guidLow, 0, HIGHGUID_PLAYER);
 
-    CharacterDatabase.escape_string(name);
-
-    // Player name safe to sending to DB (checked at login) and this function using
-    QueryResult result = CharacterDatabase.PQuery("SELECT guid FROM characters WHERE name = '%s'", name.c_str());
-    if (result)
-        guid = MAKE_NEW_GUID((*result)[0].GetUInt32(), 0, HIGHGUID_PLAYER);
-
-    return guid;
+    return 0;
 }
 
 bool ObjectMgr::GetPlayerNameByGUID(const uint64 &guid, std::string &name) const
 {
-    // prevent DB access for online player
+    // prevent cache access for online player
     if (Player* player = GetPlayer(guid))
     {
         name = player->GetName();
         return true;
     }
 
-    QueryResult result = CharacterDatabase.PQuery("SELECT name FROM characters WHERE guid = '%u'", GUID_LOPART(guid));
-
-    if (result)
-    {
-        name = (*result)[0].GetString();
-        return true;
-    }
+    CharacterCacheEntry entry;
+    if (!sCharacterCache->GetCharacter(GUID_LOPART(guid), entry))
+        return false;
 
-    return false;
+    name = entry.name;
+    return true;
 }
 
 uint32 ObjectMgr::GetPlayerTeamByGUID(const uint64 &guid) const
 {
-    // prevent DB access for online player
+    // prevent cache access for online player
     if (Player* player = GetPlayer(guid))
     {
         return Player::TeamForRace(player->getRace());
     }
 
-    QueryResult result = CharacterDatabase.PQuery("SELECT race FROM characters WHERE guid = '%u'", GUID_LOPART(guid));
-
-    if (result)
-    {
-        uint8 race = (*result)[0].GetUInt8();
-        return Player::TeamForRace(race);
-    }
+    CharacterCacheEntry entry;
+    if (sCharacterCache->GetCharacter(GUID_LOPART(guid), entry))
+        return Player::TeamForRace(entry.race);
 
     return 0;
 }
 
 uint32 ObjectMgr::GetPlayerAccountIdByGUID(const uint64 &guid) const
 {
-    // prevent DB access for online player
+    // prevent cache access for online player
     if (Player* player = GetPlayer(guid))
     {
         return player->GetSession()->GetAccountId();
     }
 
-    QueryResult result = CharacterDatabase.PQuery("SELECT account FROM characters WHERE guid = '%u'", GUID_LOPART(guid));
-    if (result)
-    {
-        uint32 acc = (*result)[0].GetUInt32();
-        return acc;
-    }
+    CharacterCacheEntry entry;
+    if (sCharacterCache->GetCharacter(GUID_LOPART(guid), entry))
+        return entry.account;
 
     return 0;
 }
 
 uint32 ObjectMgr::GetPlayerAccountIdByPlayerName(const std::string& name) const
 {
-    QueryResult result = CharacterDatabase.PQuery("SELECT account FROM characters WHERE name = '%s'", name.c_str());
-    if (result)
-    {
-        uint32 acc = (*result)[0].GetUInt32();
-        return acc;
-    }
+    CharacterCacheEntry entry;
+    if (uint32 guidLow = sCharacterCache->GetGuidByName(name))
+        if (sCharacterCache->GetCharacter(guidLow, entry))
+            return entry.account;
 
     return 0;
 }
@@ -2140,6 +2128,90 @@ void ObjectMgr::LoadItemLocales()
     sLog->outString();
 }
 
+static void AddTemplateName(TemplateNameIndex& index, char const* name, uint32 entry)
+{
+    if (!name || !*name)
+        return;
+
+    // entries are added in ascending order, a duplicated name keeps the lowest entry
+    index.insert(TemplateNameIndex::value_type(Utf8ToLowerKey(name), entry));
+}
+
+void ObjectMgr::SwapNameIndex(TemplateNameIndex* index, TemplateNameIndex* newIndex)
+{
+    ACE_WRITE_GUARD(ACE_RW_Thread_Mutex, guard, m_templateNameIndexLock);
+
+    for (uint8 i = 0; i < TOTAL_LOCALES; ++i)
+        index[i].swap(newIndex[i]);
+}
+
+uint32 ObjectMgr::GetEntryByName(TemplateNameIndex const* index, std::string const& name, LocaleConstant locale) const
+{
+    std::string key = Utf8ToLowerKey(name);
+
+    ACE_READ_GUARD_RETURN(ACE_RW_Thread_Mutex, guard, m_templateNameIndexLock, 0);
+
+    if (locale != DEFAULT_LOCALE && locale < TOTAL_LOCALES)
+    {
+        TemplateNameIndex::const_iterator itr = index[locale].find(key);
+        if (itr != index[locale].end())
+            return itr->second;
+    }
+
+    TemplateNameIndex::const_iterator itr = index[DEFAULT_LOCALE].find(key);
+    return itr != index[DEFAULT_LOCALE].end() ? itr->second : 0;
+}
+
+void ObjectMgr::LoadItemNameIndex()
+{
+    uint32 oldMSTime = getMSTime();
+
+    TemplateNameIndex index[TOTAL_LOCALES];
+
+    for (uint32 entry = 1; entry < sItemStorage.MaxEntry; ++entry)
+    {
+        ItemPrototype const* proto = sItemStorage.LookupEntry<ItemPrototype>(entry);
+        if (!proto)
+            continue;
+
+        AddTemplateName(index[DEFAULT_LOCALE], proto->Name1, entry);
+
+        if (ItemLocale const* locale = GetItemLocale(entry))
+            for (uint8 i = 1; i < locale->Name.size(); ++i)
+                AddTemplateName(index[i], locale->Name[i].c_str(), entry);
+    }
+
+    SwapNameIndex(mItemNameIndex, index);
+
+    sLog->outString(">> Indexed %lu item names in %u ms", (unsigned long)mItemNameIndex[DEFAULT_LOCALE].size(), GetMSTimeDiffToNow(oldMSTime));
+    sLog->outString();
+}
+
+void ObjectMgr::LoadCreatureNameIndex()
+{
+    uint32 oldMSTime = getMSTime();
+
+    TemplateNameIndex index[TOTAL_LOCALES];
+
+    for (uint32 entry = 1; entry < sCreatureStorage.MaxEntry; ++entry)
+    {
+        CreatureInfo const* cInfo = sCreatureStorage.LookupEntry<CreatureInfo>(entry);
+        if (!cInfo)
+            continue;
+
+        AddTemplateName(index[DEFAULT_LOCALE], cInfo->Name, entry);
+
+        if (CreatureLocale const* locale = GetCreatureLocale(entry))
+            for (uint8 i = 1; i < locale->Name.size(); ++i)
+                AddTemplateName(index[i], locale->Name[i].c_str(), entry);
+    }
+
+    SwapNameIndex(mCreatureNameIndex, index);
+
+    sLog->outString(">> Indexed %lu creature names in %u ms", (unsigned long)mCreatureNameIndex[DEFAULT_LOCALE].size(), GetMSTimeDiffToNow(oldMSTime));
+    sLog->outString();
+}
+
 struct SQLItemLoader : public SQLStorageLoaderBase<SQLItemLoader>
 {
     template<class D>
@@ -7611,44 +7683,6 @@ void ObjectMgr::LoadNPCSpellClickSpells()
     sLog->outString();
 }
 
-void ObjectMgr::SaveCreatureRespawnTime(uint32 loguid, uint32 instance, time_t t)
-{
-    if (!t)
-    {
-        // Delete only
-        RemoveCreatureRespawnTime(loguid, instance);
-        return;
-    }
-    
-    // This function can be called from various map threads concurrently
-    {
-        m_CreatureRespawnTimesMtx.acquire();
-        mCreatureRespawnTimes[MAKE_PAIR64(loguid, instance)] = t;
-        m_CreatureRespawnTimesMtx.release();
-    }
-
-    PreparedStatement *stmt = CharacterDatabase.GetPreparedStatement(CHAR_ADD_CREATURE_RESPAWN_TIME);
-    stmt->setUInt32(0, loguid);
-    stmt->setUInt64(1, uint64(t));
-    stmt->setUInt32(2, instance);
-    CharacterDatabase.Execute(stmt);
-}
-
-void ObjectMgr::RemoveCreatureRespawnTime(uint32 loguid, uint32 instance)
-{
-    // This function can be called from various map threads concurrently
-    {
-        m_CreatureRespawnTimesMtx.acquire();
-        mCreatureRespawnTimes[MAKE_PAIR64(loguid, instance)] = 0;
-        m_CreatureRespawnTimesMtx.release();
-    }
-
-    PreparedStatement *stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CREATURE_RESPAWN_TIME);
-    stmt->setUInt32(0, loguid);
-    stmt->setUInt32(1, instance);
-    CharacterDatabase.Execute(stmt);
-}
-
 void ObjectMgr::DeleteCreatureData(uint32 guid)
 {
     // remove mapid*cellid -> guid_set map
@@ -7659,73 +7693,63 @@ void ObjectMgr::DeleteCreatureData(uint32 guid)
     mCreatureDataMap.erase(guid);
 }
 
-void ObjectMgr::SaveGORespawnTime(uint32 loguid, uint32 instance, time_t t)
+void ObjectMgr::TakeRespawnTimes(uint32 mapid, uint32 instance, MapRespawnTimes& creatureTimes, MapRespawnTimes& goTimes)
 {
-    if (!t)
+    // Called from map constructors, which can run on different map threads concurrently
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_StoredRespawnTimesMtx);
+
+    uint64 key = MAKE_PAIR64(mapid, instance);
+
+    StoredRespawnTimes::iterator itr = mStoredCreatureRespawnTimes.find(key);
+    if (itr != mStoredCreatureRespawnTimes.end())
     {
-        // Delete only
-        RemoveGORespawnTime(loguid, instance);
-        return;
+        creatureTimes.swap(itr->second);
+        mStoredCreatureRespawnTimes.erase(itr);
     }
-    
-    // This function can be called from different map threads concurrently
+
+    itr = mStoredGORespawnTimes.find(key);
+    if (itr != mStoredGORespawnTimes.end())
     {
-        m_GORespawnTimesMtx.acquire();
-        mGORespawnTimes[MAKE_PAIR64(loguid, instance)] = t;
-        m_GORespawnTimesMtx.release();
+        goTimes.swap(itr->second);
+        mStoredGORespawnTimes.erase(itr);
     }
-
-    PreparedStatement *stmt = CharacterDatabase.GetPreparedStatement(CHAR_ADD_GO_RESPAWN_TIME);
-    stmt->setUInt32(0, loguid);
-    stmt->setUInt64(1, uint64(t));
-    stmt->setUInt32(2, instance);
-    CharacterDatabase.Execute(stmt);
 }
 
-void ObjectMgr::RemoveGORespawnTime(uint32 loguid, uint32 instance)
+void ObjectMgr::StoreRespawnTimes(uint32 mapid, uint32 instance, MapRespawnTimes& creatureTimes, MapRespawnTimes& goTimes)
 {
-    // This function can be called from different map threads concurrently
-    {
-        m_GORespawnTimesMtx.acquire();
-        mGORespawnTimes[MAKE_PAIR64(loguid, instance)] = 0;
-        m_GORespawnTimesMtx.release();
-    }
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_StoredRespawnTimesMtx);
+
+    uint64 key = MAKE_PAIR64(mapid, instance);
 
-    PreparedStatement *stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_GO_RESPAWN_TIME);
-    stmt->setUInt32(0, loguid);
-    stmt->setUInt32(1, instance);
-    CharacterDatabase.Execute(stmt);
+    if (!creatureTimes.empty())
+        mStoredCreatureRespawnTimes[key].swap(creatureTimes);
+    if (!goTimes.empty())
+        mStoredGORespawnTimes[key].swap(goTimes);
 }
 
 void ObjectMgr::DeleteRespawnTimeForInstance(uint32 instance)
 {
-    // This function can be called from different map threads concurrently
-    RespawnTimes::iterator next;
-
+    // Loaded maps clear their own respawn times before calling this, only the stored ones are left
     {
-        m_GORespawnTimesMtx.acquire();
-        for (RespawnTimes::iterator itr = mGORespawnTimes.begin(); itr != mGORespawnTimes.end(); itr = next)
-        {
-            next = itr;
-            ++next;
+        ACE_GUARD(ACE_Thread_Mutex, guard, m_StoredRespawnTimesMtx);
 
-            if (GUID_HIPART(itr->first) == instance)
-                mGORespawnTimes.erase(itr);
-        }
-        m_GORespawnTimesMtx.release();
-    }
-    {
-        m_CreatureRespawnTimesMtx.acquire();
-        for (RespawnTimes::iterator itr = mCreatureRespawnTimes.begin(); itr != mCreatureRespawnTimes.end(); itr = next)
+        for (StoredRespawnTimes::iterator itr = mStoredCreatureRespawnTimes.begin(); itr != mStoredCreatureRespawnTimes.end();)
         {
-            next = itr;
-            ++next;
+            if (PAIR64_HIPART(itr->first) == instance)
+                mStoredCreatureRespawnTimes.erase(itr++);
+            else
+                ++itr;
+        }
 
-            if (GUID_HIPART(itr->first) == instance)
-                mCreatureRespawnTimes.erase(itr);
+        for (StoredRespawnTimes::iterator itr = mStoredGORespawnTimes.begin(); itr != mStoredGORespawnTimes.end();)
+        {
+            if (PAIR64_HIPART(itr->first) == instance)
+                mStoredGORespawnTimes.erase(itr++);
+            else
+                ++itr;
         }
-        m_CreatureRespawnTimesMtx.release();
     }
+
     CharacterDatabase.PExecute("DELETE FROM creature_respawn WHERE instance = '%u'", instance);
     CharacterDatabase.PExecute("DELETE FROM gameobject_respawn WHERE instance = '%u'", instance);
 }
@@ -7740,18 +7764,27 @@ void ObjectMgr::DeleteGOData(uint32 guid)
     mGameObjectDataMap.erase(guid);
 }
 
+void ObjectMgr::FreezeSpawnIndex()
+{
+    uint32 oldMSTime = getMSTime();
+
+    mSpawnIndex.Freeze();
+
+    sLog->outString(">> Indexed %u creature and %u gameobject spawns in %u ms", mSpawnIndex.GetFrozenSpawnCount(SPAWN_INDEX_CREATURE),
+        mSpawnIndex.GetFrozenSpawnCount(SPAWN_INDEX_GAMEOBJECT), GetMSTimeDiffToNow(oldMSTime));
+    sLog->outString();
+}
+
 void ObjectMgr::AddCorpseCellData(uint32 mapid, uint32 cellid, uint32 player_guid, uint32 instance)
 {
     // corpses are always added to spawn mode 0 and they are spawned by their instance id
-    CellObjectGuids& cell_guids = mMapObjectGuids[MAKE_PAIR32(mapid,0)][cellid];
-    cell_guids.corpses[player_guid] = instance;
+    mSpawnIndex.AddCorpse(MAKE_PAIR32(mapid,0), cellid, player_guid, instance);
 }
 
 void ObjectMgr::DeleteCorpseCellData(uint32 mapid, uint32 cellid, uint32 player_guid)
 {
     // corpses are always added to spawn mode 0 and they are spawned by their instance id
-    CellObjectGuids& cell_guids = mMapObjectGuids[MAKE_PAIR32(mapid,0)][cellid];
-    cell_guids.corpses.erase(player_guid);
+    mSpawnIndex.RemoveCorpse(MAKE_PAIR32(mapid,0), cellid, player_guid);
 }
 
 void ObjectMgr::LoadQuestRelationsHelper(QuestRelations& map, std::string table, bool starter, bool go)
@@ -9057,6 +9090,13 @@ void ObjectMgr::LoadScriptNames()
     while (result->NextRow());
 
     std::sort(m_scriptNames.begin(), m_scriptNames.end());
+
+    // template snapshots store script ids, they are only valid for the same script name list
+    uint64 hash = FINGERPRINT_SEED;
+    for (ScriptNameMap::const_iterator itr = m_scriptNames.begin(); itr != m_scriptNames.end(); ++itr)
+        hash = HashBytes(hash, itr->c_str(), itr->size() + 1);
+    SQLStorage::SetSnapshotSalt(uint32(hash ^ (hash >> 32)));
+
     sLog->outString(">> Loaded %d Script Names in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
     sLog->outString();
 }
@@ -36,12 +36,14 @@
 #include "ObjectAccessor.h"
 #include "ObjectDefines.h"
 #include <ace/Singleton.h>
+#include <ace/RW_Thread_Mutex.h>
 #include "SQLStorage.h"
 #include "Vehicle.h"
 #include <string>
 #include <map>
 #include <limits>
 #include "ConditionMgr.h"
+#include "SpawnIndex.h"
 
 extern SQLStorage sCreatureStorage;
 extern SQLStorage sCreatureDataAddonStorage;
@@ -350,18 +352,7 @@ struct AreaTrigger
     float  target_Orientation;
 };
 
-typedef std::set<uint32> CellGuidSet;
-typedef std::map<uint32/*player guid*/,uint32/*instance*/> CellCorpseSet;
-struct CellObjectGuids
-{
-    CellGuidSet creatures;
-    CellGuidSet gameobjects;
-    CellCorpseSet corpses;
-};
-typedef UNORDERED_MAP<uint32/*cell_id*/,CellObjectGuids> CellObjectGuidsMap;
-typedef UNORDERED_MAP<uint32/*(mapid,spawnMode) pair*/,CellObjectGuidsMap> MapObjectGuids;
-
-typedef UNORDERED_MAP<uint64/*(instance,guid) pair*/,time_t> RespawnTimes;
+typedef UNORDERED_MAP<uint64/*(mapid,instance) pair*/,MapRespawnTimes> StoredRespawnTimes;
 
 // Trinity string ranges
 #define MIN_TRINITY_STRING_ID           1                    // 'trinity_string'
@@ -385,6 +376,7 @@ typedef UNORDERED_MAP<uint32,GameObjectData> GameObjectDataMap;
 typedef UNORDERED_MAP<uint32,CreatureLocale> CreatureLocaleMap;
 typedef UNORDERED_MAP<uint32,GameObjectLocale> GameObjectLocaleMap;
 typedef UNORDERED_MAP<uint32,ItemLocale> ItemLocaleMap;
+typedef UNORDERED_MAP<std::string/*lower case name*/,uint32/*entry*/> TemplateNameIndex;
 typedef UNORDERED_MAP<uint32,ItemSetNameLocale> ItemSetNameLocaleMap;
 typedef UNORDERED_MAP<uint32,QuestLocale> QuestLocaleMap;
 typedef UNORDERED_MAP<uint32,NpcTextLocale> NpcTextLocaleMap;
@@ -642,6 +634,17 @@ class ObjectMgr
 
         static ItemPrototype const* GetItemPrototype(uint32 id) { return sItemStorage.LookupEntry<ItemPrototype>(id); }
 
+        // Case insensitive lookup of a template by its name in the given locale, falls back to the default names.
+        // Returns the lowest entry carrying that name or 0.
+        uint32 GetItemEntryByName(std::string const& name, LocaleConstant locale = DEFAULT_LOCALE) const
+        {
+            return GetEntryByName(mItemNameIndex, name, locale);
+        }
+        uint32 GetCreatureEntryByName(std::string const& name, LocaleConstant locale = DEFAULT_LOCALE) const
+        {
+            return GetEntryByName(mCreatureNameIndex, name, locale);
+        }
+
         ItemSetNameEntry const* GetItemSetNameEntry(uint32 itemId)
         {
             ItemSetNameMap::iterator itr = mItemSetNameMap.find(itemId);
@@ -876,6 +879,8 @@ class ObjectMgr
         void LoadGameobjectRespawnTimes();
         void LoadItemPrototypes();
         void LoadItemLocales();
+        void LoadItemNameIndex();                           // must be after LoadItemPrototypes() and LoadItemLocales()
+        void LoadCreatureNameIndex();                       // must be after LoadCreatureTemplates() and LoadCreatureLocales()
         void LoadItemSetNames();
         void LoadItemSetNameLocales();
         void LoadQuestLocales();
@@ -966,10 +971,16 @@ class ObjectMgr
             return NULL;
         }
 
-        CellObjectGuids const& GetCellObjectGuids(uint16 mapid, uint8 spawnMode, uint32 cell_id)
+        void GetCellObjectGuids(SpawnIndexType type, uint16 mapid, uint8 spawnMode, uint32 cell_id, CellGuidList& guids) const
         {
-            return mMapObjectGuids[MAKE_PAIR32(mapid,spawnMode)][cell_id];
+            mSpawnIndex.GetCellGuids(type, MAKE_PAIR32(mapid,spawnMode), cell_id, guids);
         }
+        void GetCellCorpses(uint16 mapid, uint32 cell_id, CellCorpseSet& corpses) const
+        {
+            // corpses are always added to spawn mode 0 and they are spawned by their instance id
+            mSpawnIndex.GetCellCorpses(MAKE_PAIR32(mapid,0), cell_id, corpses);
+        }
+        void FreezeSpawnIndex();
 
         CreatureData const* GetCreatureData(uint32 guid) const
         {
@@ -1072,34 +1083,9 @@ class ObjectMgr
         void AddCorpseCellData(uint32 mapid, uint32 cellid, uint32 player_guid, uint32 instance);
         void DeleteCorpseCellData(uint32 mapid, uint32 cellid, uint32 player_guid);
 
-        time_t GetLinkedRespawnTime(uint64 guid, uint32 instance)
-        {
-            uint64 linkedGuid = GetLinkedRespawnGuid(guid);
-            switch (GUID_HIPART(linkedGuid))
-            {
-                case HIGHGUID_UNIT:
-                    return GetCreatureRespawnTime(GUID_LOPART(linkedGuid), instance);
-                case HIGHGUID_GAMEOBJECT:
-                    return GetGORespawnTime(GUID_LOPART(linkedGuid), instance);
-                default:
-                    return 0;
-             }
-        }
-
-        time_t GetCreatureRespawnTime(uint32 loguid, uint32 instance)
-        {
-            ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_CreatureRespawnTimesMtx, 0);
-            return mCreatureRespawnTimes[MAKE_PAIR64(loguid,instance)];
-        }
-        void SaveCreatureRespawnTime(uint32 loguid, uint32 instance, time_t t);
-        void RemoveCreatureRespawnTime(uint32 loguid, uint32 instance);
-        time_t GetGORespawnTime(uint32 loguid, uint32 instance)
-        {
-            ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_GORespawnTimesMtx, 0);
-            return mGORespawnTimes[MAKE_PAIR64(loguid,instance)];
-        }
-        void SaveGORespawnTime(uint32 loguid, uint32 instance, time_t t);
-        void RemoveGORespawnTime(uint32 loguid, uint32 instance);
+        // respawn times are owned by the map while it exists, these only keep them for maps not created yet
+        void TakeRespawnTimes(uint32 mapid, uint32 instance, MapRespawnTimes& creatureTimes, MapRespawnTimes& goTimes);
+        void StoreRespawnTimes(uint32 mapid, uint32 instance, MapRespawnTimes& creatureTimes, MapRespawnTimes& goTimes);
         void DeleteRespawnTimeForInstance(uint32 instance);
 
         // grid objects
@@ -1300,6 +1286,8 @@ class ObjectMgr
         void ConvertCreatureAddonAuras(CreatureDataAddon* addon, char const* table, char const* guidEntryStr);
         void LoadQuestRelationsHelper(QuestRelations& map, std::string table, bool starter, bool go);
         void PlayerCreateInfoAddItemHelper(uint32 race_, uint32 class_, uint32 itemId, int32 count);
+        uint32 GetEntryByName(TemplateNameIndex const* index, std::string const& name, LocaleConstant locale) const;
+        void SwapNameIndex(TemplateNameIndex* index, TemplateNameIndex* newIndex);
 
         MailLevelRewardMap m_mailLevelRewardMap;
 
@@ -1330,13 +1318,17 @@ class ObjectMgr
         typedef UNORDERED_MAP<uint32, ItemSetNameEntry> ItemSetNameMap;
         ItemSetNameMap mItemSetNameMap;
 
-        MapObjectGuids mMapObjectGuids;
+        SpawnIndex mSpawnIndex;
         CreatureDataMap mCreatureDataMap;
         LinkedRespawnMap mLinkedRespawnMap;
         CreatureLocaleMap mCreatureLocaleMap;
         GameObjectDataMap mGameObjectDataMap;
         GameObjectLocaleMap mGameObjectLocaleMap;
         ItemLocaleMap mItemLocaleMap;
+        // indexed by locale, rebuilt as a whole on template and locale reloads while scripts may be reading
+        TemplateNameIndex mItemNameIndex[TOTAL_LOCALES];
+        TemplateNameIndex mCreatureNameIndex[TOTAL_LOCALES];
+        mutable ACE_RW_Thread_Mutex m_templateNameIndexLock;
         ItemSetNameLocaleMap mItemSetNameLocaleMap;
         QuestLocaleMap mQuestLocaleMap;
         NpcTextLocaleMap mNpcTextLocaleMap;
@@ -1344,10 +1336,9 @@ class ObjectMgr
         TrinityStringLocaleMap mTrinityStringLocaleMap;
         GossipMenuItemsLocaleMap mGossipMenuItemsLocaleMap;
         PointOfInterestLocaleMap mPointOfInterestLocaleMap;
-        RespawnTimes mCreatureRespawnTimes;
-        ACE_Thread_Mutex m_CreatureRespawnTimesMtx;
-        RespawnTimes mGORespawnTimes;
-        ACE_Thread_Mutex m_GORespawnTimesMtx;
+        StoredRespawnTimes mStoredCreatureRespawnTimes;
+        StoredRespawnTimes mStoredGORespawnTimes;
+        ACE_Thread_Mutex m_StoredRespawnTimesMtx;
 
         CacheNpcTextIdMap m_mCacheNpcTextIdMap;
         CacheVendorItemMap m_mCacheVendorItemMap;
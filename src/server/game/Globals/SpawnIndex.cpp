@@ -0,0 +1,251 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SpawnIndex.h"
+#include "Errors.h"
+#include <ace/Guard_T.h>
+#include <algorithm>
+
+bool SpawnIndex::CellSpawnOverlay::IsEmpty() const
+{
+    for (uint8 i = 0; i < MAX_SPAWN_INDEX_TYPE; ++i)
+        if (!added[i].empty() || !removed[i].empty())
+            return false;
+
+    return corpses.empty();
+}
+
+bool SpawnIndex::GetFrozenRange(SpawnIndexType type, uint32 mapKey, uint32 cellId, uint32 const*& begin, uint32 const*& end) const
+{
+    FrozenMapTable::const_iterator itr = m_frozenTables[type].find(mapKey);
+    if (itr == m_frozenTables[type].end())
+        return false;
+
+    FrozenCellTable const& table = itr->second;
+    std::vector<uint32>::const_iterator cell = std::lower_bound(table.cells.begin(), table.cells.end(), cellId);
+    if (cell == table.cells.end() || *cell != cellId)
+        return false;
+
+    size_t idx = cell - table.cells.begin();
+    begin = &table.guids[0] + table.offsets[idx];
+    end = &table.guids[0] + table.offsets[idx + 1];
+    return true;
+}
+
+bool SpawnIndex::IsFrozenInCell(SpawnIndexType type, uint32 mapKey, uint32 cellId, uint32 guid) const
+{
+    uint32 const* begin;
+    uint32 const* end;
+    if (!GetFrozenRange(type, mapKey, cellId, begin, end))
+        return false;
+
+    return std::binary_search(begin, end, guid);
+}
+
+void SpawnIndex::EraseOverlayIfEmpty(uint32 mapKey, uint32 cellId)
+{
+    MapOverlayMap::iterator mapItr = m_overlay.find(mapKey);
+    if (mapItr == m_overlay.end())
+        return;
+
+    CellOverlayMap::iterator cellItr = mapItr->second.find(cellId);
+    if (cellItr != mapItr->second.end() && cellItr->second.IsEmpty())
+        mapItr->second.erase(cellItr);
+
+    if (mapItr->second.empty())
+        m_overlay.erase(mapItr);
+}
+
+void SpawnIndex::AddSpawn(SpawnIndexType type, uint32 mapKey, uint32 cellId, uint32 guid)
+{
+    ACE_WRITE_GUARD(ACE_RW_Thread_Mutex, guard, m_overlayLock);
+
+    CellSpawnOverlay& overlay = m_overlay[mapKey][cellId];
+
+    // a frozen spawn that was despawned earlier (pools, game events) is simply made visible again
+    if (overlay.removed[type].erase(guid))
+    {
+        EraseOverlayIfEmpty(mapKey, cellId);
+        return;
+    }
+
+    if (!IsFrozenInCell(type, mapKey, cellId, guid))
+        overlay.added[type].insert(guid);
+    else
+        EraseOverlayIfEmpty(mapKey, cellId);
+}
+
+void SpawnIndex::RemoveSpawn(SpawnIndexType type, uint32 mapKey, uint32 cellId, uint32 guid)
+{
+    ACE_WRITE_GUARD(ACE_RW_Thread_Mutex, guard, m_overlayLock);
+
+    CellSpawnOverlay& overlay = m_overlay[mapKey][cellId];
+
+    if (!overlay.added[type].erase(guid) && IsFrozenInCell(type, mapKey, cellId, guid))
+        overlay.removed[type].insert(guid);
+
+    EraseOverlayIfEmpty(mapKey, cellId);
+}
+
+void SpawnIndex::AddCorpse(uint32 mapKey, uint32 cellId, uint32 playerGuid, uint32 instance)
+{
+    ACE_WRITE_GUARD(ACE_RW_Thread_Mutex, guard, m_overlayLock);
+
+    m_overlay[mapKey][cellId].corpses[playerGuid] = instance;
+}
+
+void SpawnIndex::RemoveCorpse(uint32 mapKey, uint32 cellId, uint32 playerGuid)
+{
+    ACE_WRITE_GUARD(ACE_RW_Thread_Mutex, guard, m_overlayLock);
+
+    MapOverlayMap::iterator mapItr = m_overlay.find(mapKey);
+    if (mapItr == m_overlay.end())
+        return;
+
+    CellOverlayMap::iterator cellItr = mapItr->second.find(cellId);
+    if (cellItr == mapItr->second.end())
+        return;
+
+    cellItr->second.corpses.erase(playerGuid);
+    EraseOverlayIfEmpty(mapKey, cellId);
+}
+
+void SpawnIndex::GetCellGuids(SpawnIndexType type, uint32 mapKey, uint32 cellId, CellGuidList& guids) const
+{
+    uint32 const* begin = NULL;
+    uint32 const* end = NULL;
+    bool hasFrozen = GetFrozenRange(type, mapKey, cellId, begin, end);
+
+    ACE_READ_GUARD(ACE_RW_Thread_Mutex, guard, m_overlayLock);
+
+    CellSpawnOverlay const* overlay = NULL;
+    MapOverlayMap::const_iterator mapItr = m_overlay.find(mapKey);
+    if (mapItr != m_overlay.end())
+    {
+        CellOverlayMap::const_iterator cellItr = mapItr->second.find(cellId);
+        if (cellItr != mapItr->second.end())
+            overlay = &cellItr->second;
+    }
+
+    if (!overlay)
+    {
+        if (hasFrozen)
+            guids.insert(guids.end(), begin, end);
+        return;
+    }
+
+    if (hasFrozen)
+    {
+        CellGuidSet const& removed = overlay->removed[type];
+        if (removed.empty())
+            guids.insert(guids.end(), begin, end);
+        else
+        {
+            for (uint32 const* itr = begin; itr != end; ++itr)
+                if (removed.find(*itr) == removed.end())
+                    guids.push_back(*itr);
+        }
+    }
+
+    guids.insert(guids.end(), overlay->added[type].begin(), overlay->added[type].end());
+}
+
+void SpawnIndex::GetCellCorpses(uint32 mapKey, uint32 cellId, CellCorpseSet& corpses) const
+{
+    ACE_READ_GUARD(ACE_RW_Thread_Mutex, guard, m_overlayLock);
+
+    MapOverlayMap::const_iterator mapItr = m_overlay.find(mapKey);
+    if (mapItr == m_overlay.end())
+        return;
+
+    CellOverlayMap::const_iterator cellItr = mapItr->second.find(cellId);
+    if (cellItr == mapItr->second.end())
+        return;
+
+    corpses.insert(cellItr->second.corpses.begin(), cellItr->second.corpses.end());
+}
+
+void SpawnIndex::Freeze()
+{
+    ACE_WRITE_GUARD(ACE_RW_Thread_Mutex, guard, m_overlayLock);
+
+    ASSERT(!m_frozen);
+
+    for (MapOverlayMap::iterator mapItr = m_overlay.begin(); mapItr != m_overlay.end(); ++mapItr)
+    {
+        std::vector<uint32> cellIds;
+        cellIds.reserve(mapItr->second.size());
+        for (CellOverlayMap::const_iterator cellItr = mapItr->second.begin(); cellItr != mapItr->second.end(); ++cellItr)
+            cellIds.push_back(cellItr->first);
+        std::sort(cellIds.begin(), cellIds.end());
+
+        for (uint8 type = 0; type < MAX_SPAWN_INDEX_TYPE; ++type)
+        {
+            FrozenCellTable table;
+            for (std::vector<uint32>::const_iterator itr = cellIds.begin(); itr != cellIds.end(); ++itr)
+            {
+                CellGuidSet& added = mapItr->second[*itr].added[type];
+                if (added.empty())
+                    continue;
+
+                table.cells.push_back(*itr);
+                table.offsets.push_back(table.guids.size());
+                table.guids.insert(table.guids.end(), added.begin(), added.end());
+                added.clear();
+            }
+
+            if (table.cells.empty())
+                continue;
+
+            table.offsets.push_back(table.guids.size());
+
+            // shrink to exact size, these tables live for the whole server lifetime
+            FrozenCellTable& frozen = m_frozenTables[type][mapItr->first];
+            std::vector<uint32>(table.cells).swap(frozen.cells);
+            std::vector<uint32>(table.offsets).swap(frozen.offsets);
+            std::vector<uint32>(table.guids).swap(frozen.guids);
+        }
+    }
+
+    // only corpses can be left in the overlay at this point
+    for (MapOverlayMap::iterator mapItr = m_overlay.begin(); mapItr != m_overlay.end();)
+    {
+        for (CellOverlayMap::iterator cellItr = mapItr->second.begin(); cellItr != mapItr->second.end();)
+        {
+            if (cellItr->second.IsEmpty())
+                mapItr->second.erase(cellItr++);
+            else
+                ++cellItr;
+        }
+
+        if (mapItr->second.empty())
+            m_overlay.erase(mapItr++);
+        else
+            ++mapItr;
+    }
+
+    m_frozen = true;
+}
+
+uint32 SpawnIndex::GetFrozenSpawnCount(SpawnIndexType type) const
+{
+    uint32 count = 0;
+    for (FrozenMapTable::const_iterator itr = m_frozenTables[type].begin(); itr != m_frozenTables[type].end(); ++itr)
+        count += itr->second.guids.size();
+
+    return count;
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_SPAWNINDEX_H
+#define TRINITY_SPAWNINDEX_H
+
+#include "Define.h"
+#include "UnorderedMap.h"
+#include <ace/RW_Thread_Mutex.h>
+#include <set>
+#include <map>
+#include <vector>
+
+enum SpawnIndexType
+{
+    SPAWN_INDEX_CREATURE    = 0,
+    SPAWN_INDEX_GAMEOBJECT  = 1,
+    MAX_SPAWN_INDEX_TYPE
+};
+
+typedef std::set<uint32> CellGuidSet;
+typedef std::vector<uint32> CellGuidList;
+typedef std::map<uint32/*player guid*/,uint32/*instance*/> CellCorpseSet;
+
+/*
+ * Per-cell index of creature and gameobject spawn guids.
+ *
+ * Spawns loaded from the world database at startup are frozen into one
+ * compact table per (mapid,spawnMode) pair: a sorted array of occupied cell
+ * ids with offsets into a single sorted array of guids. Once frozen this part
+ * is never modified again and is read by all map threads without locking.
+ *
+ * Everything that changes at runtime (GM added/moved/deleted spawns, game event
+ * and pool spawns, corpses) goes to a small overlay guarded by a RW lock. The
+ * overlay records added guids and hides frozen guids that were removed.
+ */
+class SpawnIndex
+{
+    public:
+        SpawnIndex() : m_frozen(false) {}
+
+        void AddSpawn(SpawnIndexType type, uint32 mapKey, uint32 cellId, uint32 guid);
+        void RemoveSpawn(SpawnIndexType type, uint32 mapKey, uint32 cellId, uint32 guid);
+
+        void AddCorpse(uint32 mapKey, uint32 cellId, uint32 playerGuid, uint32 instance);
+        void RemoveCorpse(uint32 mapKey, uint32 cellId, uint32 playerGuid);
+
+        // Appends all spawn guids of the given type currently placed in the cell
+        void GetCellGuids(SpawnIndexType type, uint32 mapKey, uint32 cellId, CellGuidList& guids) const;
+        void GetCellCorpses(uint32 mapKey, uint32 cellId, CellCorpseSet& corpses) const;
+
+        // Moves everything added so far into the immutable tables, must be called once before maps are created
+        void Freeze();
+        bool IsFrozen() const { return m_frozen; }
+
+        uint32 GetFrozenSpawnCount(SpawnIndexType type) const;
+
+    private:
+        struct FrozenCellTable
+        {
+            std::vector<uint32> cells;                      // sorted ids of cells that have at least one spawn
+            std::vector<uint32> offsets;                    // cells.size() + 1 entries, cell i owns guids[offsets[i], offsets[i+1])
+            std::vector<uint32> guids;                      // sorted per cell
+        };
+        typedef UNORDERED_MAP<uint32/*(mapid,spawnMode) pair*/, FrozenCellTable> FrozenMapTable;
+
+        struct CellSpawnOverlay
+        {
+            CellGuidSet added[MAX_SPAWN_INDEX_TYPE];
+            CellGuidSet removed[MAX_SPAWN_INDEX_TYPE];      // frozen guids that are no longer spawned in this cell
+            CellCorpseSet corpses;
+
+            bool IsEmpty() const;
+        };
+        typedef UNORDERED_MAP<uint32/*cell_id*/, CellSpawnOverlay> CellOverlayMap;
+        typedef UNORDERED_MAP<uint32/*(mapid,spawnMode) pair*/, CellOverlayMap> MapOverlayMap;
+
+        bool GetFrozenRange(SpawnIndexType type, uint32 mapKey, uint32 cellId, uint32 const*& begin, uint32 const*& end) const;
+        bool IsFrozenInCell(SpawnIndexType type, uint32 mapKey, uint32 cellId, uint32 guid) const;
+        void EraseOverlayIfEmpty(uint32 mapKey, uint32 cellId);
+
+        bool m_frozen;
+        FrozenMapTable m_frozenTables[MAX_SPAWN_INDEX_TYPE];
+
+        MapOverlayMap m_overlay;
+        mutable ACE_RW_Thread_Mutex m_overlayLock;
+};
+
+#endif
@@ -0,0 +1,236 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "WhoListCache.h"
+#include "Player.h"
+#include "ObjectMgr.h"
+#include "DBCStores.h"
+#include "Util.h"
+#include <ace/Guard_T.h>
+
+static std::wstring ToLowerWide(std::string const& str)
+{
+    std::wstring wstr;
+    if (!Utf8toWStr(str, wstr))
+        return std::wstring();
+
+    wstrToLower(wstr);
+    return wstr;
+}
+
+WhoListPlayerInfo* WhoListCache::_GetPlayer(uint32 guidLow)
+{
+    PlayerIndex::const_iterator itr = m_index.find(guidLow);
+    return itr != m_index.end() ? &m_players[itr->second] : NULL;
+}
+
+void WhoListCache::AddPlayer(Player* player)
+{
+    WhoListPlayerInfo info;
+    info.guid           = player->GetGUIDLow();
+    info.team           = player->GetTeam();
+    info.security       = player->GetSession()->GetSecurity();
+    info.visible        = player->IsVisible();
+    info.level          = player->getLevel();
+    info.playerClass    = player->getClass();
+    info.race           = player->getRace();
+    info.gender         = player->getGender();
+    info.zoneId         = player->GetZoneId();
+    info.guildId        = player->GetGuildId();
+    info.name           = player->GetName();
+    info.guildName      = sObjectMgr->GetGuildNameById(info.guildId);
+    info.lowerName      = ToLowerWide(info.name);
+    info.lowerGuildName = ToLowerWide(info.guildName);
+
+    ACE_WRITE_GUARD(ACE_RW_Thread_Mutex, guard, m_lock);
+
+    if (WhoListPlayerInfo* existing = _GetPlayer(info.guid))
+    {
+        *existing = info;
+        return;
+    }
+
+    m_index[info.guid] = m_players.size();
+    m_players.push_back(info);
+}
+
+void WhoListCache::RemovePlayer(uint32 guidLow)
+{
+    ACE_WRITE_GUARD(ACE_RW_Thread_Mutex, guard, m_lock);
+
+    PlayerIndex::iterator itr = m_index.find(guidLow);
+    if (itr == m_index.end())
+        return;
+
+    // keep the list dense, the last player takes the freed slot
+    uint32 slot = itr->second;
+    m_index.erase(itr);
+    if (slot != m_players.size() - 1)
+    {
+        m_players[slot] = m_players.back();
+        m_index[m_players[slot].guid] = slot;
+    }
+    m_players.pop_back();
+}
+
+void WhoListCache::UpdateLevel(uint32 guidLow, uint8 level)
+{
+    ACE_WRITE_GUARD(ACE_RW_Thread_Mutex, guard, m_lock);
+
+    if (WhoListPlayerInfo* info = _GetPlayer(guidLow))
+        info->level = level;
+}
+
+void WhoListCache::UpdateZone(uint32 guidLow, uint32 zoneId)
+{
+    ACE_WRITE_GUARD(ACE_RW_Thread_Mutex, guard, m_lock);
+
+    if (WhoListPlayerInfo* info = _GetPlayer(guidLow))
+        info->zoneId = zoneId;
+}
+
+void WhoListCache::UpdateGuild(uint32 guidLow, uint32 guildId, std::string const& guildName)
+{
+    std::wstring lowerGuildName = ToLowerWide(guildName);
+
+    ACE_WRITE_GUARD(ACE_RW_Thread_Mutex, guard, m_lock);
+
+    if (WhoListPlayerInfo* info = _GetPlayer(guidLow))
+    {
+        info->guildId = guildId;
+        info->guildName = guildName;
+        info->lowerGuildName = lowerGuildName;
+    }
+}
+
+void WhoListCache::UpdateVisibility(uint32 guidLow, bool visible)
+{
+    ACE_WRITE_GUARD(ACE_RW_Thread_Mutex, guard, m_lock);
+
+    if (WhoListPlayerInfo* info = _GetPlayer(guidLow))
+        info->visible = visible;
+}
+
+uint32 WhoListCache::Search(WhoListQuery const& query, WhoListResults& results, uint32 maxResults) const
+{
+    uint32 matchCount = 0;
+
+    // zone names are only converted once per request and zone
+    typedef UNORDERED_MAP<uint32, bool> ZoneMatchMap;
+    ZoneMatchMap zoneMatches;
+
+    ACE_READ_GUARD_RETURN(ACE_RW_Thread_Mutex, guard, m_lock, 0);
+
+    for (PlayerList::const_iterator itr = m_players.begin(); itr != m_players.end(); ++itr)
+    {
+        WhoListPlayerInfo const& info = *itr;
+
+        if (query.viewerSecurity == SEC_PLAYER)
+        {
+            // player can see member of other team only if CONFIG_ALLOW_TWO_SIDE_WHO_LIST
+            if (info.team != query.viewerTeam && !query.allowTwoSide)
+                continue;
+
+            // player can see MODERATOR, GAME MASTER, ADMINISTRATOR only if CONFIG_GM_IN_WHO_LIST
+            if (info.security > query.gmLevelInWhoList)
+                continue;
+        }
+
+        // same rules as Player::IsVisibleGloballyFor
+        if (info.guid != query.viewerGuid && !info.visible)
+            if (query.viewerSecurity == SEC_PLAYER || info.security > query.viewerSecurity)
+                continue;
+
+        if (info.level < query.levelMin || info.level > query.levelMax)
+            continue;
+
+        if (!(query.classMask & (1 << info.playerClass)))
+            continue;
+
+        if (!(query.raceMask & (1 << info.race)))
+            continue;
+
+        if (query.zonesCount)
+        {
+            bool zoneShow = false;
+            for (uint32 i = 0; i < query.zonesCount; ++i)
+            {
+                if (query.zones[i] == info.zoneId)
+                {
+                    zoneShow = true;
+                    break;
+                }
+            }
+
+            if (!zoneShow)
+                continue;
+        }
+
+        if (!query.playerName.empty() && info.lowerName.find(query.playerName) == std::wstring::npos)
+            continue;
+
+        if (!query.guildName.empty() && info.lowerGuildName.find(query.guildName) == std::wstring::npos)
+            continue;
+
+        if (query.stringsCount)
+        {
+            bool stringShow = true;
+            for (uint32 i = 0; i < query.stringsCount; ++i)
+            {
+                std::wstring const& str = query.strings[i];
+                if (str.empty())
+                    continue;
+
+                if (info.lowerGuildName.find(str) != std::wstring::npos || info.lowerName.find(str) != std::wstring::npos)
+                {
+                    stringShow = true;
+                    break;
+                }
+
+                ZoneMatchMap::const_iterator zoneItr = zoneMatches.find(info.zoneId * MAX_WHO_LIST_STRINGS + i);
+                bool zoneMatch;
+                if (zoneItr != zoneMatches.end())
+                    zoneMatch = zoneItr->second;
+                else
+                {
+                    std::string areaName;
+                    if (AreaTableEntry const* areaEntry = GetAreaEntryByAreaID(info.zoneId))
+                        areaName = areaEntry->area_name[query.locale];
+
+                    zoneMatch = Utf8FitTo(areaName, str);
+                    zoneMatches[info.zoneId * MAX_WHO_LIST_STRINGS + i] = zoneMatch;
+                }
+
+                if (zoneMatch)
+                {
+                    stringShow = true;
+                    break;
+                }
+
+                stringShow = false;
+            }
+
+            if (!stringShow)
+                continue;
+        }
+
+        if ((matchCount++) < maxResults)
+            results.push_back(info);
+    }
+
+    return matchCount;
+}
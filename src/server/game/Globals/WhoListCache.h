@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_WHOLISTCACHE_H
+#define TRINITY_WHOLISTCACHE_H
+
+#include "Define.h"
+#include "UnorderedMap.h"
+#include <ace/Singleton.h>
+#include <ace/RW_Thread_Mutex.h>
+#include <string>
+#include <vector>
+
+class Player;
+
+#define MAX_WHO_LIST_ZONES   10                             // client limit
+#define MAX_WHO_LIST_STRINGS 4                              // client limit
+
+struct WhoListPlayerInfo
+{
+    WhoListPlayerInfo() : guid(0), team(0), security(0), visible(true), level(0), playerClass(0), race(0), gender(0), zoneId(0), guildId(0) {}
+
+    uint32 guid;
+    uint32 team;
+    uint32 security;
+    bool visible;                                           // false while GM invisible
+    uint8 level;
+    uint8 playerClass;
+    uint8 race;
+    uint8 gender;
+    uint32 zoneId;
+    uint32 guildId;
+    std::string name;
+    std::string guildName;
+    std::wstring lowerName;                                 // lowercase copies for /who matching
+    std::wstring lowerGuildName;
+};
+
+// Search criteria of one CMSG_WHO, strings already converted to lowercase
+struct WhoListQuery
+{
+    WhoListQuery() : levelMin(0), levelMax(0), raceMask(0), classMask(0), zonesCount(0), stringsCount(0),
+        viewerGuid(0), viewerTeam(0), viewerSecurity(0), allowTwoSide(false), gmLevelInWhoList(0), locale(0) {}
+
+    uint32 levelMin;
+    uint32 levelMax;
+    uint32 raceMask;
+    uint32 classMask;
+    uint32 zonesCount;
+    uint32 zones[MAX_WHO_LIST_ZONES];
+    uint32 stringsCount;
+    std::wstring strings[MAX_WHO_LIST_STRINGS];
+    std::wstring playerName;
+    std::wstring guildName;
+
+    uint32 viewerGuid;
+    uint32 viewerTeam;
+    uint32 viewerSecurity;
+    bool allowTwoSide;
+    uint32 gmLevelInWhoList;
+    uint8 locale;                                           // DBC locale for zone name matching
+};
+
+typedef std::vector<WhoListPlayerInfo> WhoListResults;
+
+/*
+ * Searchable copy of the /who relevant data of all players in world.
+ *
+ * Players are added and removed together with the world and the few fields
+ * that can change while online (level, zone, guild, GM visibility) are pushed
+ * by the code that changes them. Names are stored lowercase once instead of
+ * being converted for every player on every request, and searches only take
+ * this cache's read lock, not the global player registry lock.
+ */
+class WhoListCache
+{
+    friend class ACE_Singleton<WhoListCache, ACE_Null_Mutex>;
+    WhoListCache() {}
+
+    public:
+        void AddPlayer(Player* player);
+        void RemovePlayer(uint32 guidLow);
+
+        void UpdateLevel(uint32 guidLow, uint8 level);
+        void UpdateZone(uint32 guidLow, uint32 zoneId);
+        // the guild name is passed in as a new guild is not registered in ObjectMgr yet when its founder joins
+        void UpdateGuild(uint32 guidLow, uint32 guildId, std::string const& guildName);
+        void UpdateVisibility(uint32 guidLow, bool visible);
+
+        // Copies at most maxResults matching players into results, returns the total number of matches
+        uint32 Search(WhoListQuery const& query, WhoListResults& results, uint32 maxResults) const;
+
+    private:
+        typedef std::vector<WhoListPlayerInfo> PlayerList;
+        typedef UNORDERED_MAP<uint32, uint32/*index in m_players*/> PlayerIndex;
+
+        WhoListPlayerInfo* _GetPlayer(uint32 guidLow);
+
+        PlayerList m_players;
+        PlayerIndex m_index;
+        mutable ACE_RW_Thread_Mutex m_lock;
+};
+
+#define sWhoListCache ACE_Singleton<WhoListCache, ACE_Null_Mutex>::instance()
+
+#endif
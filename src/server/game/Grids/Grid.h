@@ -60,12 +60,15 @@ class Grid
         {
             if(!i_objects.template insert<SPECIFIC_OBJECT>(obj))
                 ASSERT(false);
+            obj->GetGridRef().getTarget()->GetPositionIndex().Insert(obj);
         }
 
         /** an object of interested exits the grid
          */
         template<class SPECIFIC_OBJECT> void RemoveWorldObject(SPECIFIC_OBJECT *obj)
         {
+            if(obj->GetGridRef().isValid())
+                obj->GetGridRef().getTarget()->GetPositionIndex().Remove(obj);
             if(!i_objects.template remove<SPECIFIC_OBJECT>(obj))
                 ASSERT(false);
         }
@@ -106,12 +109,15 @@ class Grid
         {
             if(!i_container.template insert<SPECIFIC_OBJECT>(obj))
                 ASSERT(false);
+            obj->GetGridRef().getTarget()->GetPositionIndex().Insert(obj);
         }
 
         /** Removes a containter type object from the grid
          */
         template<class SPECIFIC_OBJECT> void RemoveGridObject(SPECIFIC_OBJECT *obj)
         {
+            if(obj->GetGridRef().isValid())
+                obj->GetGridRef().getTarget()->GetPositionIndex().Remove(obj);
             if(!i_container.template remove<SPECIFIC_OBJECT>(obj))
                 ASSERT(false);
         }
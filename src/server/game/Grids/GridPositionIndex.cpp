@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GridPositionIndex.h"
+#include "Object.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GRID_POSITION_INDEX_SSE2
+#include <emmintrin.h>
+#endif
+
+GridPositionIndex::~GridPositionIndex()
+{
+    // objects still linked to a destroyed manager must not keep a dangling index
+    for (std::vector<WorldObject*>::const_iterator itr = i_objects.begin(); itr != i_objects.end(); ++itr)
+        (*itr)->m_gridPositionIndex = NULL;
+}
+
+void GridPositionIndex::Insert(WorldObject* obj)
+{
+    ASSERT(!obj->m_gridPositionIndex);
+
+    obj->m_gridPositionIndex = this;
+    obj->m_gridPositionSlot = uint32(i_objects.size());
+
+    i_x.push_back(obj->GetPositionX());
+    i_y.push_back(obj->GetPositionY());
+    i_phaseMasks.push_back(obj->GetPhaseMask());
+    i_objects.push_back(obj);
+}
+
+void GridPositionIndex::Remove(WorldObject* obj)
+{
+    ASSERT(obj->m_gridPositionIndex == this);
+
+    // move last entry into the freed slot
+    uint32 slot = obj->m_gridPositionSlot;
+    uint32 last = uint32(i_objects.size()) - 1;
+    if (slot != last)
+    {
+        i_x[slot] = i_x[last];
+        i_y[slot] = i_y[last];
+        i_phaseMasks[slot] = i_phaseMasks[last];
+        i_objects[slot] = i_objects[last];
+        i_objects[slot]->m_gridPositionSlot = slot;
+    }
+
+    i_x.pop_back();
+    i_y.pop_back();
+    i_phaseMasks.pop_back();
+    i_objects.pop_back();
+
+    obj->m_gridPositionIndex = NULL;
+}
+
+void GridPositionIndex::Relocate(WorldObject const* obj)
+{
+    i_x[obj->m_gridPositionSlot] = obj->GetPositionX();
+    i_y[obj->m_gridPositionSlot] = obj->GetPositionY();
+}
+
+void GridPositionIndex::SetPhaseMask(WorldObject const* obj)
+{
+    i_phaseMasks[obj->m_gridPositionSlot] = obj->GetPhaseMask();
+}
+
+void GridPositionIndex::FilterInRange2d(float x, float y, float distSq, uint32 phaseMask, std::vector<WorldObject*>& result) const
+{
+    uint32 count = uint32(i_objects.size());
+    uint32 i = 0;
+
+#ifdef GRID_POSITION_INDEX_SSE2
+    __m128 const centerX = _mm_set1_ps(x);
+    __m128 const centerY = _mm_set1_ps(y);
+    __m128 const maxDistSq = _mm_set1_ps(distSq);
+    __m128i const phase = _mm_set1_epi32(int32(phaseMask));
+    __m128i const zero = _mm_setzero_si128();
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(&i_x[i]), centerX);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(&i_y[i]), centerY);
+        __m128 inRange = _mm_cmple_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), maxDistSq);
+
+        __m128i phases = _mm_loadu_si128(reinterpret_cast<__m128i const*>(&i_phaseMasks[i]));
+        __m128i otherPhase = _mm_cmpeq_epi32(_mm_and_si128(phases, phase), zero);
+
+        int mask = _mm_movemask_ps(_mm_andnot_ps(_mm_castsi128_ps(otherPhase), inRange));
+        if (!mask)
+            continue;
+
+        for (uint32 j = 0; j < 4; ++j)
+            if (mask & (1 << j))
+                result.push_back(i_objects[i + j]);
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        if (!(i_phaseMasks[i] & phaseMask))
+            continue;
+
+        float dx = i_x[i] - x;
+        float dy = i_y[i] - y;
+        if (dx * dx + dy * dy <= distSq)
+            result.push_back(i_objects[i]);
+    }
+}
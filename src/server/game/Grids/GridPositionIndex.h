@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_GRIDPOSITIONINDEX_H
+#define TRINITY_GRIDPOSITIONINDEX_H
+
+#include "Define.h"
+#include <vector>
+
+class WorldObject;
+
+/*
+ * Compact side arrays of positions and phase masks of all objects linked to one
+ * GridRefManager (one object type of one cell). Range checks of notifiers can be
+ * done on these arrays (SSE2 when available) without touching the objects, only
+ * objects that pass the filter are dereferenced.
+ *
+ * Kept in sync by Grid add/remove, WorldObject::Relocate and WorldObject::SetPhaseMask.
+ */
+class GridPositionIndex
+{
+    public:
+        GridPositionIndex() {}
+        ~GridPositionIndex();
+
+        void Insert(WorldObject* obj);
+        void Remove(WorldObject* obj);
+        void Relocate(WorldObject const* obj);
+        void SetPhaseMask(WorldObject const* obj);
+
+        // Appends objects sharing a phase with phaseMask and within exact 2d distance of (x,y), same result as GetExactDist2dSq <= distSq
+        void FilterInRange2d(float x, float y, float distSq, uint32 phaseMask, std::vector<WorldObject*>& result) const;
+
+        uint32 size() const { return uint32(i_objects.size()); }
+
+    private:
+        std::vector<float> i_x;
+        std::vector<float> i_y;
+        std::vector<uint32> i_phaseMasks;
+        std::vector<WorldObject*> i_objects;
+};
+
+#endif
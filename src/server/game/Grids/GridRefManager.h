@@ -20,6 +20,7 @@
 #define _GRIDREFMANAGER
 
 #include "RefManager.h"
+#include "GridPositionIndex.h"
 
 template<class OBJECT>
 class GridReference;
@@ -37,6 +38,13 @@ class GridRefManager : public RefManager<GridRefManager<OBJECT>, OBJECT>
         iterator end() { return iterator(NULL); }
         iterator rbegin() { return iterator(getLast()); }
         iterator rend() { return iterator(NULL); }
+
+        // positions of the linked world objects, filled by Grid and ObjectGridLoader
+        GridPositionIndex& GetPositionIndex() { return i_positionIndex; }
+        GridPositionIndex const& GetPositionIndex() const { return i_positionIndex; }
+
+    private:
+        GridPositionIndex i_positionIndex;
 };
 #endif
 
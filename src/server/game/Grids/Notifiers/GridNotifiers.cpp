@@ -37,10 +37,8 @@ VisibleNotifier::SendToSelf()
     if (Transport* transport = i_player.GetTransport())
         for (Transport::PlayerSet::const_iterator itr = transport->GetPassengers().begin();itr != transport->GetPassengers().end();++itr)
         {
-            if (vis_guids.find((*itr)->GetGUID()) != vis_guids.end())
+            if (vis_guids.erase((*itr)->GetGUID()))
             {
-                vis_guids.erase((*itr)->GetGUID());
-
                 i_player.UpdateVisibilityOf((*itr), i_data, i_visibleNow);
 
                 if (!(*itr)->isNeedNotify(NOTIFY_VISIBILITY_CHANGED))
@@ -111,7 +109,7 @@ VisibleChangesNotifier::Visit(DynamicObjectMapType &m)
                     caster->UpdateVisibilityOf(&i_object);
 }
 
-inline void CreatureUnitRelocationWorker(Creature* c, Unit* u)
+void Trinity::CreatureUnitRelocationWorker(Creature* c, Unit* u)
 {
     if (!u->isAlive() || !c->isAlive() || c == u || u->isInFlight())
         return;
@@ -140,8 +138,6 @@ void PlayerRelocationNotifier::Visit(PlayerMapType &m)
 
 void PlayerRelocationNotifier::Visit(CreatureMapType &m)
 {
-    bool relocated_for_ai = (&i_player == i_player.m_seer);
-
     for (CreatureMapType::iterator iter=m.begin(); iter != m.end(); ++iter)
     {
         Creature * c = iter->getSource();
@@ -149,9 +145,6 @@ void PlayerRelocationNotifier::Visit(CreatureMapType &m)
         vis_guids.erase(c->GetGUID());
 
         i_player.UpdateVisibilityOf(c,i_data,i_visibleNow);
-
-        if (relocated_for_ai && !c->isNeedNotify(NOTIFY_VISIBILITY_CHANGED))
-            CreatureUnitRelocationWorker(c, &i_player);
     }
 }
 
@@ -168,21 +161,6 @@ void CreatureRelocationNotifier::Visit(PlayerMapType &m)
     }
 }
 
-void CreatureRelocationNotifier::Visit(CreatureMapType &m)
-{
-    if (!i_creature.isAlive())
-        return;
-
-    for (CreatureMapType::iterator iter=m.begin(); iter != m.end(); ++iter)
-    {
-        Creature* c = iter->getSource();
-        CreatureUnitRelocationWorker(&i_creature, c);
-
-        if (!c->isNeedNotify(NOTIFY_VISIBILITY_CHANGED))
-            CreatureUnitRelocationWorker(c, &i_creature);
-    }
-}
-
 void DelayedUnitRelocation::Visit(CreatureMapType &m)
 {
     for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
@@ -191,13 +169,12 @@ void DelayedUnitRelocation::Visit(CreatureMapType &m)
         if (!unit->isNeedNotify(NOTIFY_VISIBILITY_CHANGED))
             continue;
 
+        // players are world objects only, creatures are found through the map sight triggers
         CreatureRelocationNotifier relocate(*unit);
-
         TypeContainerVisitor<CreatureRelocationNotifier, WorldTypeMapContainer > c2world_relocation(relocate);
-        TypeContainerVisitor<CreatureRelocationNotifier, GridTypeMapContainer >  c2grid_relocation(relocate);
-
         cell.Visit(p, c2world_relocation, i_map, *unit, i_radius);
-        cell.Visit(p, c2grid_relocation, i_map, *unit, i_radius);
+
+        i_map.NotifySightTriggers(unit, true);
     }
 }
 
@@ -225,32 +202,21 @@ void DelayedUnitRelocation::Visit(PlayerMapType &m)
         cell2.Visit(pair2, c2world_relocation, i_map, *viewPoint, i_radius);
         cell2.Visit(pair2, c2grid_relocation, i_map, *viewPoint, i_radius);
 
-        relocate.SendToSelf();
-    }
-}
+        // creatures only react to the player itself, not to a far sight view point
+        if (player == viewPoint)
+            i_map.NotifySightTriggers(player, true);
 
-void AIRelocationNotifier::Visit(CreatureMapType &m)
-{
-    for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
-    {
-        Creature *c = iter->getSource();
-        CreatureUnitRelocationWorker(c, &i_unit);
-        if (isCreature)
-            CreatureUnitRelocationWorker((Creature*)&i_unit, c);
+        relocate.SendToSelf();
     }
 }
 
 void
 MessageDistDeliverer::Visit(PlayerMapType &m)
 {
-    for (PlayerMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+    FilterTargets(m);
+    for (std::vector<WorldObject*>::const_iterator iter = i_targets.begin(); iter != i_targets.end(); ++iter)
     {
-        Player *target = iter->getSource();
-        if (!target->InSamePhase(i_phaseMask))
-            continue;
-
-        if (target->GetExactDist2dSq(i_source) > i_distSq)
-            continue;
+        Player *target = (Player*)*iter;
 
         // Send packet to all who are sharing the player's vision
         if (!target->GetSharedVisionList().empty())
@@ -269,20 +235,17 @@ MessageDistDeliverer::Visit(PlayerMapType &m)
 void
 MessageDistDeliverer::Visit(CreatureMapType &m)
 {
-    for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+    FilterTargets(m);
+    for (std::vector<WorldObject*>::const_iterator iter = i_targets.begin(); iter != i_targets.end(); ++iter)
     {
-        if (!iter->getSource()->InSamePhase(i_phaseMask))
-            continue;
-
-        if (iter->getSource()->GetExactDist2dSq(i_source) > i_distSq)
-            continue;
+        Creature *target = (Creature*)*iter;
 
         // Send packet to all who are sharing the creature's vision
-        if (!iter->getSource()->GetSharedVisionList().empty())
+        if (!target->GetSharedVisionList().empty())
         {
-            SharedVisionList::const_iterator i = iter->getSource()->GetSharedVisionList().begin();
-            for (; i != iter->getSource()->GetSharedVisionList().end(); ++i)
-                if ((*i)->m_seer == iter->getSource())
+            SharedVisionList::const_iterator i = target->GetSharedVisionList().begin();
+            for (; i != target->GetSharedVisionList().end(); ++i)
+                if ((*i)->m_seer == target)
                     SendPacket(*i);
         }
     }
@@ -291,19 +254,16 @@ MessageDistDeliverer::Visit(CreatureMapType &m)
 void
 MessageDistDeliverer::Visit(DynamicObjectMapType &m)
 {
-    for (DynamicObjectMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+    FilterTargets(m);
+    for (std::vector<WorldObject*>::const_iterator iter = i_targets.begin(); iter != i_targets.end(); ++iter)
     {
-        if (!iter->getSource()->InSamePhase(i_phaseMask))
-            continue;
+        DynamicObject *target = (DynamicObject*)*iter;
 
-        if (iter->getSource()->GetExactDist2dSq(i_source) > i_distSq)
-            continue;
-
-        if (IS_PLAYER_GUID(iter->getSource()->GetCasterGUID()))
+        if (IS_PLAYER_GUID(target->GetCasterGUID()))
         {
             // Send packet back to the caster if the caster has vision of dynamic object
-            Player* caster = (Player*)iter->getSource()->GetCaster();
-            if (caster && caster->m_seer == iter->getSource())
+            Player* caster = (Player*)target->GetCaster();
+            if (caster && caster->m_seer == target)
                 SendPacket(caster);
         }
     }
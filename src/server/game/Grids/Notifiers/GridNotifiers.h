@@ -73,7 +73,6 @@ namespace Trinity
         Creature &i_creature;
         CreatureRelocationNotifier(Creature &c) : i_creature(c) {}
         template<class T> void Visit(GridRefManager<T> &) {}
-        void Visit(CreatureMapType &);
         void Visit(PlayerMapType &);
     };
 
@@ -90,14 +89,8 @@ namespace Trinity
         void Visit(PlayerMapType   &);
     };
 
-     struct AIRelocationNotifier
-     {
-        Unit &i_unit;
-        bool isCreature;
-        explicit AIRelocationNotifier(Unit &unit) : i_unit(unit), isCreature(unit.GetTypeId() == TYPEID_UNIT)  {}
-        template<class T> void Visit(GridRefManager<T> &) {}
-        void Visit(CreatureMapType &);
-     };
+    // calls MoveInLineOfSight of c for u if c is able to notice u
+    void CreatureUnitRelocationWorker(Creature* c, Unit* u);
 
     struct GridUpdater
     {
@@ -126,6 +119,7 @@ namespace Trinity
         float i_distSq;
         uint32 team;
         Player const* skipped_receiver;
+        std::vector<WorldObject*> i_targets;                // range filtered objects of the visited cell
         MessageDistDeliverer(WorldObject *src, WorldPacket *msg, float dist, bool own_team_only = false, Player const* skipped = NULL)
             : i_source(src), i_message(msg), i_phaseMask(src->GetPhaseMask()), i_distSq(dist * dist)
             , team((own_team_only && src->GetTypeId() == TYPEID_PLAYER) ? ((Player*)src)->GetTeam() : 0)
@@ -137,6 +131,12 @@ namespace Trinity
         void Visit(DynamicObjectMapType &m);
         template<class SKIP> void Visit(GridRefManager<SKIP> &) {}
 
+        template<class T> void FilterTargets(GridRefManager<T> &m)
+        {
+            i_targets.clear();
+            m.GetPositionIndex().FilterInRange2d(i_source->GetPositionX(), i_source->GetPositionY(), i_distSq, i_phaseMask, i_targets);
+        }
+
         void SendPacket(Player* plr)
         {
             // never send packet to self
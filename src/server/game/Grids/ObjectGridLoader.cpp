@@ -109,6 +109,7 @@ template <class T>
 void AddObjectHelper(CellPair &cell, GridRefManager<T> &m, uint32 &count, Map* map, T *obj)
 {
     obj->GetGridRef().link(&m, obj);
+    m.GetPositionIndex().Insert(obj);
     AddUnitState(obj,cell);
     obj->AddToWorld();
     if (obj->isActiveObject())
@@ -118,9 +119,9 @@ void AddObjectHelper(CellPair &cell, GridRefManager<T> &m, uint32 &count, Map* m
 }
 
 template <class T>
-void LoadHelper(CellGuidSet const& guid_set, CellPair &cell, GridRefManager<T> &m, uint32 &count, Map* map)
+void LoadHelper(CellGuidList const& guid_list, CellPair &cell, GridRefManager<T> &m, uint32 &count, Map* map)
 {
-    for (CellGuidSet::const_iterator i_guid = guid_set.begin(); i_guid != guid_set.end(); ++i_guid)
+    for (CellGuidList::const_iterator i_guid = guid_list.begin(); i_guid != guid_list.end(); ++i_guid)
     {
         T* obj = new T;
         uint32 guid = *i_guid;
@@ -169,9 +170,10 @@ ObjectGridLoader::Visit(GameObjectMapType &m)
     CellPair cell_pair(x,y);
     uint32 cell_id = (cell_pair.y_coord*TOTAL_NUMBER_OF_CELLS_PER_MAP) + cell_pair.x_coord;
 
-    CellObjectGuids const& cell_guids = sObjectMgr->GetCellObjectGuids(i_map->GetId(), i_map->GetSpawnMode(), cell_id);
+    CellGuidList guids;
+    sObjectMgr->GetCellObjectGuids(SPAWN_INDEX_GAMEOBJECT, i_map->GetId(), i_map->GetSpawnMode(), cell_id, guids);
 
-    LoadHelper(cell_guids.gameobjects, cell_pair, m, i_gameObjects, i_map);
+    LoadHelper(guids, cell_pair, m, i_gameObjects, i_map);
 }
 
 void
@@ -182,9 +184,10 @@ ObjectGridLoader::Visit(CreatureMapType &m)
     CellPair cell_pair(x,y);
     uint32 cell_id = (cell_pair.y_coord*TOTAL_NUMBER_OF_CELLS_PER_MAP) + cell_pair.x_coord;
 
-    CellObjectGuids const& cell_guids = sObjectMgr->GetCellObjectGuids(i_map->GetId(), i_map->GetSpawnMode(), cell_id);
+    CellGuidList guids;
+    sObjectMgr->GetCellObjectGuids(SPAWN_INDEX_CREATURE, i_map->GetId(), i_map->GetSpawnMode(), cell_id, guids);
 
-    LoadHelper(cell_guids.creatures, cell_pair, m, i_creatures, i_map);
+    LoadHelper(guids, cell_pair, m, i_creatures, i_map);
 }
 
 void
@@ -195,9 +198,9 @@ ObjectWorldLoader::Visit(CorpseMapType &m)
     CellPair cell_pair(x,y);
     uint32 cell_id = (cell_pair.y_coord*TOTAL_NUMBER_OF_CELLS_PER_MAP) + cell_pair.x_coord;
 
-    // corpses are always added to spawn mode 0 and they are spawned by their instance id
-    CellObjectGuids const& cell_guids = sObjectMgr->GetCellObjectGuids(i_map->GetId(), 0, cell_id);
-    LoadHelper(cell_guids.corpses, cell_pair, m, i_corpses, i_map);
+    CellCorpseSet corpses;
+    sObjectMgr->GetCellCorpses(i_map->GetId(), cell_id, corpses);
+    LoadHelper(corpses, cell_pair, m, i_corpses, i_map);
 }
 
 void
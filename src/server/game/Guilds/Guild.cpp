@@ -23,6 +23,8 @@
 #include "Config.h"
 #include "SocialMgr.h"
 #include "Log.h"
+#include "CharacterCache.h"
+#include "WhoListCache.h"
 
 #define MAX_GUILD_BANK_TAB_TEXT_LEN 500
 #define EMBLEM_PRICE 10 * GOLD
@@ -559,6 +561,7 @@ void Guild::Member::ChangeRank(uint8 newRank)
     stmt->setUInt8 (0, newRank);
     stmt->setUInt32(1, GUID_LOPART(m_guid));
     CharacterDatabase.Execute(stmt);
+    sCharacterCache->UpdateGuild(GUID_LOPART(m_guid), m_guildId, newRank);
 }
 
 void Guild::Member::SaveToDB(SQLTransaction& trans) const
@@ -2094,17 +2097,10 @@ bool Guild::AddMember(const uint64& guid, uint8 rankId)
     {
         bool ok = false;
         // Player must exist
-        PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_LOAD_CHAR_DATA_FOR_GUILD);
-        stmt->setUInt32(0, lowguid);
-        if (PreparedQueryResult result = CharacterDatabase.Query(stmt))
+        CharacterCacheEntry entry;
+        if (sCharacterCache->GetCharacter(lowguid, entry))
         {
-            Field *fields = result->Fetch();
-            pMember->SetStats(
-                fields[0].GetString(),
-                fields[1].GetUInt8(),
-                fields[2].GetUInt8(),
-                fields[3].GetUInt32(),
-                fields[4].GetUInt32());
+            pMember->SetStats(entry.name, entry.level, entry.playerClass, entry.zoneId, entry.account);
 
             ok = pMember->CheckStats();
         }
@@ -2118,12 +2114,14 @@ bool Guild::AddMember(const uint64& guid, uint8 rankId)
 
     SQLTransaction trans(NULL);
     pMember->SaveToDB(trans);
+    sCharacterCache->UpdateGuild(lowguid, m_id, rankId);
     // If player not in game data in will be loaded from guild tables, so no need to update it!
     if (player)
     {
         player->SetInGuild(m_id);
         player->SetRank(rankId);
         player->SetGuildIdInvited(0);
+        sWhoListCache->UpdateGuild(lowguid, m_id, m_name);
     }
 
     _UpdateAccountsNumber();
@@ -2183,9 +2181,11 @@ void Guild::DeleteMember(const uint64& guid, bool isDisbanding, bool isKicked)
     {
         player->SetInGuild(0);
         player->SetRank(0);
+        sWhoListCache->UpdateGuild(lowguid, 0, "");
     }
 
     _DeleteMemberFromDB(lowguid);
+    sCharacterCache->UpdateGuild(lowguid, 0, 0);
     if (!isDisbanding)
         _UpdateAccountsNumber();
 }
@@ -30,6 +30,7 @@
 #include "MapManager.h"
 #include "ObjectMgr.h"
 #include "Group.h"
+#include <algorithm>
 
 #define DEFAULT_GRID_EXPIRY     300
 #define MAX_GRID_LOAD_TIME      50
@@ -43,6 +44,10 @@ Map::~Map()
 
     UnloadAll();
 
+    // grid unloading above may still save respawn times
+    SaveRespawnTimesToDB();
+    sObjectMgr->StoreRespawnTimes(GetId(), GetInstanceId(), m_creatureRespawnTimes, m_goRespawnTimes);
+
     while (!i_worldObjects.empty())
     {
         WorldObject *obj = *i_worldObjects.begin();
@@ -193,7 +198,8 @@ Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode, Map* _par
 i_mapEntry (sMapStore.LookupEntry(id)), i_spawnMode(SpawnMode), i_InstanceId(InstanceId),
 m_unloadTimer(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE),
 m_VisibilityNotifyPeriod(DEFAULT_VISIBILITY_NOTIFY_PERIOD),
-m_activeNonPlayersIter(m_activeNonPlayers.end()), i_gridExpiry(expiry), i_scriptLock(false)
+m_activeNonPlayersIter(m_activeNonPlayers.end()), i_gridExpiry(expiry),
+m_respawnSaveTimer(sWorld->getIntConfig(CONFIG_INTERVAL_RESPAWN_SAVE)), i_scriptLock(false)
 {
     m_parentMap = (_parent ? _parent : this);
     for (unsigned int idx=0; idx < MAX_NUMBER_OF_GRIDS; ++idx)
@@ -206,6 +212,8 @@ m_activeNonPlayersIter(m_activeNonPlayers.end()), i_gridExpiry(expiry), i_script
         }
     }
 
+    sObjectMgr->TakeRespawnTimes(id, InstanceId, m_creatureRespawnTimes, m_goRespawnTimes);
+
     //lets initialize visibility distance for map
     Map::InitVisibilityDistance();
 
@@ -565,6 +573,14 @@ void Map::Update(const uint32 &t_diff)
     if (!m_mapRefManager.isEmpty() || !m_activeNonPlayers.empty())
         ProcessRelocationNotifies(t_diff);
 
+    if (m_respawnSaveTimer <= t_diff)
+    {
+        SaveRespawnTimesToDB();
+        m_respawnSaveTimer = sWorld->getIntConfig(CONFIG_INTERVAL_RESPAWN_SAVE);
+    }
+    else
+        m_respawnSaveTimer -= t_diff;
+
     sScriptMgr->OnMapUpdate(this, t_diff);
 }
 
@@ -657,6 +673,140 @@ void Map::ProcessRelocationNotifies(const uint32 & diff)
     }
 }
 
+Map::SightTriggerArea Map::ComputeSightTriggerArea(float x, float y, float radius)
+{
+    float low_x = x - radius, low_y = y - radius;
+    float high_x = x + radius, high_y = y + radius;
+    Trinity::NormalizeMapCoord(low_x);
+    Trinity::NormalizeMapCoord(low_y);
+    Trinity::NormalizeMapCoord(high_x);
+    Trinity::NormalizeMapCoord(high_y);
+
+    CellPair low = Trinity::ComputeCellPair(low_x, low_y);
+    CellPair high = Trinity::ComputeCellPair(high_x, high_y);
+
+    SightTriggerArea area;
+    area.low_x = low.x_coord;
+    area.low_y = low.y_coord;
+    area.high_x = high.x_coord;
+    area.high_y = high.y_coord;
+    return area;
+}
+
+void Map::LinkSightTrigger(Creature* creature, SightTriggerArea const& area)
+{
+    for (uint32 x = area.low_x; x <= area.high_x; ++x)
+        for (uint32 y = area.low_y; y <= area.high_y; ++y)
+            m_sightTriggerCells[y * TOTAL_NUMBER_OF_CELLS_PER_MAP + x].push_back(creature);
+}
+
+void Map::UnlinkSightTrigger(Creature* creature, SightTriggerArea const& area)
+{
+    for (uint32 x = area.low_x; x <= area.high_x; ++x)
+    {
+        for (uint32 y = area.low_y; y <= area.high_y; ++y)
+        {
+            SightTriggerCells::iterator itr = m_sightTriggerCells.find(y * TOTAL_NUMBER_OF_CELLS_PER_MAP + x);
+            if (itr == m_sightTriggerCells.end())
+                continue;
+
+            SightTriggerList& list = itr->second;
+            SightTriggerList::iterator pos = std::find(list.begin(), list.end(), creature);
+            if (pos != list.end())
+            {
+                *pos = list.back();
+                list.pop_back();
+            }
+
+            if (list.empty())
+                m_sightTriggerCells.erase(itr);
+        }
+    }
+}
+
+void Map::UpdateSightTrigger(Creature* creature)
+{
+    // only creatures in world are listed, they are unlinked again in Creature::RemoveFromWorld
+    if (!creature->IsInWorld())
+        return;
+
+    // same bound as canSeeOrDetect() uses for creatures, never wider than the old relocation visit radius
+    float radius = std::min(creature->GetSightRange(), MAX_VISIBILITY_DISTANCE) + creature->GetObjectSize();
+    SightTriggerArea area = ComputeSightTriggerArea(creature->GetPositionX(), creature->GetPositionY(), radius);
+
+    SightTriggerAreas::iterator itr = m_sightTriggerAreas.find(creature);
+    if (itr != m_sightTriggerAreas.end())
+    {
+        if (itr->second == area)
+            return;
+
+        UnlinkSightTrigger(creature, itr->second);
+        itr->second = area;
+    }
+    else
+        m_sightTriggerAreas[creature] = area;
+
+    LinkSightTrigger(creature, area);
+}
+
+void Map::RemoveSightTrigger(Creature* creature)
+{
+    SightTriggerAreas::iterator itr = m_sightTriggerAreas.find(creature);
+    if (itr == m_sightTriggerAreas.end())
+        return;
+
+    UnlinkSightTrigger(creature, itr->second);
+    m_sightTriggerAreas.erase(itr);
+}
+
+void Map::NotifySightTriggers(Unit* unit, bool skipPendingSeers)
+{
+    Creature* mover = unit->ToCreature();
+    if (mover)
+        UpdateSightTrigger(mover);
+
+    // a creature also looks around itself, so search everything its own sight range covers.
+    // Every trigger area contains its owner, so this finds all creatures it can see as well
+    float radius = unit->GetObjectSize();
+    if (mover)
+        radius += std::min(mover->GetSightRange(), MAX_VISIBILITY_DISTANCE) + mover->GetObjectSize();
+
+    SightTriggerArea area = ComputeSightTriggerArea(unit->GetPositionX(), unit->GetPositionY(), radius);
+
+    // copy out first, MoveInLineOfSight may move or summon creatures and change the lists
+    SightTriggerList seers;
+    for (uint32 x = area.low_x; x <= area.high_x; ++x)
+    {
+        for (uint32 y = area.low_y; y <= area.high_y; ++y)
+        {
+            SightTriggerCells::const_iterator itr = m_sightTriggerCells.find(y * TOTAL_NUMBER_OF_CELLS_PER_MAP + x);
+            if (itr != m_sightTriggerCells.end())
+                seers.insert(seers.end(), itr->second.begin(), itr->second.end());
+        }
+    }
+
+    // owners see their charmed and summoned units at any distance
+    if (uint64 ownerGuid = unit->GetCharmerOrOwnerGUID())
+        if (IS_CRE_OR_VEH_GUID(ownerGuid))
+            if (Creature* owner = GetCreature(ownerGuid))
+                if (owner->IsWithinDist(unit, MAX_VISIBILITY_DISTANCE, false))
+                    seers.push_back(owner);
+
+    std::sort(seers.begin(), seers.end());
+    seers.erase(std::unique(seers.begin(), seers.end()), seers.end());
+
+    for (SightTriggerList::const_iterator itr = seers.begin(); itr != seers.end(); ++itr)
+    {
+        Creature* seer = *itr;
+
+        if (mover)
+            Trinity::CreatureUnitRelocationWorker(mover, seer);
+
+        if (!skipPendingSeers || !seer->isNeedNotify(NOTIFY_VISIBILITY_CHANGED))
+            Trinity::CreatureUnitRelocationWorker(seer, unit);
+    }
+}
+
 void Map::Remove(Player *player, bool remove)
 {
     player->RemoveFromWorld();
@@ -779,6 +929,7 @@ Map::CreatureRelocation(Creature *creature, float x, float y, float z, float ang
     else
     {
         creature->Relocate(x, y, z, ang);
+        UpdateSightTrigger(creature);
         creature->UpdateObjectVisibility(false);
     }
 
@@ -812,6 +963,7 @@ void Map::MoveAllCreaturesInMoveList()
         {
             // update pos
             c->Relocate(cm.x, cm.y, cm.z, cm.ang);
+            UpdateSightTrigger(c);
             //CreatureRelocationNotify(c,new_cell,new_cell.cellPair());
             c->UpdateObjectVisibility(false);
         }
@@ -918,6 +1070,7 @@ bool Map::CreatureRespawnRelocation(Creature *c)
     if (CreatureCellRelocation(c,resp_cell))
     {
         c->Relocate(resp_x, resp_y, resp_z, resp_o);
+        UpdateSightTrigger(c);
         c->GetMotionMaster()->Initialize();                 // prevent possible problems with default move generators
         //CreatureRelocationNotify(c,resp_cell,resp_cell.cellPair());
         c->UpdateObjectVisibility(false);
@@ -1020,6 +1173,119 @@ void Map::UnloadAll()
     }
 }
 
+void Map::SaveCreatureRespawnTime(uint32 dbGuid, time_t respawnTime)
+{
+    if (!respawnTime)
+    {
+        // Delete only
+        RemoveCreatureRespawnTime(dbGuid);
+        return;
+    }
+
+    m_creatureRespawnTimes[dbGuid] = respawnTime;
+    m_pendingCreatureRespawnTimes[dbGuid] = respawnTime;
+}
+
+void Map::RemoveCreatureRespawnTime(uint32 dbGuid)
+{
+    if (m_creatureRespawnTimes.erase(dbGuid))
+        m_pendingCreatureRespawnTimes[dbGuid] = 0;
+}
+
+void Map::SaveGORespawnTime(uint32 dbGuid, time_t respawnTime)
+{
+    if (!respawnTime)
+    {
+        // Delete only
+        RemoveGORespawnTime(dbGuid);
+        return;
+    }
+
+    m_goRespawnTimes[dbGuid] = respawnTime;
+    m_pendingGORespawnTimes[dbGuid] = respawnTime;
+}
+
+void Map::RemoveGORespawnTime(uint32 dbGuid)
+{
+    if (m_goRespawnTimes.erase(dbGuid))
+        m_pendingGORespawnTimes[dbGuid] = 0;
+}
+
+time_t Map::GetLinkedRespawnTime(uint64 guid) const
+{
+    uint64 linkedGuid = sObjectMgr->GetLinkedRespawnGuid(guid);
+    switch (GUID_HIPART(linkedGuid))
+    {
+        case HIGHGUID_UNIT:
+            return GetCreatureRespawnTime(GUID_LOPART(linkedGuid));
+        case HIGHGUID_GAMEOBJECT:
+            return GetGORespawnTime(GUID_LOPART(linkedGuid));
+        default:
+            return 0;
+    }
+}
+
+void Map::DeleteRespawnTimes()
+{
+    m_creatureRespawnTimes.clear();
+    m_goRespawnTimes.clear();
+    m_pendingCreatureRespawnTimes.clear();
+    m_pendingGORespawnTimes.clear();
+
+    sObjectMgr->DeleteRespawnTimeForInstance(GetInstanceId());
+}
+
+void Map::SaveRespawnTimesToDB()
+{
+    if (m_pendingCreatureRespawnTimes.empty() && m_pendingGORespawnTimes.empty())
+        return;
+
+    SQLTransaction trans = CharacterDatabase.BeginTransaction();
+
+    for (PendingRespawnTimes::const_iterator itr = m_pendingCreatureRespawnTimes.begin(); itr != m_pendingCreatureRespawnTimes.end(); ++itr)
+    {
+        PreparedStatement* stmt;
+        if (itr->second)
+        {
+            stmt = CharacterDatabase.GetPreparedStatement(CHAR_ADD_CREATURE_RESPAWN_TIME);
+            stmt->setUInt32(0, itr->first);
+            stmt->setUInt64(1, uint64(itr->second));
+            stmt->setUInt32(2, GetInstanceId());
+        }
+        else
+        {
+            stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CREATURE_RESPAWN_TIME);
+            stmt->setUInt32(0, itr->first);
+            stmt->setUInt32(1, GetInstanceId());
+        }
+        trans->Append(stmt);
+    }
+
+    for (PendingRespawnTimes::const_iterator itr = m_pendingGORespawnTimes.begin(); itr != m_pendingGORespawnTimes.end(); ++itr)
+    {
+        PreparedStatement* stmt;
+        if (itr->second)
+        {
+            stmt = CharacterDatabase.GetPreparedStatement(CHAR_ADD_GO_RESPAWN_TIME);
+            stmt->setUInt32(0, itr->first);
+            stmt->setUInt64(1, uint64(itr->second));
+            stmt->setUInt32(2, GetInstanceId());
+        }
+        else
+        {
+            stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_GO_RESPAWN_TIME);
+            stmt->setUInt32(0, itr->first);
+            stmt->setUInt32(1, GetInstanceId());
+        }
+        trans->Append(stmt);
+    }
+
+    CharacterDatabase.CommitTransaction(trans);
+
+    m_pendingCreatureRespawnTimes.clear();
+    m_pendingGORespawnTimes.clear();
+}
+
 //*****************************
 // Grid function
 //*****************************
@@ -2518,7 +2784,7 @@ void InstanceMap::UnloadAll()
     ASSERT(!HavePlayers());
 
     if (m_resetAfterUnload == true)
-        sObjectMgr->DeleteRespawnTimeForInstance(GetInstanceId());
+        DeleteRespawnTimes();
 
     Map::UnloadAll();
 }
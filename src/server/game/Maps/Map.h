@@ -33,6 +33,7 @@
 
 #include <bitset>
 #include <list>
+#include <vector>
 
 class Unit;
 class WorldPacket;
@@ -247,6 +248,12 @@ typedef UNORDERED_MAP<Creature*, CreatureMover> CreatureMoveList;
 
 typedef std::map<uint32/*leaderDBGUID*/, CreatureGroup*>        CreatureGroupHolderType;
 
+typedef UNORDERED_MAP<uint32/*db guid*/, time_t> MapRespawnTimes;
+typedef std::map<uint32/*db guid*/, time_t/*0 = delete*/> PendingRespawnTimes;
+
+typedef std::vector<Creature*> SightTriggerList;
+typedef UNORDERED_MAP<uint32/*cell id*/, SightTriggerList> SightTriggerCells;
+
 class Map : public GridRefManager<NGridType>
 {
     friend class MapReference;
@@ -393,6 +400,12 @@ class Map : public GridRefManager<NGridType>
         void UpdateObjectVisibility(WorldObject* obj, Cell cell, CellPair cellpair);
         void UpdateObjectsVisibilityFor(Player* player, Cell cell, CellPair cellpair);
 
+        // Every creature is listed in the cells covered by its sight range, so a moving unit only
+        // has to ask the creatures listed in its own cells whether it moved into their line of sight
+        void UpdateSightTrigger(Creature* creature);
+        void RemoveSightTrigger(Creature* creature);
+        void NotifySightTriggers(Unit* unit, bool skipPendingSeers);
+
         void resetMarkedCells() { marked_cells.reset(); }
         bool isCellMarked(uint32 pCellId) { return marked_cells.test(pCellId); }
         void markCell(uint32 pCellId) { marked_cells.set(pCellId); }
@@ -438,6 +451,17 @@ class Map : public GridRefManager<NGridType>
         GameObject* GetGameObject(uint64 guid);
         DynamicObject* GetDynamicObject(uint64 guid);
 
+        // respawn times of this map's DB spawns, only accessed by the thread updating the map
+        time_t GetCreatureRespawnTime(uint32 dbGuid) const { return GetRespawnTime(m_creatureRespawnTimes, dbGuid); }
+        void SaveCreatureRespawnTime(uint32 dbGuid, time_t respawnTime);
+        void RemoveCreatureRespawnTime(uint32 dbGuid);
+        time_t GetGORespawnTime(uint32 dbGuid) const { return GetRespawnTime(m_goRespawnTimes, dbGuid); }
+        void SaveGORespawnTime(uint32 dbGuid, time_t respawnTime);
+        void RemoveGORespawnTime(uint32 dbGuid);
+        time_t GetLinkedRespawnTime(uint64 guid) const;
+        void DeleteRespawnTimes();
+        void SaveRespawnTimesToDB();
+
         MapInstanced* ToMapInstanced(){ if (Instanceable())  return reinterpret_cast<MapInstanced*>(this); else return NULL;  }
         const MapInstanced* ToMapInstanced() const { if (Instanceable())  return (const MapInstanced*)((MapInstanced*)this); else return NULL;  }
 
@@ -517,6 +541,19 @@ class Map : public GridRefManager<NGridType>
 
         time_t i_gridExpiry;
 
+        static time_t GetRespawnTime(MapRespawnTimes const& respawnTimes, uint32 dbGuid)
+        {
+            MapRespawnTimes::const_iterator itr = respawnTimes.find(dbGuid);
+            return itr != respawnTimes.end() ? itr->second : 0;
+        }
+
+        MapRespawnTimes m_creatureRespawnTimes;
+        MapRespawnTimes m_goRespawnTimes;
+        // changes not written to the character DB yet, flushed in one transaction every CONFIG_INTERVAL_RESPAWN_SAVE
+        PendingRespawnTimes m_pendingCreatureRespawnTimes;
+        PendingRespawnTimes m_pendingGORespawnTimes;
+        uint32 m_respawnSaveTimer;
+
         //used for fast base_map (e.g. MapInstanced class object) search for
         //InstanceMaps and BattlegroundMaps...
         Map* m_parentMap;
@@ -525,6 +562,24 @@ class Map : public GridRefManager<NGridType>
         GridMap *GridMaps[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
         std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP*TOTAL_NUMBER_OF_CELLS_PER_MAP> marked_cells;
 
+        struct SightTriggerArea
+        {
+            uint32 low_x, low_y, high_x, high_y;            // inclusive cell coords
+
+            bool operator==(SightTriggerArea const& other) const
+            {
+                return low_x == other.low_x && low_y == other.low_y && high_x == other.high_x && high_y == other.high_y;
+            }
+        };
+        typedef UNORDERED_MAP<Creature*, SightTriggerArea> SightTriggerAreas;
+
+        static SightTriggerArea ComputeSightTriggerArea(float x, float y, float radius);
+        void LinkSightTrigger(Creature* creature, SightTriggerArea const& area);
+        void UnlinkSightTrigger(Creature* creature, SightTriggerArea const& area);
+
+        SightTriggerCells m_sightTriggerCells;
+        SightTriggerAreas m_sightTriggerAreas;
+
         //these functions used to process player/mob aggro reactions and
         //visibility calculations. Highly optimized for massive calculations
         void ProcessRelocationNotifies(const uint32 &diff);
@@ -36,10 +36,15 @@ class DestinationHolder
     bool i_destSet;
     float i_fromX, i_fromY, i_fromZ;
     float i_destX, i_destY, i_destZ;
+    bool i_syncPosition;
 
     public:
-        DestinationHolder() : i_tracker(TRAVELLER_UPDATE_INTERVAL), i_totalTravelTime(0), i_timeElapsed(0),
-            i_destSet(false), i_fromX(0), i_fromY(0), i_fromZ(0), i_destX(0), i_destY(0), i_destZ(0) {}
+        /* The traveller is relocated along its path every TRAVELLER_UPDATE_INTERVAL. With syncPosition its
+         * position is additionally computed from the path at the moment it stops or starts another path,
+         * instead of staying at the last update, so it matches where the client sees it.
+         */
+        explicit DestinationHolder(bool syncPosition = false) : i_tracker(TRAVELLER_UPDATE_INTERVAL), i_totalTravelTime(0), i_timeElapsed(0),
+            i_destSet(false), i_fromX(0), i_fromY(0), i_fromZ(0), i_destX(0), i_destY(0), i_destZ(0), i_syncPosition(syncPosition) {}
 
         uint32 SetDestination(TRAVELLER &traveller, float dest_x, float dest_y, float dest_z, bool sendMove = true);
         void GetDestination(float &x, float &y, float &z) const { x = i_destX; y = i_destY; z = i_destZ; }
@@ -56,8 +61,11 @@ class DestinationHolder
         void GetLocationNow(const Map * map, float &x, float &y, float &z, bool is3D = false) const;
         void GetLocationNowNoMicroMovement(float &x, float &y, float &z) const; // For use without micro movement
         float GetDistance3dFromDestSq(const WorldObject &obj) const;
+        // Relocates the traveller to its current path position, must be done before anything else moves it
+        void SyncTravellerPosition(TRAVELLER &traveller);
 
     private:
+        uint32 _startTravel(TRAVELLER &traveller, bool sendMove);
         void _findOffSetPoint(float x1, float y1, float x2, float y2, float offset, float &x, float &y);
 
 };
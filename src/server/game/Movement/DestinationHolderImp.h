@@ -64,17 +64,28 @@ template<typename TRAVELLER>
 uint32
 DestinationHolder<TRAVELLER>::SetDestination(TRAVELLER &traveller, float dest_x, float dest_y, float dest_z, bool sendMove)
 {
+    // the new path starts where the traveller is now, not where it was last relocated
+    SyncTravellerPosition(traveller);
+
     i_destSet = true;
     i_destX = dest_x;
     i_destY = dest_y;
     i_destZ = dest_z;
 
-    return StartTravel(traveller, sendMove);
+    return _startTravel(traveller, sendMove);
 }
 
 template<typename TRAVELLER>
 uint32
 DestinationHolder<TRAVELLER>::StartTravel(TRAVELLER &traveller, bool sendMove)
+{
+    SyncTravellerPosition(traveller);
+    return _startTravel(traveller, sendMove);
+}
+
+template<typename TRAVELLER>
+uint32
+DestinationHolder<TRAVELLER>::_startTravel(TRAVELLER &traveller, bool sendMove)
 {
     if (!i_destSet) return 0;
 
@@ -141,6 +152,20 @@ DestinationHolder<TRAVELLER>::UpdateTraveller(TRAVELLER &traveller, uint32 diff,
     return true;
 }
 
+template<typename TRAVELLER>
+void
+DestinationHolder<TRAVELLER>::SyncTravellerPosition(TRAVELLER &traveller)
+{
+    if (!i_destSet || !i_syncPosition || !traveller.GetTraveller().IsInWorld())
+        return;
+
+    float x, y, z;
+    GetLocationNow(traveller.GetTraveller().GetBaseMap(), x, y, z, traveller.GetTraveller().HasUnitState(UNIT_STAT_IN_FLIGHT));
+
+    if (traveller.GetPositionX() != x || traveller.GetPositionY() != y || traveller.GetPositionZ() != z)
+        traveller.Relocation(x, y, z, traveller.GetTraveller().GetAngle(x, y));
+}
+
 template<typename TRAVELLER>
 void
 DestinationHolder<TRAVELLER>::GetLocationNow(const Map * map, float &x, float &y, float &z, bool is3D) const
@@ -116,6 +116,8 @@ MotionMaster::UpdateMotion(uint32 diff)
 void
 MotionMaster::DirectClean(bool reset)
 {
+    SyncOwnerPosition();
+
     while (size() > 1)
     {
         MovementGenerator *curr = top();
@@ -132,6 +134,8 @@ MotionMaster::DirectClean(bool reset)
 void
 MotionMaster::DelayedClean()
 {
+    SyncOwnerPosition();
+
     while (size() > 1)
     {
         MovementGenerator *curr = top();
@@ -144,6 +148,8 @@ MotionMaster::DelayedClean()
 void
 MotionMaster::DirectExpire(bool reset)
 {
+    SyncOwnerPosition();
+
     if (size() > 1)
     {
         MovementGenerator *curr = top();
@@ -165,6 +171,8 @@ MotionMaster::DirectExpire(bool reset)
 void
 MotionMaster::DelayedExpire()
 {
+    SyncOwnerPosition();
+
     if (size() > 1)
     {
         MovementGenerator *curr = top();
@@ -483,6 +491,9 @@ MotionMaster::MoveDistract(uint32 timer)
 
 void MotionMaster::Mutate(MovementGenerator *m, MovementSlot slot)
 {
+    // the generator that is replaced or covered stops moving its owner
+    SyncOwnerPosition();
+
     if (MovementGenerator *curr = Impl[slot])
     {
         Impl[slot] = NULL; // in case a new one is generated in this slot during directdelete
@@ -568,6 +579,12 @@ MovementGeneratorType MotionMaster::GetMotionSlotType(int slot) const
         return Impl[slot]->GetMovementGeneratorType();
 }
 
+void MotionMaster::SyncOwnerPosition()
+{
+    if (!empty() && top())
+        top()->SyncOwnerPosition(*i_owner);
+}
+
 void MotionMaster::InitTop()
 {
     top()->Initialize(*i_owner);
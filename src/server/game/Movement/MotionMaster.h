@@ -111,6 +111,9 @@ class MotionMaster //: private std::stack<MovementGenerator *>
         _Ty top() const { return Impl[i_top]; }
         _Ty GetMotionSlot(int slot) const { return Impl[slot]; }
 
+        // Brings the owner's position up to date with the path of the active generator
+        void SyncOwnerPosition();
+
         void DirectDelete(_Ty curr);
         void DelayedDelete(_Ty curr);
 
@@ -45,6 +45,9 @@ class MovementGenerator
         virtual void unitSpeedChanged() { }
 
         virtual bool GetDestination(float& /*x*/, float& /*y*/, float& /*z*/) const { return false; }
+
+        // generators that move their owner along a path bring its position up to date here
+        virtual void SyncOwnerPosition(Unit &) { }
 };
 
 template<class T, class D>
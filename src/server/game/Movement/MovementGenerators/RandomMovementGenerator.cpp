@@ -160,6 +160,14 @@ template<>
 void
 RandomMovementGenerator<Creature>::Finalize(Creature & /*creature*/){}
 
+template<>
+void
+RandomMovementGenerator<Creature>::SyncOwnerPosition(Unit &owner)
+{
+    CreatureTraveller traveller(*owner.ToCreature());
+    i_destinationHolder.SyncTravellerPosition(traveller);
+}
+
 template<>
 bool
 RandomMovementGenerator<Creature>::Update(Creature &creature, const uint32 &diff)
@@ -29,7 +29,7 @@ class RandomMovementGenerator
 {
     public:
         // Wander dist is related on db spawn dist. So what if we wanna set eandom movement on summoned creature?!
-        RandomMovementGenerator(float spawn_dist = 0.0f) : i_nextMoveTime(0), wander_distance(spawn_dist) {}
+        RandomMovementGenerator(float spawn_dist = 0.0f) : i_nextMoveTime(0), i_destinationHolder(true), wander_distance(spawn_dist) {}
 
         void _setRandomLocation(T &);
         void Initialize(T &);
@@ -37,6 +37,7 @@ class RandomMovementGenerator
         void Reset(T &);
         bool Update(T &, const uint32 &);
         bool GetDestination(float &x, float &y, float &z) const;
+        void SyncOwnerPosition(Unit &);
         void UpdateMapPosition(uint32 mapid, float &x ,float &y, float &z)
         {
             i_destinationHolder.GetLocationNow(mapid, x,y,z);
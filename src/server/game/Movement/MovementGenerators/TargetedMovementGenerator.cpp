@@ -43,7 +43,7 @@ struct StackCleaner
 template<class T>
 TargetedMovementGenerator<T>::TargetedMovementGenerator(Unit &target, float offset, float angle)
 : TargetedMovementGeneratorBase(target)
-, i_offset(offset), i_angle(angle), i_recalculateTravel(false)
+, i_offset(offset), i_angle(angle), i_destinationHolder(true), i_recalculateTravel(false)
 {
     target.GetPosition(i_targetX, i_targetY, i_targetZ);
 }
@@ -171,6 +171,14 @@ TargetedMovementGenerator<T>::Reset(T &owner)
     Initialize(owner);
 }
 
+template<class T>
+void
+TargetedMovementGenerator<T>::SyncOwnerPosition(Unit &owner)
+{
+    Traveller<T> traveller(static_cast<T&>(owner));
+    i_destinationHolder.SyncTravellerPosition(traveller);
+}
+
 template<class T>
 bool
 TargetedMovementGenerator<T>::Update(T &owner, const uint32 & time_diff)
@@ -270,6 +278,8 @@ template void TargetedMovementGenerator<Player>::Finalize(Player &);
 template void TargetedMovementGenerator<Creature>::Finalize(Creature &);
 template void TargetedMovementGenerator<Player>::Reset(Player &);
 template void TargetedMovementGenerator<Creature>::Reset(Creature &);
+template void TargetedMovementGenerator<Player>::SyncOwnerPosition(Unit &);
+template void TargetedMovementGenerator<Creature>::SyncOwnerPosition(Unit &);
 template bool TargetedMovementGenerator<Player>::Update(Player &, const uint32 &);
 template bool TargetedMovementGenerator<Creature>::Update(Creature &, const uint32 &);
 template Unit* TargetedMovementGenerator<Player>::GetTarget() const;
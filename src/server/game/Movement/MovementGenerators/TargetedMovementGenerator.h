@@ -59,6 +59,7 @@ class TargetedMovementGenerator
         }
 
         void unitSpeedChanged() { i_recalculateTravel=true; }
+        void SyncOwnerPosition(Unit &);
     private:
 
         bool _setTargetLocation(T &);
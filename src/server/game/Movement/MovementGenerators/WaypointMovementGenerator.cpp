@@ -41,6 +41,18 @@ template<>
 void
 WaypointMovementGenerator<Player>::Finalize(Player & /*u*/){}
 
+template<>
+void
+WaypointMovementGenerator<Creature>::SyncOwnerPosition(Unit &owner)
+{
+    CreatureTraveller traveller(*owner.ToCreature());
+    i_destinationHolder.SyncTravellerPosition(traveller);
+}
+
+template<>
+void
+WaypointMovementGenerator<Player>::SyncOwnerPosition(Unit & /*owner*/){}
+
 template<class T>
 void
 WaypointMovementGenerator<T>::MovementInform(T & /*unit*/){}
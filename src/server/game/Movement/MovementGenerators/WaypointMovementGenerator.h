@@ -44,7 +44,7 @@ template<class T, class P>
 class PathMovementBase
 {
     public:
-        PathMovementBase() : i_currentNode(0) {}
+        PathMovementBase() : i_currentNode(0), i_destinationHolder(true) {}
         virtual ~PathMovementBase() {};
 
         bool MovementInProgress(void) const { return i_currentNode < i_path->size(); }
@@ -79,6 +79,7 @@ class WaypointMovementGenerator
         void Reset(T &unit);
         bool Update(T &, const uint32 &);
         bool GetDestination(float &x, float &y, float &z) const;
+        void SyncOwnerPosition(Unit &);
         MovementGeneratorType GetMovementGeneratorType() { return WAYPOINT_MOTION_TYPE; }
 
     private:
@@ -24,6 +24,7 @@
 #include "OutdoorPvPMgr.h"
 #include "ScriptLoader.h"
 #include "ScriptSystem.h"
+#include "ScriptTableCache.h"
 #include "Transport.h"
 #include "Creature.h"
 
@@ -219,6 +220,9 @@ void ScriptMgr::Initialize()
 
     sLog->outString(">> Loaded %u C++ scripts in %u ms", GetScriptCount(), GetMSTimeDiffToNow(oldMSTime));
     sLog->outString();
+
+    sLog->outString("Loading script tables...");               // tables are registered by the script constructors
+    sScriptTableCache->LoadAll();
 }
 
 void ScriptMgr::LoadDatabase()
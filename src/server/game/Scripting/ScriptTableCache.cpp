@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ScriptTableCache.h"
+#include "DatabaseEnv.h"
+#include "Timer.h"
+#include <ace/Guard_T.h>
+
+CachedTableRow::CachedTableRow(Field const* fields, char const* format)
+{
+    m_fields.resize(strlen(format));
+    for (uint32 i = 0; i < m_fields.size(); ++i)
+    {
+        CachedField& field = m_fields[i];
+        field.format = format[i];
+        switch (format[i])
+        {
+            case 'i': field.intValue = fields[i].GetUInt32(); break;
+            case 'f': field.floatValue = fields[i].GetFloat(); break;
+            case 's': field.stringValue = fields[i].GetString(); break;
+            default: ASSERT(false && "unknown script table field format");
+        }
+    }
+}
+
+CachedTableRow::CachedField const& CachedTableRow::_GetField(uint32 index, char format) const
+{
+    ASSERT(index < m_fields.size() && m_fields[index].format == format);
+    return m_fields[index];
+}
+
+void CachedTableRow::SetUInt32(uint32 index, uint32 value)
+{
+    ASSERT(index < m_fields.size() && m_fields[index].format == 'i');
+    m_fields[index].intValue = value;
+}
+
+void ScriptTableCache::RegisterTable(std::string const& name, std::string const& query, std::string const& format)
+{
+    ACE_WRITE_GUARD(ACE_RW_Thread_Mutex, guard, m_lock);
+
+    CachedTable& table = m_tables[name];
+    table.query = query;
+    table.format = format;
+    if (table.rows.null())
+        table.rows = m_emptyRows;
+}
+
+void ScriptTableCache::LoadAll()
+{
+    uint32 oldMSTime = getMSTime();
+
+    // query outside of the lock, scripts keep reading the old rows meanwhile
+    CachedTableMap tables;
+    {
+        ACE_READ_GUARD(ACE_RW_Thread_Mutex, guard, m_lock);
+        tables = m_tables;
+    }
+
+    uint32 count = 0;
+    for (CachedTableMap::iterator itr = tables.begin(); itr != tables.end(); ++itr)
+    {
+        CachedTableRows* rows = new CachedTableRows();
+        itr->second.rows = CachedTableRowsPtr(rows);
+
+        QueryResult result = WorldDatabase.Query(itr->second.query.c_str());
+        if (!result)
+        {
+            sLog->outErrorDb(">> Script table `%s` is empty or its query failed.", itr->first.c_str());
+            continue;
+        }
+
+        if (result->GetFieldCount() != itr->second.format.size())
+        {
+            sLog->outErrorDb(">> Script table `%s` selects %u fields but its format has %u, table not loaded.",
+                itr->first.c_str(), uint32(result->GetFieldCount()), uint32(itr->second.format.size()));
+            continue;
+        }
+
+        rows->reserve(uint32(result->GetRowCount()));
+        do
+        {
+            rows->push_back(CachedTableRow(result->Fetch(), itr->second.format.c_str()));
+            ++count;
+        }
+        while (result->NextRow());
+    }
+
+    {
+        ACE_WRITE_GUARD(ACE_RW_Thread_Mutex, guard, m_lock);
+        m_tables.swap(tables);
+    }
+
+    sLog->outString(">> Loaded %u rows of %lu script tables in %u ms", count, (unsigned long)m_tables.size(), GetMSTimeDiffToNow(oldMSTime));
+    sLog->outString();
+}
+
+CachedTableRowsPtr ScriptTableCache::GetRows(std::string const& name) const
+{
+    ACE_READ_GUARD_RETURN(ACE_RW_Thread_Mutex, guard, m_lock, m_emptyRows);
+
+    CachedTableMap::const_iterator itr = m_tables.find(name);
+    if (itr == m_tables.end())
+        return m_emptyRows;
+
+    return itr->second.rows;
+}
+
+uint32 ScriptTableCache::UpdateField(std::string const& name, uint32 keyField, uint32 keyValue, uint32 field, uint32 value)
+{
+    ACE_WRITE_GUARD_RETURN(ACE_RW_Thread_Mutex, guard, m_lock, 0);
+
+    CachedTableMap::iterator itr = m_tables.find(name);
+    if (itr == m_tables.end())
+        return 0;
+
+    // published rows may still be read, change a copy and publish that instead
+    CachedTableRows* rows = new CachedTableRows(*itr->second.rows);
+    uint32 count = 0;
+    for (CachedTableRows::iterator row = rows->begin(); row != rows->end(); ++row)
+    {
+        if (row->GetUInt32(keyField) != keyValue)
+            continue;
+
+        row->SetUInt32(field, value);
+        ++count;
+    }
+
+    itr->second.rows = CachedTableRowsPtr(rows);
+    return count;
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_SCRIPTTABLECACHE_H
+#define TRINITY_SCRIPTTABLECACHE_H
+
+#include "Define.h"
+#include <ace/Singleton.h>
+#include <ace/RW_Thread_Mutex.h>
+#include <ace/Refcounted_Auto_Ptr.h>
+#include <map>
+#include <string>
+#include <vector>
+
+class Field;
+
+// One row of a cached table, parsed once on load according to the format of its table:
+// 'i' integer (read as int32 or uint32), 'f' float, 's' string
+class CachedTableRow
+{
+    public:
+        CachedTableRow(Field const* fields, char const* format);
+
+        uint32 GetFieldCount() const { return uint32(m_fields.size()); }
+
+        uint32 GetUInt32(uint32 index) const { return _GetField(index, 'i').intValue; }
+        int32 GetInt32(uint32 index) const { return int32(_GetField(index, 'i').intValue); }
+        float GetFloat(uint32 index) const { return _GetField(index, 'f').floatValue; }
+        std::string const& GetString(uint32 index) const { return _GetField(index, 's').stringValue; }
+
+        void SetUInt32(uint32 index, uint32 value);
+
+    private:
+        struct CachedField
+        {
+            CachedField() : format(0), intValue(0) {}
+
+            char format;
+            union
+            {
+                uint32 intValue;
+                float floatValue;
+            };
+            std::string stringValue;
+        };
+
+        CachedField const& _GetField(uint32 index, char format) const;
+
+        std::vector<CachedField> m_fields;
+};
+
+typedef std::vector<CachedTableRow> CachedTableRows;
+// Rows are never changed once published, readers keep the rows they got while the cache moves on to new ones
+typedef ACE_Refcounted_Auto_Ptr<CachedTableRows const, ACE_Thread_Mutex> CachedTableRowsPtr;
+
+/*
+ * Small world database tables owned by custom scripts.
+ *
+ * A script registers a name and the query selecting its table from its
+ * constructor; all registered tables are loaded once after the scripts and
+ * again on ".reload script_tables", so gossip handlers read them from memory
+ * instead of querying the database on the map threads.
+ *
+ * Scripts that change a table update the cached rows with UpdateField and
+ * write the same change to the database asynchronously themselves.
+ */
+class ScriptTableCache
+{
+    friend class ACE_Singleton<ScriptTableCache, ACE_Null_Mutex>;
+    ScriptTableCache() : m_emptyRows(new CachedTableRows()) {}
+
+    public:
+        // format has one character per selected column, see CachedTableRow
+        void RegisterTable(std::string const& name, std::string const& query, std::string const& format);
+        void LoadAll();
+
+        // The current rows of the table, empty if no table was registered under that name or it is not loaded yet
+        CachedTableRowsPtr GetRows(std::string const& name) const;
+        // Sets field to value in every row whose keyField equals keyValue, returns the number of changed rows
+        uint32 UpdateField(std::string const& name, uint32 keyField, uint32 keyValue, uint32 field, uint32 value);
+
+    private:
+        struct CachedTable
+        {
+            std::string query;
+            std::string format;
+            CachedTableRowsPtr rows;
+        };
+        typedef std::map<std::string, CachedTable> CachedTableMap;
+
+        CachedTableMap m_tables;
+        CachedTableRowsPtr m_emptyRows;
+        mutable ACE_RW_Thread_Mutex m_lock;
+};
+
+#define sScriptTableCache ACE_Singleton<ScriptTableCache, ACE_Null_Mutex>::instance()
+
+#endif
@@ -40,6 +40,7 @@
 #include "Util.h"
 #include "ScriptMgr.h"
 #include "Battleground.h"
+#include "CharacterCache.h"
 
 // Playerbot mod
 #include "Config.h"
@@ -587,6 +588,8 @@ void WorldSession::HandleCharCreateOpcode(WorldPacket & recv_data)
 
     // Player created, save it now
     pNewChar->SaveToDB();
+    sCharacterCache->AddCharacter(pNewChar->GetGUIDLow(), pNewChar->GetName(), GetAccountId(), pNewChar->getRace(),
+        pNewChar->getClass(), pNewChar->getGender(), pNewChar->getLevel(), pNewChar->GetZoneId());
     charcount+=1;
 
     LoginDatabase.PExecute("DELETE FROM realmcharacters WHERE acctid= '%d' AND realmid = '%d'", GetAccountId(), realmID);
@@ -635,12 +638,11 @@ void WorldSession::HandleCharDeleteOpcode(WorldPacket & recv_data)
         return;
     }
 
-    QueryResult result = CharacterDatabase.PQuery("SELECT account,name FROM characters WHERE guid='%u'", GUID_LOPART(guid));
-    if (result)
+    CharacterCacheEntry entry;
+    if (sCharacterCache->GetCharacter(GUID_LOPART(guid), entry))
     {
-        Field *fields = result->Fetch();
-        accountId = fields[0].GetUInt32();
-        name = fields[1].GetString();
+        accountId = entry.account;
+        name = entry.name;
     }
 
     // prevent deleting other players' characters using cheating tools
@@ -689,13 +691,17 @@ void WorldSession::HandlePlayerLoginOpcode(WorldPacket & recv_data)
         return;
     }
 
-    m_charLoginCallback = CharacterDatabase.DelayQueryHolder((SQLQueryHolder*)holder);
+    // all login queries are independent selects, spread them over the async connections
+    m_charLoginCallback = CharacterDatabase.DelayQueryHolderParallel((SQLQueryHolder*)holder);
 }
 
 void WorldSession::HandlePlayerLogin(LoginQueryHolder * holder)
 {
     uint64 playerGuid = holder->GetGuid();
 
+    sLog->outDebug("WORLD: Login queries for player (GUID: %u) done in %u ms (%u ms spent in %u queries)",
+        GUID_LOPART(playerGuid), holder->GetElapsedTime(), holder->GetTotalQueryTime(), uint32(holder->GetSize()));
+
     Player* pCurrChar = new Player(this);
      // for send server info and strings (config)
     ChatHandler chH = ChatHandler(pCurrChar);
@@ -1202,6 +1208,7 @@ void WorldSession::HandleChangePlayerNameOpcodeCallBack(QueryResult result, std:
 
     CharacterDatabase.PExecute("UPDATE characters set name = '%s', at_login = at_login & ~ %u WHERE guid ='%u'", newname.c_str(), uint32(AT_LOGIN_RENAME), guidLow);
     CharacterDatabase.PExecute("DELETE FROM character_declinedname WHERE guid ='%u'", guidLow);
+    sCharacterCache->UpdateName(guidLow, newname);
 
     sLog->outChar("Account: %d (IP: %s) Character:[%s] (guid:%u) Changed name to: %s", GetAccountId(), GetRemoteAddress().c_str(), oldname.c_str(), guidLow, newname.c_str());
 
@@ -1241,7 +1248,7 @@ void WorldSession::AddPlayerBot(uint64 playerGuid)
         return;
     }
     //CharacterDatabase.DelayQueryHolder(&chrHandler, &CharacterHandler::HandlePlayerBotLoginCallback, holder);
-	m_charBotLoginCallback = CharacterDatabase.DelayQueryHolder(holder);
+	m_charBotLoginCallback = CharacterDatabase.DelayQueryHolderParallel(holder);
 
     chH.PSendSysMessage("Bot added successfully.");
 }
@@ -1490,6 +1497,7 @@ void WorldSession::HandleCharCustomize(WorldPacket& recv_data)
     Player::Customize(guid, gender, skin, face, hairStyle, hairColor, facialHair);
     CharacterDatabase.PExecute("UPDATE characters set name = '%s', at_login = at_login & ~ %u WHERE guid ='%u'", newname.c_str(), uint32(AT_LOGIN_CUSTOMIZE), GUID_LOPART(guid));
     CharacterDatabase.PExecute("DELETE FROM character_declinedname WHERE guid ='%u'", GUID_LOPART(guid));
+    sCharacterCache->UpdateName(GUID_LOPART(guid), newname);
 
     WorldPacket data(SMSG_CHAR_CUSTOMIZE, 1+8+(newname.size()+1)+6);
     data << uint8(RESPONSE_SUCCESS);
@@ -1705,6 +1713,7 @@ void WorldSession::HandleCharFactionOrRaceChange(WorldPacket& recv_data)
     SQLTransaction trans = CharacterDatabase.BeginTransaction();
     trans->PAppend("UPDATE `characters` SET name='%s', race='%u', at_login=at_login & ~ %u WHERE guid='%u'", newname.c_str(), race, used_loginFlag, lowGuid);
     trans->PAppend("DELETE FROM character_declinedname WHERE guid ='%u'", lowGuid);
+    bool guildReset = false;
 
     BattlegroundTeamId team = BG_TEAM_ALLIANCE;
 
@@ -1854,6 +1863,7 @@ void WorldSession::HandleCharFactionOrRaceChange(WorldPacket& recv_data)
         {
             // Reset guild
             trans->PAppend("DELETE FROM `guild_member` WHERE `guid`= '%u'", lowGuid);
+            guildReset = true;
         }
 
         if (!sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_ADD_FRIEND))
@@ -1922,7 +1932,14 @@ void WorldSession::HandleCharFactionOrRaceChange(WorldPacket& recv_data)
         }
     }
 
-    CharacterDatabase.CommitTransaction(trans);
+    // the cache must not get ahead of the database, so only update it once the changes are stored
+    if (CharacterDatabase.DirectCommitTransaction(trans))
+    {
+        sCharacterCache->UpdateName(lowGuid, newname);
+        sCharacterCache->UpdateRace(lowGuid, race);
+        if (guildReset)
+            sCharacterCache->UpdateGuild(lowGuid, 0, 0);
+    }
 
     std::string IP_str = GetRemoteAddress();
     sLog->outDebug("Account: %d (IP: %s), Character guid: %u Change Race/Faction to: %s", GetAccountId(), IP_str.c_str(), lowGuid, newname.c_str());
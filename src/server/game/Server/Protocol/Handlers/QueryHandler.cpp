@@ -30,6 +30,7 @@
 #include "NPCHandler.h"
 #include "Pet.h"
 #include "MapManager.h"
+#include "CharacterCache.h"
 
 void WorldSession::SendNameQueryOpcode(Player *p)
 {
@@ -58,6 +59,24 @@ void WorldSession::SendNameQueryOpcode(Player *p)
 
 void WorldSession::SendNameQueryOpcodeFromDB(uint64 guid)
 {
+    // declined names are not cached, only those realms still have to ask the database.
+    // Deleted characters are not cached either, the database answer for them is the "unknown" name.
+    CharacterCacheEntry entry;
+    if (!sWorld->getBoolConfig(CONFIG_DECLINED_NAMES_USED) && sCharacterCache->GetCharacter(GUID_LOPART(guid), entry))
+    {
+        WorldPacket data(SMSG_NAME_QUERY_RESPONSE, (8+1+1+1+1+1+1+10));
+        data.appendPackGUID(MAKE_NEW_GUID(entry.guid, 0, HIGHGUID_PLAYER));
+        data << uint8(0);                                   // added in 3.1
+        data << entry.name;
+        data << uint8(0);                                   // realm name for cross realm BG usage
+        data << uint8(entry.race);
+        data << uint8(entry.gender);
+        data << uint8(entry.playerClass);
+        data << uint8(0);                                   // is not declined
+        SendPacket(&data);
+        return;
+    }
+
     QueryResultFuture lFutureResult =
         CharacterDatabase.AsyncPQuery(
             !sWorld->getBoolConfig(CONFIG_DECLINED_NAMES_USED) ?
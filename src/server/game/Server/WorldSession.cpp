@@ -197,6 +197,15 @@ void WorldSession::SendPacket(WorldPacket const *packet)
         m_Socket->CloseSocket ();
 }
 
+WorldSocket* WorldSession::AcquireSocket()
+{
+    if (!m_Socket || m_Socket->IsClosed())
+        return NULL;
+
+    m_Socket->AddReference();
+    return m_Socket;
+}
+
 /// Add an incoming packet to the queue
 void WorldSession::QueuePacket(WorldPacket *new_packet)
 {
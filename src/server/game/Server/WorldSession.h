@@ -207,6 +207,8 @@ class WorldSession
         void WriteMovementInfo(WorldPacket *data, MovementInfo *mi);
 
         void SendPacket(WorldPacket const* packet);
+        /// Returns the client socket with a reference taken for the caller (release with RemoveReference), NULL if disconnected
+        WorldSocket* AcquireSocket();
         void SendNotification(const char *format,...) ATTR_PRINTF(2,3);
         void SendNotification(uint32 string_id,...);
         void SendPetNameInvalid(uint32 error, const std::string& name, DeclinedName *declinedName);
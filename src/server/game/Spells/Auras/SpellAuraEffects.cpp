@@ -35,6 +35,7 @@
 #include "GridNotifiersImpl.h"
 #include "CellImpl.h"
 #include "ScriptMgr.h"
+#include "ObjectPool.h"
 
 class Aura;
 //
@@ -371,6 +372,18 @@ pAuraEffectHandler AuraEffectHandler[TOTAL_AURAS]=
     &AuraEffect::HandleNoImmediateEffect,                         //316 SPELL_AURA_PERIODIC_HASTE implemented in AuraEffect::CalculatePeriodic
 };
 
+static ObjectPool* const sAuraEffectPool = new ObjectPool("AuraEffect", sizeof(AuraEffect), 512);
+
+void* AuraEffect::operator new(size_t size)
+{
+    return sAuraEffectPool->Allocate(size);
+}
+
+void AuraEffect::operator delete(void* ptr, size_t size)
+{
+    sAuraEffectPool->Deallocate(ptr, size);
+}
+
 AuraEffect::AuraEffect(Aura * base, uint8 effIndex, int32 *baseAmount, Unit * caster):
 m_base(base), m_spellProto(base->GetSpellProto()), m_effIndex(effIndex),
 m_baseAmount(baseAmount ? *baseAmount : m_spellProto->EffectBasePoints[m_effIndex]),
@@ -400,6 +413,22 @@ void AuraEffect::GetTargetList(std::list<Unit *> & targetList) const
     }
 }
 
+void AuraEffect::SetAmount(int32 amount)
+{
+    m_amount = amount;
+    m_canBeRecalculated = false;
+    _InvalidateTargetAuraModifiers();
+}
+
+void AuraEffect::_InvalidateTargetAuraModifiers() const
+{
+    // targets cache aggregated amounts of their aura effects
+    Aura::ApplicationMap const & targetMap = GetBase()->GetApplicationMap();
+    for (Aura::ApplicationMap::const_iterator appIter = targetMap.begin(); appIter != targetMap.end(); ++appIter)
+        if (appIter->second->HasEffect(GetEffIndex()))
+            appIter->second->GetTarget()->_InvalidateAuraModifiers(GetAuraType());
+}
+
 void AuraEffect::GetApplicationList(std::list<AuraApplication *> & applicationList) const
 {
     Aura::ApplicationMap const & targetMap = GetBase()->GetApplicationMap();
@@ -958,7 +987,10 @@ void AuraEffect::ChangeAmount(int32 newAmount, bool mark)
             HandleEffect(*aurEffTarget, AURA_EFFECT_HANDLE_CHANGE_AMOUNT, false);
         }
         if (!mark)
+        {
             m_amount = newAmount;
+            _InvalidateTargetAuraModifiers();
+        }
         else
             SetAmount(newAmount);
         CalculateSpellMod();
@@ -1061,9 +1093,38 @@ void AuraEffect::ApplySpellMod(Unit * target, bool apply)
     }
 }
 
+int32 AuraEffect::GetPeriodicTimer() const
+{
+    if (IsPeriodicTimerRunning())
+        return m_periodicTimer - int32(GetBase()->GetPendingUpdateTime());
+
+    return m_periodicTimer;
+}
+
+void AuraEffect::SetPeriodicTimer(int32 periodicTimer)
+{
+    GetBase()->_SyncUpdateTimers();
+    m_periodicTimer = periodicTimer;
+    GetBase()->_ScheduleUpdate();
+}
+
+void AuraEffect::ResetPeriodic(bool resetPeriodicTimer)
+{
+    m_tickNumber = 0;
+    if (resetPeriodicTimer)
+        SetPeriodicTimer(m_amplitude);
+}
+
+void AuraEffect::SetPeriodic(bool isPeriodic)
+{
+    GetBase()->_SyncUpdateTimers();
+    m_isPeriodic = isPeriodic;
+    GetBase()->_ScheduleUpdate();
+}
+
 void AuraEffect::Update(uint32 diff, Unit * caster)
 {
-    if (m_isPeriodic && (GetBase()->GetDuration() >=0 || GetBase()->IsPassive() || GetBase()->IsPermanent()))
+    if (IsPeriodicTimerRunning())
     {
         if (m_periodicTimer > int32(diff))
             m_periodicTimer -= diff;
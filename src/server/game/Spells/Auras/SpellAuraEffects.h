@@ -15,10 +15,14 @@ class AuraEffect
 {
     friend Aura::Aura(SpellEntry const* spellproto, uint8 effMask, WorldObject * owner, Unit * caster, int32 *baseAmount, Item * castItem, uint64 casterGUID);
     friend Aura::~Aura();
+    friend class Aura;
     private:
         ~AuraEffect();
         explicit AuraEffect(Aura * base, uint8 effIndex, int32 *baseAmount, Unit * caster);
     public:
+        static void* operator new(size_t size);
+        static void operator delete(void* ptr, size_t size);
+
         Unit * GetCaster() const { return GetBase()->GetCaster(); }
         uint64 GetCasterGUID() const { return GetBase()->GetCasterGUID(); }
         Aura * GetBase() const { return m_base; }
@@ -35,10 +39,10 @@ class AuraEffect
         int32 GetMiscValue() const { return m_spellProto->EffectMiscValue[m_effIndex]; }
         AuraType GetAuraType() const { return (AuraType)m_spellProto->EffectApplyAuraName[m_effIndex]; }
         int32 GetAmount() const { return m_amount; }
-        void SetAmount(int32 amount) { m_amount = amount; m_canBeRecalculated = false;}
+        void SetAmount(int32 amount);
 
-        int32 GetPeriodicTimer() const { return m_periodicTimer; }
-        void SetPeriodicTimer(int32 periodicTimer) { m_periodicTimer = periodicTimer; }
+        int32 GetPeriodicTimer() const;
+        void SetPeriodicTimer(int32 periodicTimer);
 
         int32 CalculateAmount(Unit * caster);
         void CalculatePeriodic(Unit * caster, bool create = false);
@@ -57,10 +61,11 @@ class AuraEffect
 
         uint32 GetTickNumber() const { return m_tickNumber; }
         int32 GetTotalTicks() const { return m_amplitude ? (GetBase()->GetMaxDuration() / m_amplitude) : 1;}
-        void ResetPeriodic(bool resetPeriodicTimer = false) { if (resetPeriodicTimer) m_periodicTimer = m_amplitude; m_tickNumber = 0;}
+        void ResetPeriodic(bool resetPeriodicTimer = false);
 
         bool IsPeriodic() const { return m_isPeriodic; }
-        void SetPeriodic(bool isPeriodic) { m_isPeriodic = isPeriodic; }
+        void SetPeriodic(bool isPeriodic);
+        bool IsPeriodicTimerRunning() const { return m_isPeriodic && (GetBase()->GetDuration() >= 0 || GetBase()->IsPassive() || GetBase()->IsPermanent()); }
         bool IsAffectedOnSpell(SpellEntry const *spell) const;
 
         void SendTickImmune(Unit * target, Unit *caster) const;
@@ -92,6 +97,7 @@ class AuraEffect
         int32 m_amplitude;
         uint32 m_tickNumber;
     private:
+        void _InvalidateTargetAuraModifiers() const;
         bool IsPeriodicTickCrit(Unit * target, Unit const * caster) const;
 
     public:
@@ -34,10 +34,23 @@
 #include "CellImpl.h"
 #include "ScriptMgr.h"
 #include "SpellScript.h"
+#include "ObjectPool.h"
+
+static ObjectPool* const sAuraApplicationPool = new ObjectPool("AuraApplication", sizeof(AuraApplication), 512);
+
+void* AuraApplication::operator new(size_t size)
+{
+    return sAuraApplicationPool->Allocate(size);
+}
+
+void AuraApplication::operator delete(void* ptr, size_t size)
+{
+    sAuraApplicationPool->Deallocate(ptr, size);
+}
 
 AuraApplication::AuraApplication(Unit * target, Unit * caster, Aura * aura, uint8 effMask):
 m_target(target), m_base(aura), m_slot(MAX_AURAS), m_flags(AFLAG_NONE),
-m_effectsToApply(effMask), m_removeMode(AURA_REMOVE_NONE), m_needClientUpdate(false)
+m_effectsToApply(effMask), m_removeMode(AURA_REMOVE_NONE), m_needClientUpdate(false), m_procFlags(0)
 {
     ASSERT(GetTarget() && GetBase());
 
@@ -330,13 +343,28 @@ Aura * Aura::Create(SpellEntry const* spellproto, uint8 effMask, WorldObject * o
     return aura;
 }
 
+static ObjectPool* const sAuraPool = new ObjectPool("Aura", std::max(sizeof(UnitAura), sizeof(DynObjAura)), 256);
+
+void* Aura::operator new(size_t size)
+{
+    return sAuraPool->Allocate(size);
+}
+
+void Aura::operator delete(void* ptr, size_t size)
+{
+    sAuraPool->Deallocate(ptr, size);
+}
+
 Aura::Aura(SpellEntry const* spellproto, uint8 effMask, WorldObject * owner, Unit * caster, int32 *baseAmount, Item * castItem, uint64 casterGUID):
 m_spellProto(spellproto), m_casterGuid(casterGUID ? casterGUID : caster->GetGUID()),
 m_castItemGuid(castItem ? castItem->GetGUID() : 0), m_applyTime(time(NULL)),
-m_owner(owner), m_timeCla(0), m_updateTargetMapInterval(0),
+m_owner(owner), m_timeCla(0), m_updateTargetMapInterval(0), m_updateClock(0), m_scheduledUpdateTime(0), m_updateScheduled(false),
 m_casterLevel(caster ? caster->getLevel() : m_spellProto->spellLevel), m_procCharges(0), m_stackAmount(1),
 m_isRemoved(false), m_isSingleTarget(false)
 {
+    if (GetType() == UNIT_AURA_TYPE)
+        m_updateClock = GetUnitOwner()->GetAuraUpdateClock();
+
     LoadScripts();
 
     if (m_spellProto->manaPerSecond || m_spellProto->manaPerSecondPerLevel)
@@ -686,6 +714,111 @@ void Aura::Update(uint32 diff, Unit * caster)
     }
 }
 
+// zero or negative timers are due right away
+static void _ShortenUpdateDelay(uint32 & delay, bool & hasTimer, int32 timer)
+{
+    uint32 timerDelay = timer > 0 ? uint32(timer) : 0;
+    if (!hasTimer || timerDelay < delay)
+        delay = timerDelay;
+    hasTimer = true;
+}
+
+bool Aura::GetNextUpdateDelay(uint32 & delay) const
+{
+    bool hasTimer = false;
+    delay = 0;
+
+    // expired auras are removed at next owner update
+    if (m_duration >= 0)
+    {
+        _ShortenUpdateDelay(delay, hasTimer, m_duration);
+        if (m_duration > 0 && m_timeCla)
+            _ShortenUpdateDelay(delay, hasTimer, m_timeCla);
+    }
+
+    for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
+        if (m_effects[i] && m_effects[i]->IsPeriodicTimerRunning())
+            _ShortenUpdateDelay(delay, hasTimer, m_effects[i]->m_periodicTimer);
+
+    if (_NeedsTargetMapUpdate())
+        _ShortenUpdateDelay(delay, hasTimer, m_updateTargetMapInterval);
+
+    return hasTimer;
+}
+
+bool Aura::_NeedsTargetMapUpdate() const
+{
+    if (GetType() != UNIT_AURA_TYPE)
+        return true;
+
+    // area auras have to look for new targets
+    for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
+        if (m_effects[i] && m_spellProto->Effect[i] != SPELL_EFFECT_APPLY_AURA)
+            return true;
+
+    // auras applied only on owner have nothing to refresh once fully applied,
+    // removal of the owner application reschedules the aura (see Unit::_UnapplyAura)
+    ApplicationMap::const_iterator itr = m_applications.find(GetOwner()->GetGUID());
+    return itr == m_applications.end() || itr->second->GetEffectMask() != GetEffectMask();
+}
+
+uint32 Aura::GetPendingUpdateTime() const
+{
+    // dynobj auras are updated by their owner every tick
+    if (GetType() != UNIT_AURA_TYPE)
+        return 0;
+
+    uint64 clock = GetUnitOwner()->GetAuraUpdateClock();
+    return clock > m_updateClock ? uint32(clock - m_updateClock) : 0;
+}
+
+void Aura::_SyncUpdateTimers()
+{
+    uint32 pending = GetPendingUpdateTime();
+    if (!pending)
+        return;
+
+    // aura is not due yet, so no timer can expire here and catching up is plain subtraction
+    for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
+        if (m_effects[i] && m_effects[i]->IsPeriodicTimerRunning())
+            m_effects[i]->m_periodicTimer -= pending;
+
+    if (m_duration > 0)
+    {
+        m_duration = uint32(m_duration) > pending ? m_duration - int32(pending) : 0;
+        if (uint32(m_timeCla) > pending)
+            m_timeCla -= pending;
+    }
+
+    if (m_updateTargetMapInterval > 0)
+        m_updateTargetMapInterval = uint32(m_updateTargetMapInterval) > pending ? m_updateTargetMapInterval - int32(pending) : 0;
+
+    m_updateClock += pending;
+}
+
+void Aura::_ScheduleUpdate()
+{
+    if (GetType() == UNIT_AURA_TYPE)
+        GetUnitOwner()->_ScheduleAuraUpdate(this);
+}
+
+int32 Aura::GetDuration() const
+{
+    if (m_duration > 0)
+        if (uint32 pending = GetPendingUpdateTime())
+            return uint32(m_duration) > pending ? m_duration - int32(pending) : 0;
+
+    return m_duration;
+}
+
+void Aura::SetMaxDuration(int32 duration)
+{
+    // permanent auras keep periodic timers running regardless of duration
+    _SyncUpdateTimers();
+    m_maxDuration = duration;
+    _ScheduleUpdate();
+}
+
 void Aura::SetDuration(int32 duration, bool withMods)
 {
     if (withMods)
@@ -694,7 +827,9 @@ void Aura::SetDuration(int32 duration, bool withMods)
             if (Player * modOwner = caster->GetSpellModOwner())
                 modOwner->ApplySpellMod(GetId(), SPELLMOD_DURATION, duration);
     }
+    _SyncUpdateTimers();
     m_duration = duration;
+    _ScheduleUpdate();
     SetNeedClientUpdateForTargets();
 }
 
@@ -819,6 +954,7 @@ void Aura::UnregisterSingleTarget()
 
 void Aura::SetLoadedState(int32 maxduration, int32 duration, int32 charges, uint8 stackamount, uint8 recalculateMask, int32 * amount)
 {
+    _SyncUpdateTimers();
     m_maxDuration = maxduration;
     m_duration = duration;
     m_procCharges = charges;
@@ -833,6 +969,7 @@ void Aura::SetLoadedState(int32 maxduration, int32 duration, int32 charges, uint
             m_effects[i]->CalculateSpellMod();
             m_effects[i]->RecalculateAmount(caster);
         }
+    _ScheduleUpdate();
 }
 
 bool Aura::HasEffectType(AuraType type) const
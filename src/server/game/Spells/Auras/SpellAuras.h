@@ -49,6 +49,7 @@ class AuraApplication
         uint8 m_effectsToApply;                         // Used only at spell hit to determine which effect should be applied
         AuraRemoveMode m_removeMode:8;                  // Store info for know remove aura reason
         bool m_needClientUpdate:1;
+        uint32 m_procFlags;                             // Proc flags the aura was subscribed to on the target
 
         explicit AuraApplication(Unit * target, Unit * caster, Aura * base, uint8 effMask);
         void _Remove();
@@ -57,6 +58,9 @@ class AuraApplication
         void _HandleEffect(uint8 effIndex, bool apply);
     public:
 
+        static void* operator new(size_t size);
+        static void operator delete(void* ptr, size_t size);
+
         Unit * GetTarget() const { return m_target; }
         Aura * GetBase() const { return m_base; }
 
@@ -67,6 +71,7 @@ class AuraApplication
         bool IsPositive() const { return m_flags & AFLAG_POSITIVE; }
         bool IsSelfcasted() const { return m_flags & AFLAG_CASTER; }
         uint8 GetEffectsToApply() const { return m_effectsToApply; }
+        uint32 GetProcFlags() const { return m_procFlags; }
 
         void SetRemoveMode(AuraRemoveMode mode) { m_removeMode = mode; }
         AuraRemoveMode GetRemoveMode() const {return m_removeMode;}
@@ -87,6 +92,10 @@ class Aura
         explicit Aura(SpellEntry const* spellproto, uint8 effMask, WorldObject * owner, Unit * caster, int32 *baseAmount, Item * castItem, uint64 casterGUID);
         ~Aura();
 
+        // one pool for both UnitAura and DynObjAura
+        static void* operator new(size_t size);
+        static void operator delete(void* ptr, size_t size);
+
         SpellEntry const* GetSpellProto() const { return m_spellProto; }
         uint32 GetId() const{ return GetSpellProto()->Id; }
 
@@ -114,10 +123,22 @@ class Aura
         void UpdateOwner(uint32 diff, WorldObject * owner);
         void Update(uint32 diff, Unit * caster);
 
+        // Unit auras are updated by their owner only when a timer is due, see Unit::_UpdateSpells.
+        // Timers are stored as of the owner aura clock value in m_updateClock and advanced lazily.
+        bool GetNextUpdateDelay(uint32 & delay) const;
+        uint64 GetUpdateClock() const { return m_updateClock; }
+        void SetUpdateClock(uint64 clock) { m_updateClock = clock; }
+        uint32 GetPendingUpdateTime() const;
+        bool IsUpdateScheduled() const { return m_updateScheduled; }
+        uint64 GetScheduledUpdateTime() const { return m_scheduledUpdateTime; }
+        void SetScheduledUpdate(bool scheduled, uint64 updateTime = 0) { m_updateScheduled = scheduled; m_scheduledUpdateTime = updateTime; }
+        void _SyncUpdateTimers();
+        void _ScheduleUpdate();
+
         time_t GetApplyTime() const { return m_applyTime; }
         int32 GetMaxDuration() const { return m_maxDuration; }
-        void SetMaxDuration(int32 duration) { m_maxDuration = duration; }
-        int32 GetDuration() const { return m_duration; }
+        void SetMaxDuration(int32 duration);
+        int32 GetDuration() const;
         void SetDuration(int32 duration, bool withMods = false);
         void RefreshDuration();
         bool IsExpired() const { return !GetDuration();}
@@ -181,6 +202,7 @@ class Aura
         std::list<AuraScript *> m_loadedScripts;
     private:
         void _DeleteRemovedApplications();
+        bool _NeedsTargetMapUpdate() const;
     protected:
         SpellEntry const * const m_spellProto;
         uint64 const m_casterGuid;
@@ -192,6 +214,9 @@ class Aura
         int32 m_duration;                                   // Current time
         int32 m_timeCla;                                    // Timer for power per sec calcultion
         int32 m_updateTargetMapInterval;                    // Timer for UpdateTargetMapOfEffect
+        uint64 m_updateClock;                               // Owner aura clock value the timers above are relative to
+        uint64 m_scheduledUpdateTime;                       // Owner aura clock value of the next due timer
+        bool m_updateScheduled;
 
         uint8 const m_casterLevel;                          // Aura level (store caster level for correct show level dep amount)
         uint8 m_procCharges;                                // Aura charges (0 for infinite)
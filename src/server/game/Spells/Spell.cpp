@@ -51,6 +51,7 @@
 #include "ConditionMgr.h"
 #include "DisableMgr.h"
 #include "SpellScript.h"
+#include "ObjectPool.h"
 
 #define SPELL_CHANNEL_UPDATE_INTERVAL (1 * IN_MILLISECONDS)
 
@@ -419,6 +420,18 @@ void SpellCastTargets::write (ByteBuffer & data)
         data << m_strTarget;
 }
 
+static ObjectPool* const sSpellPool = new ObjectPool("Spell", sizeof(Spell), 64);
+
+void* Spell::operator new(size_t size)
+{
+    return sSpellPool->Allocate(size);
+}
+
+void Spell::operator delete(void* ptr, size_t size)
+{
+    sSpellPool->Deallocate(ptr, size);
+}
+
 Spell::Spell(Unit* Caster, SpellEntry const *info, bool triggered, uint64 originalCasterGUID, bool skipCheck):
 m_spellInfo(sSpellMgr->GetSpellForDifficultyFromSpell(info, Caster)),
 m_caster(Caster), m_spellValue(new SpellValue(m_spellInfo))
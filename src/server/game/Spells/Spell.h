@@ -419,6 +419,9 @@ class Spell
         Spell(Unit* Caster, SpellEntry const *info, bool triggered, uint64 originalCasterGUID = 0, bool skipCheck = false);
         ~Spell();
 
+        static void* operator new(size_t size);
+        static void operator delete(void* ptr, size_t size);
+
         void prepare(SpellCastTargets const* targets, AuraEffect const * triggeredByAura = NULL);
         void cancel();
         void update(uint32 difftime);
@@ -756,6 +759,9 @@ namespace Trinity
             {
                 Unit *target = (Unit*)itr->getSource();
 
+                if (!IsInArea(target))
+                    continue;
+
                 if (!i_source->canSeeOrDetect(target, true))
                     continue;
 
@@ -798,32 +804,28 @@ namespace Trinity
                         break;
                 }
 
-                switch(i_push_type)
-                {
-                    case PUSH_SRC_CENTER:
-                    case PUSH_DST_CENTER:
-                    case PUSH_CHAIN:
-                    default:
-                        if (target->IsWithinDist3d(i_pos, i_radius))
-                            i_data->push_back(target);
-                        break;
-                    case PUSH_IN_FRONT:
-                        if (i_source->isInFront(target, i_radius, static_cast<float>(M_PI/2)))
-                            i_data->push_back(target);
-                        break;
-                    case PUSH_IN_BACK:
-                        if (i_source->isInBack(target, i_radius, static_cast<float>(M_PI/2)))
-                            i_data->push_back(target);
-                        break;
-                    case PUSH_IN_LINE:
-                        if (i_source->HasInLine(target, i_radius, i_source->GetObjectSize()))
-                            i_data->push_back(target);
-                        break;
-                    case PUSH_IN_THIN_LINE: // only traj
-                        if (i_pos->HasInLine(target, i_radius, 0))
-                            i_data->push_back(target);
-                        break;
-                }
+                i_data->push_back(target);
+            }
+        }
+
+        // area shape check, done before the more expensive visibility and faction checks
+        bool IsInArea(Unit const* target) const
+        {
+            switch(i_push_type)
+            {
+                case PUSH_SRC_CENTER:
+                case PUSH_DST_CENTER:
+                case PUSH_CHAIN:
+                default:
+                    return target->IsWithinDist3d(i_pos, i_radius);
+                case PUSH_IN_FRONT:
+                    return i_source->isInFront(target, i_radius, static_cast<float>(M_PI/2));
+                case PUSH_IN_BACK:
+                    return i_source->isInBack(target, i_radius, static_cast<float>(M_PI/2));
+                case PUSH_IN_LINE:
+                    return i_source->HasInLine(target, i_radius, i_source->GetObjectSize());
+                case PUSH_IN_THIN_LINE: // only traj
+                    return i_pos->HasInLine(target, i_radius, 0);
             }
         }
 
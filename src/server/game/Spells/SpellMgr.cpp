@@ -32,7 +32,7 @@ bool IsAreaEffectTarget[TOTAL_SPELL_TARGETS];
 SpellEffectTargetTypes EffectTargetType[TOTAL_SPELL_EFFECTS];
 SpellSelectTargetTypes SpellTargetType[TOTAL_SPELL_TARGETS];
 
-SpellMgr::SpellMgr()
+SpellMgr::SpellMgr() : mSpellRuntimeInfo(NULL)
 {
     for (int i = 0; i < TOTAL_SPELL_EFFECTS; ++i)
     {
@@ -254,6 +254,8 @@ SpellMgr::SpellMgr()
 
 SpellMgr::~SpellMgr()
 {
+    delete mSpellRuntimeInfo;
+    FreeRetiredSpellRuntimeInfo();
 }
 
 bool SpellMgr::IsSrcTargetSpell(SpellEntry const *spellInfo) const
@@ -332,6 +334,9 @@ uint32 GetSpellCastTime(SpellEntry const* spellInfo, Spell * spell)
 
 bool IsPassiveSpell(uint32 spellId)
 {
+    if (SpellRuntimeInfo const* info = sSpellMgr->GetSpellRuntimeInfo(spellId))
+        return info->flags & SPELL_RUNTIME_PASSIVE;
+
     SpellEntry const *spellInfo = sSpellStore.LookupEntry(spellId);
     if (!spellInfo)
         return false;
@@ -978,6 +983,9 @@ bool SpellMgr::_isPositiveEffect(uint32 spellId, uint32 effIndex, bool deep) con
 
 bool IsPositiveSpell(uint32 spellId)
 {
+    if (SpellRuntimeInfo const* info = sSpellMgr->GetSpellRuntimeInfo(spellId))
+        return info->flags & SPELL_RUNTIME_POSITIVE;
+
     if (!sSpellStore.LookupEntry(spellId)) // non-existing spells
         return false;
     return !(sSpellMgr->GetSpellCustomAttr(spellId) & SPELL_ATTR0_CU_NEGATIVE);
@@ -985,6 +993,9 @@ bool IsPositiveSpell(uint32 spellId)
 
 bool IsPositiveEffect(uint32 spellId, uint32 effIndex)
 {
+    if (SpellRuntimeInfo const* info = sSpellMgr->GetSpellRuntimeInfo(spellId))
+        return info->positiveEffectMask & (1 << (effIndex < MAX_SPELL_EFFECTS ? effIndex : 0));
+
     if (!sSpellStore.LookupEntry(spellId))
         return false;
     switch(effIndex)
@@ -4062,6 +4073,84 @@ void SpellMgr::LoadSpellCustomAttr()
     sLog->outString();
 }
 
+void SpellMgr::LoadSpellRuntimeInfo()
+{
+    uint32 oldMSTime = getMSTime();
+
+    // built aside from the source maps, the accessors keep answering from the published table meanwhile
+    SpellRuntimeInfoStore* store = new SpellRuntimeInfoStore();
+    store->spells.resize(GetSpellStore()->GetNumRows());
+    store->procEvents = mSpellProcEventMap;
+    store->bonuses = mSpellBonusMap;
+
+    uint32 count = 0;
+    for (uint32 i = 0; i < store->spells.size(); ++i)
+    {
+        SpellRuntimeInfo& info = store->spells[i];
+        memset(&info, 0, sizeof(info));
+        info.firstRank = i;
+        info.lastRank = i;
+
+        if (SpellChainNode const* node = GetSpellChainNode(i))
+        {
+            info.firstRank = node->first;
+            info.lastRank = node->last;
+            info.prevRank = node->prev;
+            info.nextRank = node->next;
+            info.rank = node->rank;
+        }
+
+        SpellProcEventMap::const_iterator procItr = store->procEvents.find(i);
+        if (procItr != store->procEvents.end())
+            info.procEvent = &procItr->second;
+
+        SpellBonusMap::const_iterator bonusItr = store->bonuses.find(i);
+        if (bonusItr == store->bonuses.end())
+            bonusItr = store->bonuses.find(info.firstRank);
+        if (bonusItr != store->bonuses.end())
+            info.bonus = &bonusItr->second;
+
+        // not GetSpellCustomAttr(), that answers from the table being replaced
+        if (i < mSpellCustomAttr.size())
+            info.customAttr = mSpellCustomAttr[i];
+
+        SpellEntry const* spellInfo = sSpellStore.LookupEntry(i);
+        if (!spellInfo)
+            continue;
+
+        info.procFlags = info.procEvent && info.procEvent->procFlags ? info.procEvent->procFlags : spellInfo->procFlags;
+        info.flags = SPELL_RUNTIME_EXISTS;
+
+        if (spellInfo->Attributes & SPELL_ATTR0_PASSIVE)
+            info.flags |= SPELL_RUNTIME_PASSIVE;
+        if (!(info.customAttr & SPELL_ATTR0_CU_NEGATIVE))
+            info.flags |= SPELL_RUNTIME_POSITIVE;
+
+        for (uint8 eff = 0; eff < MAX_SPELL_EFFECTS; ++eff)
+            if (!(info.customAttr & (SPELL_ATTR0_CU_NEGATIVE_EFF0 << eff)))
+                info.positiveEffectMask |= 1 << eff;
+
+        ++count;
+    }
+
+    // publish the new table. Rebuilds run on the world thread (startup and .reload), but
+    // .reload all spell does several in one tick and pointers into the replaced tables may
+    // still be held, so they are only freed at the start of the next world tick
+    if (mSpellRuntimeInfo)
+        mRetiredSpellRuntimeInfo.push_back(mSpellRuntimeInfo);
+    mSpellRuntimeInfo = store;
+
+    sLog->outString(">> Built runtime info of %u spells in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
+    sLog->outString();
+}
+
+void SpellMgr::FreeRetiredSpellRuntimeInfo()
+{
+    for (std::vector<SpellRuntimeInfoStore const*>::const_iterator itr = mRetiredSpellRuntimeInfo.begin(); itr != mRetiredSpellRuntimeInfo.end(); ++itr)
+        delete *itr;
+    mRetiredSpellRuntimeInfo.clear();
+}
+
 // Fill custom data about enchancments
 void SpellMgr::LoadEnchantCustomAttr()
 {
@@ -591,6 +591,8 @@ enum ProcFlags
    PROC_FLAG_DEATH                           = 0x01000000     // 24 Died in any way
 };
 
+#define MAX_PROC_FLAG_BITS 25
+
 #define MELEE_BASED_TRIGGER_MASK (PROC_FLAG_DONE_MELEE_AUTO_ATTACK      | \
                                   PROC_FLAG_TAKEN_MELEE_AUTO_ATTACK     | \
                                   PROC_FLAG_DONE_SPELL_MELEE_DMG_CLASS  | \
@@ -906,6 +908,39 @@ enum SpellCustomAttributes
 typedef std::vector<uint32> SpellCustomAttribute;
 typedef std::vector<bool> EnchantCustomAttribute;
 
+enum SpellRuntimeFlags
+{
+    SPELL_RUNTIME_EXISTS            = 0x01,                 // present in Spell.dbc
+    SPELL_RUNTIME_PASSIVE           = 0x02,
+    SPELL_RUNTIME_POSITIVE          = 0x04,                 // all effects positive
+};
+
+// Hot per spell data derived from the spell tables, indexed by spell id.
+// The DBC record keeps the strings and everything rarely read at runtime.
+struct SpellRuntimeInfo
+{
+    SpellProcEventEntry const* procEvent;                   // into SpellRuntimeInfoStore::procEvents
+    SpellBonusEntry const* bonus;                           // own or of the first rank, into SpellRuntimeInfoStore::bonuses
+    uint32 customAttr;                                      // including the spell_linked_spell flags
+    uint32 procFlags;                                       // SpellMgr::GetSpellProcFlags
+    uint32 firstRank;                                       // spell itself if not ranked
+    uint32 lastRank;                                        // spell itself if not ranked
+    uint32 prevRank;
+    uint32 nextRank;
+    uint8 rank;                                             // 0 if not ranked
+    uint8 flags;                                            // SpellRuntimeFlags
+    uint8 positiveEffectMask;
+};
+
+// Never modified once built, a reload publishes a new one. Holds its own copy of the proc
+// event and bonus entries so clearing the source maps can not leave the pointers dangling.
+struct SpellRuntimeInfoStore
+{
+    std::vector<SpellRuntimeInfo> spells;
+    SpellProcEventMap procEvents;
+    SpellBonusMap bonuses;
+};
+
 typedef std::map<int32, std::vector<int32> > SpellLinkedMap;
 
 inline bool IsProfessionOrRidingSkill(uint32 skill)
@@ -1026,15 +1061,39 @@ class SpellMgr
             return itr->second;
         }
 
+        // NULL for ids not present in Spell.dbc and until LoadSpellRuntimeInfo() ran
+        SpellRuntimeInfo const* GetSpellRuntimeInfo(uint32 spellId) const
+        {
+            SpellRuntimeInfo const* info = _GetSpellRuntimeInfo(spellId);
+            if (!info || !(info->flags & SPELL_RUNTIME_EXISTS))
+                return NULL;
+            return info;
+        }
+
         // Spell proc events
         SpellProcEventEntry const* GetSpellProcEvent(uint32 spellId) const
         {
+            if (SpellRuntimeInfo const* info = _GetSpellRuntimeInfo(spellId))
+                return info->procEvent;
+
             SpellProcEventMap::const_iterator itr = mSpellProcEventMap.find(spellId);
             if (itr != mSpellProcEventMap.end())
                 return &itr->second;
             return NULL;
         }
 
+        // proc flags of the spell_proc_event entry if it has any, else the spell's own
+        uint32 GetSpellProcFlags(SpellEntry const* spellInfo) const
+        {
+            if (SpellRuntimeInfo const* info = _GetSpellRuntimeInfo(spellInfo->Id))
+                return info->procFlags;
+
+            SpellProcEventEntry const* spellProcEvent = GetSpellProcEvent(spellInfo->Id);
+            if (spellProcEvent && spellProcEvent->procFlags)
+                return spellProcEvent->procFlags;
+            return spellInfo->procFlags;
+        }
+
         bool IsSpellProcEventCanTriggeredBy(SpellProcEventEntry const * spellProcEvent, uint32 EventProcFlag, SpellEntry const * procSpell, uint32 procFlags, uint32 procExtra, bool active);
 
         SpellEnchantProcEntry const* GetSpellEnchantProcEvent(uint32 enchId) const
@@ -1048,6 +1107,9 @@ class SpellMgr
         // Spell bonus data
         SpellBonusEntry const* GetSpellBonusData(uint32 spellId) const
         {
+            if (SpellRuntimeInfo const* info = _GetSpellRuntimeInfo(spellId))
+                return info->bonus;
+
             // Lookup data
             SpellBonusMap::const_iterator itr = mSpellBonusMap.find(spellId);
             if (itr != mSpellBonusMap.end())
@@ -1127,6 +1189,9 @@ class SpellMgr
 
         uint32 GetFirstSpellInChain(uint32 spell_id) const
         {
+            if (SpellRuntimeInfo const* info = _GetSpellRuntimeInfo(spell_id))
+                return info->firstRank;
+
             if (SpellChainNode const* node = GetSpellChainNode(spell_id))
                 return node->first;
 
@@ -1148,6 +1213,9 @@ class SpellMgr
 
         uint32 GetPrevSpellInChain(uint32 spell_id) const
         {
+            if (SpellRuntimeInfo const* info = _GetSpellRuntimeInfo(spell_id))
+                return info->prevRank;
+
             if (SpellChainNode const* node = GetSpellChainNode(spell_id))
                 return node->prev;
 
@@ -1156,6 +1224,9 @@ class SpellMgr
 
         uint32 GetNextSpellInChain(uint32 spell_id) const
         {
+            if (SpellRuntimeInfo const* info = _GetSpellRuntimeInfo(spell_id))
+                return info->nextRank;
+
             if (SpellChainNode const* node = GetSpellChainNode(spell_id))
                 return node->next;
 
@@ -1184,6 +1255,9 @@ class SpellMgr
 
         uint8 GetSpellRank(uint32 spell_id) const
         {
+            if (SpellRuntimeInfo const* info = _GetSpellRuntimeInfo(spell_id))
+                return info->rank;
+
             if (SpellChainNode const* node = GetSpellChainNode(spell_id))
                 return node->rank;
 
@@ -1192,6 +1266,9 @@ class SpellMgr
 
         uint32 GetLastSpellInChain(uint32 spell_id) const
         {
+            if (SpellRuntimeInfo const* info = _GetSpellRuntimeInfo(spell_id))
+                return info->lastRank;
+
             if (SpellChainNode const* node = GetSpellChainNode(spell_id))
                 return node->last;
 
@@ -1291,6 +1368,9 @@ class SpellMgr
 
         uint32 GetSpellCustomAttr(uint32 spell_id) const
         {
+            if (SpellRuntimeInfo const* info = _GetSpellRuntimeInfo(spell_id))
+                return info->customAttr;
+
             if (spell_id >= mSpellCustomAttr.size())
                 return 0;
             else
@@ -1410,8 +1490,21 @@ class SpellMgr
         void LoadPetDefaultSpells();
         void LoadSpellAreas();
         void LoadSpellGroupStackRules();
+        // must be after all other spell tables including linked spells, again after reloading any of them
+        void LoadSpellRuntimeInfo();
+        // world thread, at the start of a tick before any map update
+        void FreeRetiredSpellRuntimeInfo();
 
     private:
+        // NULL until LoadSpellRuntimeInfo() ran and for ids beyond Spell.dbc
+        SpellRuntimeInfo const* _GetSpellRuntimeInfo(uint32 spellId) const
+        {
+            SpellRuntimeInfoStore const* store = mSpellRuntimeInfo;
+            if (!store || spellId >= store->spells.size())
+                return NULL;
+            return &store->spells[spellId];
+        }
+
         bool _isPositiveSpell(uint32 spellId, bool deep) const;
         bool _isPositiveEffect(uint32 spellId, uint32 effIndex, bool deep) const;
 
@@ -1429,6 +1522,8 @@ class SpellMgr
         SkillLineAbilityMap mSkillLineAbilityMap;
         SpellPetAuraMap     mSpellPetAuraMap;
         SpellCustomAttribute  mSpellCustomAttr;
+        SpellRuntimeInfoStore const* mSpellRuntimeInfo;
+        std::vector<SpellRuntimeInfoStore const*> mRetiredSpellRuntimeInfo; // replaced during this tick, readers may still hold them
         SpellLinkedMap      mSpellLinkedMap;
         SpellGroupStackMap   mSpellGroupStack;
         SpellEnchantProcEventMap     mSpellEnchantProcEventMap;
@@ -23,6 +23,7 @@
 #include "UpdateFields.h"
 #include "ObjectMgr.h"
 #include "AccountMgr.h"
+#include "CharacterCache.h"
 
 #define DUMP_TABLE_COUNT 27
 struct DumpTable
@@ -393,6 +394,7 @@ DumpReturn PlayerDumpReader::LoadDump(const std::string& file, uint32 account, s
 
     QueryResult result = QueryResult(NULL);
     char newguid[20], chraccount[20], newpetid[20], currpetid[20], lastpetid[20];
+    uint8 race = 0, playerClass = 0, gender = 0, level = 0;
 
     // make sure the same guid doesn't already exist and is safe to use
     bool incHighest = true;
@@ -527,6 +529,11 @@ DumpReturn PlayerDumpReader::LoadDump(const std::string& file, uint32 account, s
                     ROLLBACK(DUMP_FILE_BROKEN);
                 if (!changenth(line, 70, null))             // characters.deleteDate
                     ROLLBACK(DUMP_FILE_BROKEN);
+
+                race        = uint8(atoi(getnth(line, 4).c_str()));
+                playerClass = uint8(atoi(getnth(line, 5).c_str()));
+                gender      = uint8(atoi(getnth(line, 6).c_str()));
+                level       = uint8(atoi(getnth(line, 7).c_str()));
                 break;
             }
             case DTT_CHAR_TABLE:
@@ -646,6 +653,9 @@ DumpReturn PlayerDumpReader::LoadDump(const std::string& file, uint32 account, s
 
     CharacterDatabase.CommitTransaction(trans);
 
+    // zone is resolved on first lookup
+    sCharacterCache->AddCharacter(guid, name, account, race, playerClass, gender, level, 0);
+
     sObjectMgr->m_hiItemGuid += items.size();
     sObjectMgr->m_mailid     += mails.size();
 
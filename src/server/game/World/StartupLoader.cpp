@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StartupLoader.h"
+#include "DatabaseEnv.h"
+#include "Timer.h"
+#include <ace/Guard_T.h>
+#include <ace/Method_Request.h>
+#include <algorithm>
+
+class StartupThreadStartReq : public ACE_Method_Request
+{
+    public:
+        virtual int call()
+        {
+            MySQL::Thread_Init();
+            return 0;
+        }
+};
+
+class StartupThreadEndReq : public ACE_Method_Request
+{
+    public:
+        virtual int call()
+        {
+            MySQL::Thread_End();
+            return 0;
+        }
+};
+
+class StartupTaskRequest : public ACE_Method_Request
+{
+    public:
+        StartupTaskRequest(StartupLoader& loader, StartupLoader::TaskId id) : m_loader(loader), m_id(id) {}
+
+        virtual int call()
+        {
+            m_loader.RunTask(m_id);
+            m_loader.TaskFinished(m_id);
+            return 0;
+        }
+
+    private:
+        StartupLoader& m_loader;
+        StartupLoader::TaskId m_id;
+};
+
+StartupLoader::StartupLoader() : m_totalTime(0), m_condition(m_mutex), m_finished(0)
+{
+}
+
+StartupLoader::~StartupLoader()
+{
+    for (std::vector<Task*>::iterator itr = m_tasks.begin(); itr != m_tasks.end(); ++itr)
+        delete *itr;
+}
+
+StartupLoader::TaskId StartupLoader::AddTask(char const* name, void (*func)(), TaskId dep1, TaskId dep2, TaskId dep3)
+{
+    return Add(new FuncTask(name, func), dep1, dep2, dep3);
+}
+
+StartupLoader::TaskId StartupLoader::Add(Task* task, TaskId dep1, TaskId dep2, TaskId dep3)
+{
+    TaskId id = m_tasks.size();
+    m_tasks.push_back(task);
+
+    if (dep1 != NO_TASK)
+        AddDependency(id, dep1);
+    if (dep2 != NO_TASK)
+        AddDependency(id, dep2);
+    if (dep3 != NO_TASK)
+        AddDependency(id, dep3);
+
+    return id;
+}
+
+void StartupLoader::AddDependency(TaskId task, TaskId dependency)
+{
+    // only backward edges are allowed, this keeps the graph acyclic and the declaration order valid
+    ASSERT(task < m_tasks.size() && dependency < task);
+
+    std::vector<TaskId>& dependents = m_tasks[dependency]->dependents;
+    if (std::find(dependents.begin(), dependents.end(), task) != dependents.end())
+        return;
+
+    dependents.push_back(task);
+    ++m_tasks[task]->waitingFor;
+}
+
+void StartupLoader::AddDependencyOnAll(TaskId task)
+{
+    for (TaskId dependency = 0; dependency < task; ++dependency)
+        AddDependency(task, dependency);
+}
+
+void StartupLoader::RunTask(TaskId id)
+{
+    Task* task = m_tasks[id];
+
+    sLog->outString("%s...", task->name);
+    uint32 oldMSTime = getMSTime();
+    task->Execute();
+    task->duration = GetMSTimeDiffToNow(oldMSTime);
+}
+
+void StartupLoader::Schedule(TaskId id)
+{
+    int result = m_executor.execute(new StartupTaskRequest(*this, id));
+    ASSERT(result != -1);
+}
+
+void StartupLoader::TaskFinished(TaskId id)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+
+    std::vector<TaskId> const& dependents = m_tasks[id]->dependents;
+    for (std::vector<TaskId>::const_iterator itr = dependents.begin(); itr != dependents.end(); ++itr)
+        if (--m_tasks[*itr]->waitingFor == 0)
+            Schedule(*itr);
+
+    ++m_finished;
+    m_condition.broadcast();
+}
+
+void StartupLoader::Run(uint32 threads)
+{
+    uint32 oldMSTime = getMSTime();
+
+    if (threads > 1 && m_tasks.size() > 1 && m_executor.activate(int(threads), new StartupThreadStartReq, new StartupThreadEndReq) != -1)
+    {
+        {
+            ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+
+            m_finished = 0;
+            for (TaskId id = 0; id < m_tasks.size(); ++id)
+                if (!m_tasks[id]->waitingFor)
+                    Schedule(id);
+
+            while (m_finished < m_tasks.size())
+                m_condition.wait();
+        }
+
+        m_executor.deactivate();
+    }
+    else
+    {
+        for (TaskId id = 0; id < m_tasks.size(); ++id)
+            RunTask(id);
+    }
+
+    m_totalTime = GetMSTimeDiffToNow(oldMSTime);
+}
+
+struct StartupTaskDurationOrder
+{
+    explicit StartupTaskDurationOrder(std::vector<uint32> const& durations) : m_durations(durations) {}
+
+    bool operator()(uint32 left, uint32 right) const
+    {
+        return m_durations[left] > m_durations[right];
+    }
+
+    std::vector<uint32> const& m_durations;
+};
+
+void StartupLoader::LogTimingReport() const
+{
+    std::vector<uint32> durations;
+    std::vector<TaskId> order;
+    uint32 sum = 0;
+    for (TaskId id = 0; id < m_tasks.size(); ++id)
+    {
+        durations.push_back(m_tasks[id]->duration);
+        order.push_back(id);
+        sum += m_tasks[id]->duration;
+    }
+
+    std::stable_sort(order.begin(), order.end(), StartupTaskDurationOrder(durations));
+
+    sLog->outString("Startup loader timing report (%u tasks, %u ms total task time):", uint32(m_tasks.size()), sum);
+    for (std::vector<TaskId>::const_iterator itr = order.begin(); itr != order.end(); ++itr)
+        sLog->outString("  %6u ms  %s", durations[*itr], m_tasks[*itr]->name);
+
+    sLog->outString(">> Ran %u startup tasks in %u ms", uint32(m_tasks.size()), m_totalTime);
+    sLog->outString();
+}
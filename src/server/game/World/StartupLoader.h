@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_STARTUPLOADER_H
+#define TRINITY_STARTUPLOADER_H
+
+#include "Define.h"
+#include "DelayExecutor.h"
+#include <ace/Thread_Mutex.h>
+#include <ace/Condition_Thread_Mutex.h>
+#include <vector>
+
+/*
+ * Runs the startup loaders as a dependency graph.
+ *
+ * Every loader is added as a named task together with the tasks it has to
+ * wait for. A task may only depend on tasks added before it, so the order the
+ * tasks are added in is always a valid execution order: with a single thread
+ * they simply run one after another exactly as declared. With more threads
+ * every task is handed to a worker as soon as all of its dependencies are
+ * done. Each worker uses its own synchronous database connection, so the
+ * database pools should be opened with at least as many of them.
+ */
+class StartupLoader
+{
+    public:
+        typedef uint32 TaskId;
+        static TaskId const NO_TASK = 0xFFFFFFFF;
+
+        StartupLoader();
+        ~StartupLoader();
+
+        TaskId AddTask(char const* name, void (*func)(), TaskId dep1 = NO_TASK, TaskId dep2 = NO_TASK, TaskId dep3 = NO_TASK);
+
+        template<class T>
+        TaskId AddTask(char const* name, T* object, void (T::*method)(), TaskId dep1 = NO_TASK, TaskId dep2 = NO_TASK, TaskId dep3 = NO_TASK)
+        {
+            return Add(new MethodTask<T>(name, object, method), dep1, dep2, dep3);
+        }
+
+        void AddDependency(TaskId task, TaskId dependency);
+        // Makes the task wait for every task added before it
+        void AddDependencyOnAll(TaskId task);
+
+        void Run(uint32 threads);
+        void LogTimingReport() const;
+
+        uint32 GetTaskCount() const { return m_tasks.size(); }
+
+    private:
+        friend class StartupTaskRequest;
+
+        struct Task
+        {
+            explicit Task(char const* taskName) : name(taskName), waitingFor(0), duration(0) {}
+            virtual ~Task() {}
+            virtual void Execute() = 0;
+
+            char const* name;
+            std::vector<TaskId> dependents;
+            uint32 waitingFor;
+            uint32 duration;
+        };
+
+        struct FuncTask : public Task
+        {
+            FuncTask(char const* taskName, void (*f)()) : Task(taskName), func(f) {}
+            void Execute() { func(); }
+
+            void (*func)();
+        };
+
+        template<class T>
+        struct MethodTask : public Task
+        {
+            MethodTask(char const* taskName, T* obj, void (T::*m)()) : Task(taskName), object(obj), method(m) {}
+            void Execute() { (object->*method)(); }
+
+            T* object;
+            void (T::*method)();
+        };
+
+        TaskId Add(Task* task, TaskId dep1, TaskId dep2, TaskId dep3);
+        void RunTask(TaskId id);
+        void Schedule(TaskId id);
+        void TaskFinished(TaskId id);
+
+        std::vector<Task*> m_tasks;
+        uint32 m_totalTime;
+
+        DelayExecutor m_executor;
+        ACE_Thread_Mutex m_mutex;
+        ACE_Condition_Thread_Mutex m_condition;
+        uint32 m_finished;
+};
+
+#endif
@@ -66,12 +66,15 @@
 #include "ConditionMgr.h"
 #include "DisableMgr.h"
 #include "CharacterDatabaseCleaner.h"
+#include "CharacterCache.h"
 #include "ScriptMgr.h"
 #include "WeatherMgr.h"
 #include "CreatureTextMgr.h"
 #include "AuctionHouseBot.h"
 #include "SmartAI.h"
 #include "Channel.h"
+#include "ChannelBroadcaster.h"
+#include "StartupLoader.h"
 
 volatile bool World::m_stopEvent = false;
 uint8 World::m_ExitCode = SHUTDOWN_EXIT_CODE;
@@ -121,6 +124,8 @@ World::World()
 /// World destructor
 World::~World()
 {
+    sChannelBroadcaster->Deactivate();
+
     ///- Empty the kicked session set
     while (!m_sessions.empty())
     {
@@ -652,6 +657,8 @@ void World::LoadConfigSettings(bool reload)
     if (reload)
         sMapMgr->SetMapUpdateInterval(m_int_configs[CONFIG_INTERVAL_MAPUPDATE]);
 
+    m_int_configs[CONFIG_INTERVAL_RESPAWN_SAVE] = sConfig->GetIntDefault("RespawnSaveInterval", 10 * IN_MILLISECONDS);
+
     m_int_configs[CONFIG_INTERVAL_CHANGEWEATHER] = sConfig->GetIntDefault("ChangeWeatherInterval", 10 * MINUTE * IN_MILLISECONDS);
 
     if (reload)
@@ -1019,6 +1026,7 @@ void World::LoadConfigSettings(bool reload)
 
     m_bool_configs[CONFIG_RESTRICTED_LFG_CHANNEL]      = sConfig->GetBoolDefault("Channel.RestrictedLfg", true);
     m_bool_configs[CONFIG_SILENTLY_GM_JOIN_TO_CHANNEL] = sConfig->GetBoolDefault("Channel.SilentlyGMJoin", false);
+    m_int_configs[CONFIG_CHANNEL_BROADCAST_THRESHOLD]  = sConfig->GetIntDefault("Channel.BroadcastThreshold", 200);
 
     m_bool_configs[CONFIG_TALENTS_INSPECTING]           = sConfig->GetBoolDefault("TalentsInspecting", true);
     m_bool_configs[CONFIG_CHAT_FAKE_MESSAGE_PREVENTING] = sConfig->GetBoolDefault("ChatFakeMessagePreventing", false);
@@ -1158,6 +1166,9 @@ void World::LoadConfigSettings(bool reload)
         sLog->outString("Using DataDir %s",m_dataPath.c_str());
     }
 
+    ///- Binary snapshots of the template tables, only used while loading at startup
+    SQLStorage::SetSnapshotDirectory(sConfig->GetStringDefault("StaticDataSnapshotDir", ""));
+
     m_bool_configs[CONFIG_VMAP_INDOOR_CHECK] = sConfig->GetBoolDefault("vmap.enableIndoorCheck", 0);
     bool enableIndoor = sConfig->GetBoolDefault("vmap.enableIndoorCheck", true);
     bool enableLOS = sConfig->GetBoolDefault("vmap.enableLOS", true);
@@ -1195,6 +1206,9 @@ void World::LoadConfigSettings(bool reload)
     m_int_configs[CONFIG_INTERVAL_LOG_UPDATE] = sConfig->GetIntDefault("RecordUpdateTimeDiffInterval", 60000);
     m_int_configs[CONFIG_MIN_LOG_UPDATE] = sConfig->GetIntDefault("MinRecordUpdateTimeDiff", 100);
     m_int_configs[CONFIG_NUMTHREADS] = sConfig->GetIntDefault("MapUpdate.Threads", 1);
+    m_int_configs[CONFIG_STARTUP_LOADER_THREADS] = sConfig->GetIntDefault("StartupLoader.Threads", 1);
+    if (m_int_configs[CONFIG_STARTUP_LOADER_THREADS] < 1)
+        m_int_configs[CONFIG_STARTUP_LOADER_THREADS] = 1;
     m_int_configs[CONFIG_MAX_RESULTS_LOOKUP_COMMANDS] = sConfig->GetIntDefault("Command.LookupMaxResults", 0);
 
     // chat logging
@@ -1225,6 +1239,17 @@ void World::LoadConfigSettings(bool reload)
     sScriptMgr->OnConfigLoad(reload);
 }
 
+// Startup loaders taking arguments, wrapped for the StartupLoader
+static void LoadConditionsAtStartup()
+{
+    sConditionMgr->LoadConditions();
+}
+
+static void ReturnOldMailsAtStartup()
+{
+    sObjectMgr->ReturnOrDeleteOldMails(false);
+}
+
 /// Initialize the World
 void World::SetInitialWorldSettings()
 {
@@ -1281,7 +1306,7 @@ void World::SetInitialWorldSettings()
 
     ///- Load the DBC files
     sLog->outString("Initialize data stores...");
-    LoadDBCStores(m_dataPath);
+    LoadDBCStores(m_dataPath, m_int_configs[CONFIG_STARTUP_LOADER_THREADS]);
     DetectDBCLang();
 
     sLog->outString("Loading Script Names...");
@@ -1297,352 +1322,177 @@ void World::SetInitialWorldSettings()
     sLog->outString("Cleaning up and packing instances...");
     sInstanceSaveMgr->CleanupAndPackInstances();                // must be called before `creature_respawn`/`gameobject_respawn` tables
 
-    sLog->outString("Loading Localization strings...");
-    uint32 oldMSTime = getMSTime();
-    sObjectMgr->LoadCreatureLocales();
-    sObjectMgr->LoadGameObjectLocales();
-    sObjectMgr->LoadItemLocales();
-    sObjectMgr->LoadItemSetNameLocales();
-    sObjectMgr->LoadQuestLocales();
-    sObjectMgr->LoadNpcTextLocales();
-    sObjectMgr->LoadPageTextLocales();
-    sObjectMgr->LoadGossipMenuItemsLocales();
-    sObjectMgr->LoadPointOfInterestLocales();
-
     sObjectMgr->SetDBCLocaleIndex(GetDefaultDbcLocale());        // Get once for all the locale index of DBC language (console/broadcasts)
-    sLog->outString(">> Localization strings loaded in %u ms", GetMSTimeDiffToNow(oldMSTime));
-    sLog->outString();
-
-    sLog->outString("Loading Page Texts...");
-    sObjectMgr->LoadPageTexts();
-
-    sLog->outString("Loading Game Object Templates...");         // must be after LoadPageTexts
-    sObjectMgr->LoadGameobjectInfo();
-
-    sLog->outString("Loading Spell Rank Data...");
-    sSpellMgr->LoadSpellRanks();
-
-    sLog->outString("Loading Spell Required Data...");
-    sSpellMgr->LoadSpellRequired();
-
-    sLog->outString("Loading Spell Group types...");
-    sSpellMgr->LoadSpellGroups();
-
-    sLog->outString("Loading Spell Learn Skills...");
-    sSpellMgr->LoadSpellLearnSkills();                           // must be after LoadSpellRanks
-
-    sLog->outString("Loading Spell Learn Spells...");
-    sSpellMgr->LoadSpellLearnSpells();
-
-    sLog->outString("Loading Spell Proc Event conditions...");
-    sSpellMgr->LoadSpellProcEvents();
-
-    sLog->outString("Loading Spell Bonus Data...");
-    sSpellMgr->LoadSpellBonusess();
-
-    sLog->outString("Loading Aggro Spells Definitions...");
-    sSpellMgr->LoadSpellThreats();
-
-    sLog->outString("Loading Spell Group Stack Rules...");
-    sSpellMgr->LoadSpellGroupStackRules();
-
-    sLog->outString("Loading NPC Texts...");
-    sObjectMgr->LoadGossipText();
-
-    sLog->outString("Loading Enchant Spells Proc datas...");
-    sSpellMgr->LoadSpellEnchantProcData();
-
-    sLog->outString("Loading Item Random Enchantments Table...");
-    LoadRandomEnchantmentsTable();
-
-    sLog->outString("Loading Disables");
-    sDisableMgr->LoadDisables();                                 // must be before loading quests and items
-
-    sLog->outString("Loading Items...");                         // must be after LoadRandomEnchantmentsTable and LoadPageTexts
-    sObjectMgr->LoadItemPrototypes();
-
-    sLog->outString("Loading Item set names...");                // must be after LoadItemPrototypes
-    sObjectMgr->LoadItemSetNames();
-
-    sLog->outString("Loading Creature Model Based Info Data...");
-    sObjectMgr->LoadCreatureModelInfo();
-
-    sLog->outString("Loading Equipment templates...");
-    sObjectMgr->LoadEquipmentTemplates();
-
-    sLog->outString("Loading Creature templates...");
-    sObjectMgr->LoadCreatureTemplates();
-
-    sLog->outString("Loading Vehicle scaling information...");
-    sObjectMgr->LoadVehicleScaling();
-
-    sLog->outString("Loading Reputation Reward Rates...");
-    sObjectMgr->LoadReputationRewardRate();
-
-    sLog->outString("Loading Creature Reputation OnKill Data...");
-    sObjectMgr->LoadReputationOnKill();
-
-    sLog->outString( "Loading Reputation Spillover Data..." );
-    sObjectMgr->LoadReputationSpilloverTemplate();
-
-    sLog->outString("Loading Points Of Interest Data...");
-    sObjectMgr->LoadPointsOfInterest();
-
-    sLog->outString("Loading Creature Base Stats...");
-    sObjectMgr->LoadCreatureClassLevelStats();
-
-    sLog->outString("Loading Creature Data...");
-    sObjectMgr->LoadCreatures();
-
-    sLog->outString("Loading pet levelup spells...");
-    sSpellMgr->LoadPetLevelupSpellMap();
-
-    sLog->outString("Loading pet default spells additional to levelup spells...");
-    sSpellMgr->LoadPetDefaultSpells();
-
-    sLog->outString("Loading Creature Template Addon Data...");
-    sObjectMgr->LoadCreatureAddons();                            // must be after LoadCreatureTemplates() and LoadCreatures()
-
-    sLog->outString("Loading Vehicle Accessories...");
-    sObjectMgr->LoadVehicleAccessories();                        // must be after LoadCreatureTemplates()
-
-    sLog->outString("Loading Creature Respawn Data...");         // must be after PackInstances()
-    sObjectMgr->LoadCreatureRespawnTimes();
-
-    sLog->outString("Loading Gameobject Data...");
-    sObjectMgr->LoadGameobjects();
-
-    sLog->outString("Loading Gameobject Respawn Data...");       // must be after PackInstances()
-    sObjectMgr->LoadGameobjectRespawnTimes();
-
-    sLog->outString("Loading Creature Linked Respawn...");
-    sObjectMgr->LoadLinkedRespawn();                     // must be after LoadCreatures(), LoadGameObjects()
-
-    sLog->outString("Loading Objects Pooling Data...");          // TODOLEAK: scope
-    sPoolMgr->LoadFromDB();
-
-    sLog->outString("Loading Weather Data...");
-    sWeatherMgr->LoadWeatherData();
-
-    sLog->outString("Loading Quests...");
-    sObjectMgr->LoadQuests();                                    // must be loaded after DBCs, creature_template, item_template, gameobject tables
-
-    sLog->outString("Checking Quest Disables");
-    sDisableMgr->CheckQuestDisables();                           // must be after loading quests
-
-    sLog->outString("Loading Quest POI");
-    sObjectMgr->LoadQuestPOI();
-
-    sLog->outString("Loading Quests Relations...");
-    sObjectMgr->LoadQuestRelations();                            // must be after quest load
-
-    sLog->outString("Loading Quest Pooling Data...");
-    sPoolMgr->LoadQuestPools();
-
-    sLog->outString("Loading Game Event Data...");               // must be after loading pools fully
-    sGameEventMgr->LoadFromDB();                                 // TODOLEAK: add scopes
-
-    sLog->outString("Loading Dungeon boss data...");
-    sLFGMgr->LoadDungeonEncounters();
-
-    sLog->outString("Loading LFG rewards...");
-    sLFGMgr->LoadRewards();
-
-    sLog->outString("Loading UNIT_NPC_FLAG_SPELLCLICK Data...");
-    sObjectMgr->LoadNPCSpellClickSpells();
-
-    sLog->outString("Loading SpellArea Data...");                // must be after quest load
-    sSpellMgr->LoadSpellAreas();
 
-    sLog->outString("Loading AreaTrigger definitions...");
-    sObjectMgr->LoadAreaTriggerTeleports();
-
-    sLog->outString("Loading Access Requirements...");
-    sObjectMgr->LoadAccessRequirements();                        // must be after item template load
-
-    sLog->outString("Loading Quest Area Triggers...");
-    sObjectMgr->LoadQuestAreaTriggers();                         // must be after LoadQuests
-
-    sLog->outString("Loading Tavern Area Triggers...");
-    sObjectMgr->LoadTavernAreaTriggers();
-
-    sLog->outString("Loading AreaTrigger script names...");
-    sObjectMgr->LoadAreaTriggerScripts();
-
-    sLog->outString("Loading Graveyard-zone links...");
-    sObjectMgr->LoadGraveyardZones();
-
-    sLog->outString("Loading spell pet auras...");
-    sSpellMgr->LoadSpellPetAuras();
-
-    sLog->outString("Loading spell extra attributes...");
-    sSpellMgr->LoadSpellCustomAttr();
-
-    sLog->outString("Loading Spell target coordinates...");
-    sSpellMgr->LoadSpellTargetPositions();
-
-    sLog->outString("Loading enchant custom attributes...");
-    sSpellMgr->LoadEnchantCustomAttr();
-
-    sLog->outString("Loading linked spells...");
-    sSpellMgr->LoadSpellLinked();
-
-    sLog->outString("Loading Player Create Data...");
-    sObjectMgr->LoadPlayerInfo();
-
-    sLog->outString("Loading Exploration BaseXP Data...");
-    sObjectMgr->LoadExplorationBaseXP();
-
-    sLog->outString("Loading Pet Name Parts...");
-    sObjectMgr->LoadPetNames();
-
-    CharacterDatabaseCleaner::CleanDatabase();
-
-    sLog->outString("Loading the max pet number...");
-    sObjectMgr->LoadPetNumber();
-
-    sLog->outString("Loading pet level stats...");
-    sObjectMgr->LoadPetLevelInfo();
-
-    sLog->outString("Loading Player Corpses...");
-    sObjectMgr->LoadCorpses();
-
-    sLog->outString("Loading Player level dependent mail rewards...");
-    sObjectMgr->LoadMailLevelRewards();
-
-    // Loot tables
-    LoadLootTables();                                               //TODOLEAK: untangle that shit
-
-    sLog->outString("Loading Skill Discovery Table...");
-    LoadSkillDiscoveryTable();
-
-    sLog->outString("Loading Skill Extra Item Table...");
-    LoadSkillExtraItemTable();
-
-    sLog->outString("Loading Skill Fishing base level requirements...");
-    sObjectMgr->LoadFishingBaseSkillLevel();
-
-    sLog->outString("Loading Achievements...");
-    sAchievementMgr->LoadAchievementReferenceList();
-    sLog->outString("Loading Achievement Criteria Lists...");
-    sAchievementMgr->LoadAchievementCriteriaList();
-    sLog->outString("Loading Achievement Criteria Data...");
-    sAchievementMgr->LoadAchievementCriteriaData();
-    sLog->outString("Loading Achievement Rewards...");
-    sAchievementMgr->LoadRewards();
-    sLog->outString("Loading Achievement Reward Locales...");
-    sAchievementMgr->LoadRewardLocales();
-    sLog->outString("Loading Completed Achievements...");
-    sAchievementMgr->LoadCompletedAchievements();
+    ///- Load the world and character data, dependencies between the loaders are declared explicitly
+    StartupLoader loader;
+    typedef StartupLoader::TaskId TaskId;
+
+    // static world data
+    TaskId creatureLocales = loader.AddTask("Loading Creature locales", sObjectMgr, &ObjectMgr::LoadCreatureLocales);
+    loader.AddTask("Loading Gameobject locales", sObjectMgr, &ObjectMgr::LoadGameObjectLocales);
+    TaskId itemLocales = loader.AddTask("Loading Item locales", sObjectMgr, &ObjectMgr::LoadItemLocales);
+    loader.AddTask("Loading Item set name locales", sObjectMgr, &ObjectMgr::LoadItemSetNameLocales);
+    loader.AddTask("Loading Quest locales", sObjectMgr, &ObjectMgr::LoadQuestLocales);
+    loader.AddTask("Loading NPC Text locales", sObjectMgr, &ObjectMgr::LoadNpcTextLocales);
+    loader.AddTask("Loading Page Text locales", sObjectMgr, &ObjectMgr::LoadPageTextLocales);
+    loader.AddTask("Loading Gossip menu option locales", sObjectMgr, &ObjectMgr::LoadGossipMenuItemsLocales);
+    loader.AddTask("Loading Points Of Interest locales", sObjectMgr, &ObjectMgr::LoadPointOfInterestLocales);
+
+    TaskId pageTexts = loader.AddTask("Loading Page Texts", sObjectMgr, &ObjectMgr::LoadPageTexts);
+    TaskId goTemplates = loader.AddTask("Loading Game Object Templates", sObjectMgr, &ObjectMgr::LoadGameobjectInfo, pageTexts);
+
+    // SpellMgr loaders read each other's tables, keep them in their original order
+    TaskId spellData = loader.AddTask("Loading Spell Rank Data", sSpellMgr, &SpellMgr::LoadSpellRanks);
+    spellData = loader.AddTask("Loading Spell Required Data", sSpellMgr, &SpellMgr::LoadSpellRequired, spellData);
+    spellData = loader.AddTask("Loading Spell Group types", sSpellMgr, &SpellMgr::LoadSpellGroups, spellData);
+    spellData = loader.AddTask("Loading Spell Learn Skills", sSpellMgr, &SpellMgr::LoadSpellLearnSkills, spellData);
+    spellData = loader.AddTask("Loading Spell Learn Spells", sSpellMgr, &SpellMgr::LoadSpellLearnSpells, spellData);
+    spellData = loader.AddTask("Loading Spell Proc Event conditions", sSpellMgr, &SpellMgr::LoadSpellProcEvents, spellData);
+    spellData = loader.AddTask("Loading Spell Bonus Data", sSpellMgr, &SpellMgr::LoadSpellBonusess, spellData);
+    spellData = loader.AddTask("Loading Aggro Spells Definitions", sSpellMgr, &SpellMgr::LoadSpellThreats, spellData);
+    spellData = loader.AddTask("Loading Spell Group Stack Rules", sSpellMgr, &SpellMgr::LoadSpellGroupStackRules, spellData);
+    spellData = loader.AddTask("Loading Enchant Spells Proc datas", sSpellMgr, &SpellMgr::LoadSpellEnchantProcData, spellData);
+
+    TaskId npcTexts = loader.AddTask("Loading NPC Texts", sObjectMgr, &ObjectMgr::LoadGossipText);
+    TaskId randomEnchants = loader.AddTask("Loading Item Random Enchantments Table", &LoadRandomEnchantmentsTable);
+    TaskId disables = loader.AddTask("Loading Disables", sDisableMgr, &DisableMgr::LoadDisables);
+
+    TaskId items = loader.AddTask("Loading Items", sObjectMgr, &ObjectMgr::LoadItemPrototypes, pageTexts, randomEnchants, disables);
+    loader.AddTask("Loading Item set names", sObjectMgr, &ObjectMgr::LoadItemSetNames, items);
+    loader.AddTask("Indexing Item names", sObjectMgr, &ObjectMgr::LoadItemNameIndex, items, itemLocales);
+
+    TaskId modelInfo = loader.AddTask("Loading Creature Model Based Info Data", sObjectMgr, &ObjectMgr::LoadCreatureModelInfo);
+    TaskId equipment = loader.AddTask("Loading Equipment templates", sObjectMgr, &ObjectMgr::LoadEquipmentTemplates);
+    TaskId creatureTemplates = loader.AddTask("Loading Creature templates", sObjectMgr, &ObjectMgr::LoadCreatureTemplates, modelInfo, equipment);
+    loader.AddTask("Indexing Creature names", sObjectMgr, &ObjectMgr::LoadCreatureNameIndex, creatureTemplates, creatureLocales);
+    loader.AddTask("Loading Vehicle scaling information", sObjectMgr, &ObjectMgr::LoadVehicleScaling, creatureTemplates);
+
+    loader.AddTask("Loading Reputation Reward Rates", sObjectMgr, &ObjectMgr::LoadReputationRewardRate);
+    loader.AddTask("Loading Creature Reputation OnKill Data", sObjectMgr, &ObjectMgr::LoadReputationOnKill, creatureTemplates);
+    loader.AddTask("Loading Reputation Spillover Data", sObjectMgr, &ObjectMgr::LoadReputationSpilloverTemplate);
+    loader.AddTask("Loading Points Of Interest Data", sObjectMgr, &ObjectMgr::LoadPointsOfInterest);
+    loader.AddTask("Loading Creature Base Stats", sObjectMgr, &ObjectMgr::LoadCreatureClassLevelStats, creatureTemplates);
+
+    TaskId creatures = loader.AddTask("Loading Creature Data", sObjectMgr, &ObjectMgr::LoadCreatures, creatureTemplates);
+    TaskId petSpells = loader.AddTask("Loading pet levelup spells", sSpellMgr, &SpellMgr::LoadPetLevelupSpellMap, spellData);
+    petSpells = loader.AddTask("Loading pet default spells additional to levelup spells", sSpellMgr, &SpellMgr::LoadPetDefaultSpells, petSpells, creatureTemplates);
+    loader.AddTask("Loading Creature Template Addon Data", sObjectMgr, &ObjectMgr::LoadCreatureAddons, creatures);
+    loader.AddTask("Loading Vehicle Accessories", sObjectMgr, &ObjectMgr::LoadVehicleAccessories, creatureTemplates);
+    loader.AddTask("Loading Creature Respawn Data", sObjectMgr, &ObjectMgr::LoadCreatureRespawnTimes, creatures);
+    TaskId gameobjects = loader.AddTask("Loading Gameobject Data", sObjectMgr, &ObjectMgr::LoadGameobjects, goTemplates);
+    loader.AddTask("Loading Gameobject Respawn Data", sObjectMgr, &ObjectMgr::LoadGameobjectRespawnTimes, gameobjects);
+    loader.AddTask("Loading Creature Linked Respawn", sObjectMgr, &ObjectMgr::LoadLinkedRespawn, creatures, gameobjects);
+    TaskId spawnIndex = loader.AddTask("Building Spawn Index", sObjectMgr, &ObjectMgr::FreezeSpawnIndex, creatures, gameobjects);
+
+    TaskId pools = loader.AddTask("Loading Objects Pooling Data", sPoolMgr, &PoolMgr::LoadFromDB, spawnIndex);
+    loader.AddTask("Loading Weather Data", sWeatherMgr, &WeatherMgr::LoadWeatherData);
+
+    TaskId quests = loader.AddTask("Loading Quests", sObjectMgr, &ObjectMgr::LoadQuests, items, creatureTemplates, goTemplates);
+    loader.AddDependency(quests, disables);
+    loader.AddDependency(quests, spellData);
+    // sets quest flags, everything reading quests waits for it
+    quests = loader.AddTask("Loading Quest Area Triggers", sObjectMgr, &ObjectMgr::LoadQuestAreaTriggers, quests);
+    loader.AddTask("Checking Quest Disables", sDisableMgr, &DisableMgr::CheckQuestDisables, quests);
+    loader.AddTask("Loading Quest POI", sObjectMgr, &ObjectMgr::LoadQuestPOI, quests);
+    TaskId questRelations = loader.AddTask("Loading Quests Relations", sObjectMgr, &ObjectMgr::LoadQuestRelations, quests);
+    TaskId questPools = loader.AddTask("Loading Quest Pooling Data", sPoolMgr, &PoolMgr::LoadQuestPools, pools, questRelations);
+    loader.AddTask("Loading Game Event Data", sGameEventMgr, &GameEventMgr::LoadFromDB, questPools, items);
+    loader.AddTask("Loading Dungeon boss data", sLFGMgr, &LFGMgr::LoadDungeonEncounters);
+    loader.AddTask("Loading LFG rewards", sLFGMgr, &LFGMgr::LoadRewards, quests);
+
+    loader.AddTask("Loading AreaTrigger definitions", sObjectMgr, &ObjectMgr::LoadAreaTriggerTeleports);
+    loader.AddTask("Loading Access Requirements", sObjectMgr, &ObjectMgr::LoadAccessRequirements, items, quests);
+    loader.AddTask("Loading Tavern Area Triggers", sObjectMgr, &ObjectMgr::LoadTavernAreaTriggers);
+    loader.AddTask("Loading AreaTrigger script names", sObjectMgr, &ObjectMgr::LoadAreaTriggerScripts);
+    loader.AddTask("Loading Graveyard-zone links", sObjectMgr, &ObjectMgr::LoadGraveyardZones);
+    loader.AddTask("Loading Npc Text Id", sObjectMgr, &ObjectMgr::LoadNpcTextId, creatures, npcTexts);
+
+    // these patch creature templates and spell dbc entries in place, nothing may read them meanwhile
+    TaskId spellFinal = loader.AddTask("Loading UNIT_NPC_FLAG_SPELLCLICK Data", sObjectMgr, &ObjectMgr::LoadNPCSpellClickSpells);
+    loader.AddDependencyOnAll(spellFinal);
+    spellFinal = loader.AddTask("Loading SpellArea Data", sSpellMgr, &SpellMgr::LoadSpellAreas, spellFinal);
+    spellFinal = loader.AddTask("Loading spell pet auras", sSpellMgr, &SpellMgr::LoadSpellPetAuras, spellFinal);
+    spellFinal = loader.AddTask("Loading spell extra attributes", sSpellMgr, &SpellMgr::LoadSpellCustomAttr, spellFinal);
+    spellFinal = loader.AddTask("Loading Spell target coordinates", sSpellMgr, &SpellMgr::LoadSpellTargetPositions, spellFinal);
+    spellFinal = loader.AddTask("Loading enchant custom attributes", sSpellMgr, &SpellMgr::LoadEnchantCustomAttr, spellFinal);
+    spellFinal = loader.AddTask("Loading linked spells", sSpellMgr, &SpellMgr::LoadSpellLinked, spellFinal);
+    spellFinal = loader.AddTask("Building spell runtime info", sSpellMgr, &SpellMgr::LoadSpellRuntimeInfo, spellFinal);
+
+    // everything below only starts once all static data above is complete
+    loader.AddTask("Loading Player Create Data", sObjectMgr, &ObjectMgr::LoadPlayerInfo, spellFinal);
+    loader.AddTask("Loading Exploration BaseXP Data", sObjectMgr, &ObjectMgr::LoadExplorationBaseXP, spellFinal);
+    loader.AddTask("Loading Pet Name Parts", sObjectMgr, &ObjectMgr::LoadPetNames, spellFinal);
+    loader.AddTask("Cleaning character database", &CharacterDatabaseCleaner::CleanDatabase, spellFinal);
+    loader.AddTask("Loading the max pet number", sObjectMgr, &ObjectMgr::LoadPetNumber, spellFinal);
+    loader.AddTask("Loading pet level stats", sObjectMgr, &ObjectMgr::LoadPetLevelInfo, spellFinal);
+    loader.AddTask("Loading Player Corpses", sObjectMgr, &ObjectMgr::LoadCorpses, spellFinal);
+    loader.AddTask("Loading Player level dependent mail rewards", sObjectMgr, &ObjectMgr::LoadMailLevelRewards, spellFinal);
+    TaskId loot = loader.AddTask("Loading Loot Tables", &LoadLootTables, spellFinal);
+    loader.AddTask("Loading Skill Discovery Table", &LoadSkillDiscoveryTable, spellFinal);
+    loader.AddTask("Loading Skill Extra Item Table", &LoadSkillExtraItemTable, spellFinal);
+    loader.AddTask("Loading Skill Fishing base level requirements", sObjectMgr, &ObjectMgr::LoadFishingBaseSkillLevel, spellFinal);
+
+    TaskId achievements = loader.AddTask("Loading Achievements", sAchievementMgr, &AchievementGlobalMgr::LoadAchievementReferenceList, spellFinal);
+    achievements = loader.AddTask("Loading Achievement Criteria Lists", sAchievementMgr, &AchievementGlobalMgr::LoadAchievementCriteriaList, achievements);
+    achievements = loader.AddTask("Loading Achievement Criteria Data", sAchievementMgr, &AchievementGlobalMgr::LoadAchievementCriteriaData, achievements);
+    achievements = loader.AddTask("Loading Achievement Rewards", sAchievementMgr, &AchievementGlobalMgr::LoadRewards, achievements);
+    achievements = loader.AddTask("Loading Achievement Reward Locales", sAchievementMgr, &AchievementGlobalMgr::LoadRewardLocales, achievements);
+    TaskId characterCache = loader.AddTask("Loading Character Cache", sCharacterCache, &CharacterCache::LoadFromDB, spellFinal);
+    loader.AddTask("Loading Completed Achievements", sAchievementMgr, &AchievementGlobalMgr::LoadCompletedAchievements, achievements, characterCache);
 
     ///- Load dynamic data tables from the database
-    sLog->outString("Loading Item Auctions...");
-    sAuctionMgr->LoadAuctionItems();
-    sLog->outString("Loading Auctions...");
-    sAuctionMgr->LoadAuctions();
-
-    sObjectMgr->LoadGuilds();
-
-    sLog->outString("Loading ArenaTeams...");
-    sObjectMgr->LoadArenaTeams();
-
-    sLog->outString("Loading Groups...");
-    sObjectMgr->LoadGroups();
-
-    sLog->outString("Loading ReservedNames...");
-    sObjectMgr->LoadReservedPlayersNames();
-
-    sLog->outString("Loading GameObjects for quests...");
-    sObjectMgr->LoadGameObjectForQuests();
-
-    sLog->outString("Loading BattleMasters...");
-    sBattlegroundMgr->LoadBattleMastersEntry();
-
-    sLog->outString("Loading GameTeleports...");
-    sObjectMgr->LoadGameTele();
-
-    sLog->outString("Loading Npc Text Id...");
-    sObjectMgr->LoadNpcTextId();                                 // must be after load Creature and NpcText
-
-    sObjectMgr->LoadGossipScripts();                             // must be before gossip menu options
-
-    sLog->outString("Loading Gossip menu...");
-    sObjectMgr->LoadGossipMenu();
-
-    sLog->outString("Loading Gossip menu options...");
-    sObjectMgr->LoadGossipMenuItems();
-
-    sLog->outString("Loading Vendors...");
-    sObjectMgr->LoadVendors();                                   // must be after load CreatureTemplate and ItemTemplate
-
-    sLog->outString("Loading Trainers...");
-    sObjectMgr->LoadTrainerSpell();                              // must be after load CreatureTemplate
-
-    sLog->outString("Loading Waypoints...");
-    sWaypointMgr->Load();
-
-    sLog->outString("Loading SmartAI Waypoints...");
-    sSmartWaypointMgr->LoadFromDB();
-
-    sLog->outString("Loading Creature Formations...");
-    sFormationMgr->LoadCreatureFormations();
-
-    sLog->outString("Loading Conditions...");
-    sConditionMgr->LoadConditions();
-
-    sLog->outString("Loading faction change achievement pairs...");
-    sObjectMgr->LoadFactionChangeAchievements();
-
-    sLog->outString("Loading faction change spell pairs...");
-    sObjectMgr->LoadFactionChangeSpells();
-
-    sLog->outString("Loading faction change item pairs...");
-    sObjectMgr->LoadFactionChangeItems();
-
-    sLog->outString("Loading faction change reputation pairs...");
-    sObjectMgr->LoadFactionChangeReputations();
-
-    sLog->outString("Loading GM tickets...");
-    sTicketMgr->LoadGMTickets();
-
-    sLog->outString("Loading GM surveys...");
-    sTicketMgr->LoadGMSurveys();
-
-    sLog->outString("Loading client addons...");
-    sAddonMgr->LoadFromDB();
-
+    TaskId auctions = loader.AddTask("Loading Item Auctions", sAuctionMgr, &AuctionHouseMgr::LoadAuctionItems, characterCache);
+    loader.AddTask("Loading Auctions", sAuctionMgr, &AuctionHouseMgr::LoadAuctions, auctions);
+    loader.AddTask("Loading Guilds", sObjectMgr, &ObjectMgr::LoadGuilds, characterCache);
+    loader.AddTask("Loading ArenaTeams", sObjectMgr, &ObjectMgr::LoadArenaTeams, characterCache);
+    loader.AddTask("Loading Groups", sObjectMgr, &ObjectMgr::LoadGroups, characterCache);
+    loader.AddTask("Loading ReservedNames", sObjectMgr, &ObjectMgr::LoadReservedPlayersNames, spellFinal);
+    loader.AddTask("Loading BattleMasters", sBattlegroundMgr, &BattlegroundMgr::LoadBattleMastersEntry, spellFinal);
+    loader.AddTask("Loading GameTeleports", sObjectMgr, &ObjectMgr::LoadGameTele, spellFinal);
+
+    loader.AddTask("Loading Vendors", sObjectMgr, &ObjectMgr::LoadVendors, spellFinal);
+    loader.AddTask("Loading Trainers", sObjectMgr, &ObjectMgr::LoadTrainerSpell, spellFinal);
+    TaskId waypoints = loader.AddTask("Loading Waypoints", sWaypointMgr, &WaypointStore::Load, spellFinal);
+    loader.AddTask("Loading SmartAI Waypoints", sSmartWaypointMgr, &SmartWaypointMgr::LoadFromDB, spellFinal);
+    loader.AddTask("Loading Creature Formations", sFormationMgr, &CreatureGroupManager::LoadCreatureFormations, spellFinal);
+
+    loader.AddTask("Loading faction change achievement pairs", sObjectMgr, &ObjectMgr::LoadFactionChangeAchievements, spellFinal);
+    loader.AddTask("Loading faction change spell pairs", sObjectMgr, &ObjectMgr::LoadFactionChangeSpells, spellFinal);
+    loader.AddTask("Loading faction change item pairs", sObjectMgr, &ObjectMgr::LoadFactionChangeItems, spellFinal);
+    loader.AddTask("Loading faction change reputation pairs", sObjectMgr, &ObjectMgr::LoadFactionChangeReputations, spellFinal);
+    loader.AddTask("Loading GM tickets", sTicketMgr, &TicketMgr::LoadGMTickets, spellFinal);
+    loader.AddTask("Loading GM surveys", sTicketMgr, &TicketMgr::LoadGMSurveys, spellFinal);
+    loader.AddTask("Loading client addons", sAddonMgr, &AddonMgr::LoadFromDB, spellFinal);
     ///- Handle outdated emails (delete/return)
-    sLog->outString("Returning old mails...");
-    sObjectMgr->ReturnOrDeleteOldMails(false);
-
-    sLog->outString("Loading Autobroadcasts...");
-    LoadAutobroadcasts();
-
-    ///- Load and initialize scripts
-    sObjectMgr->LoadQuestStartScripts();                         // must be after load Creature/Gameobject(Template/Data) and QuestTemplate
-    sObjectMgr->LoadQuestEndScripts();                           // must be after load Creature/Gameobject(Template/Data) and QuestTemplate
-    sObjectMgr->LoadSpellScripts();                              // must be after load Creature/Gameobject(Template/Data)
-    sObjectMgr->LoadGameObjectScripts();                         // must be after load Creature/Gameobject(Template/Data)
-    sObjectMgr->LoadEventScripts();                              // must be after load Creature/Gameobject(Template/Data)
-    sObjectMgr->LoadWaypointScripts();
-
-    sLog->outString("Loading Scripts text locales...");      // must be after Load*Scripts calls
-    sObjectMgr->LoadDbScriptStrings();
-
-    sLog->outString("Loading CreatureEventAI Texts...");
-    sEventAIMgr->LoadCreatureEventAI_Texts();
-
-    sLog->outString("Loading CreatureEventAI Summons...");
-    sEventAIMgr->LoadCreatureEventAI_Summons();
-
-    sLog->outString("Loading CreatureEventAI Scripts...");
-    sEventAIMgr->LoadCreatureEventAI_Scripts();
-
-    sLog->outString("Loading spell script names...");
-    sObjectMgr->LoadSpellScriptNames();
-
-    sLog->outString("Loading Creature Texts...");
-    sCreatureTextMgr->LoadCreatureTexts();
+    loader.AddTask("Returning old mails", &ReturnOldMailsAtStartup, characterCache);
+    loader.AddTask("Loading Autobroadcasts", this, &World::LoadAutobroadcasts, spellFinal);
+
+    ///- Load and initialize scripts, the script loaders share the script name checks and set quest flags so they run in order
+    TaskId scripts = loader.AddTask("Loading Quest start scripts", sObjectMgr, &ObjectMgr::LoadQuestStartScripts, spellFinal);
+    scripts = loader.AddTask("Loading Quest end scripts", sObjectMgr, &ObjectMgr::LoadQuestEndScripts, scripts);
+    scripts = loader.AddTask("Loading Spell scripts", sObjectMgr, &ObjectMgr::LoadSpellScripts, scripts);
+    scripts = loader.AddTask("Loading GameObject scripts", sObjectMgr, &ObjectMgr::LoadGameObjectScripts, scripts);
+    scripts = loader.AddTask("Loading Event scripts", sObjectMgr, &ObjectMgr::LoadEventScripts, scripts);
+    scripts = loader.AddTask("Loading Waypoint scripts", sObjectMgr, &ObjectMgr::LoadWaypointScripts, scripts, waypoints);
+    scripts = loader.AddTask("Loading Gossip scripts", sObjectMgr, &ObjectMgr::LoadGossipScripts, scripts);
+
+    TaskId gossip = loader.AddTask("Loading Gossip menu", sObjectMgr, &ObjectMgr::LoadGossipMenu, scripts);
+    gossip = loader.AddTask("Loading Gossip menu options", sObjectMgr, &ObjectMgr::LoadGossipMenuItems, gossip);
+    // conditions are attached to loot and gossip entries, nothing else may read the loot tables meanwhile
+    TaskId conditions = loader.AddTask("Loading Conditions", &LoadConditionsAtStartup, loot, gossip);
+    loader.AddTask("Loading GameObjects for quests", sObjectMgr, &ObjectMgr::LoadGameObjectForQuests, conditions);
+
+    // LoadTrinityStrings() is not thread safe, all its callers run in one chain
+    TaskId texts = loader.AddTask("Loading Scripts text locales", sObjectMgr, &ObjectMgr::LoadDbScriptStrings, scripts);  // must be after Load*Scripts calls
+    TaskId eventAI = loader.AddTask("Loading CreatureEventAI Texts", sEventAIMgr, &CreatureEventAIMgr::LoadCreatureEventAI_Texts, texts);
+    eventAI = loader.AddTask("Loading CreatureEventAI Summons", sEventAIMgr, &CreatureEventAIMgr::LoadCreatureEventAI_Summons, eventAI);
+    loader.AddTask("Loading CreatureEventAI Scripts", sEventAIMgr, &CreatureEventAIMgr::LoadCreatureEventAI_Scripts, eventAI);
+    loader.AddTask("Loading spell script names", sObjectMgr, &ObjectMgr::LoadSpellScriptNames, spellFinal);
+    loader.AddTask("Loading Creature Texts", sCreatureTextMgr, &CreatureTextMgr::LoadCreatureTexts, spellFinal);
+
+    loader.Run(m_int_configs[CONFIG_STARTUP_LOADER_THREADS]);
+    loader.LogTimingReport();
 
     sLog->outString("Initializing Scripts...");
     sScriptMgr->Initialize();                            //LEAKTODO
@@ -1711,6 +1561,9 @@ void World::SetInitialWorldSettings()
     // Delete all custom channels which haven't been used for PreserveCustomChannelDuration days.
     Channel::CleanOldChannelsInDB();
 
+    sLog->outString("Starting Channel Broadcast thread...");
+    sChannelBroadcaster->Activate();
+
     sLog->outString("Starting Arena Season...");
     sGameEventMgr->StartArenaSeason();
 
@@ -1901,6 +1754,9 @@ void World::Update(uint32 diff)
             m_timers[i].SetCurrent(0);
     }
 
+    ///- Free spell runtime tables replaced by a .reload during the last tick
+    sSpellMgr->FreeRetiredSpellRuntimeInfo();
+
     ///- Update the game time and check for shutdown time
     _UpdateGameTime();
 
@@ -31,6 +31,7 @@ EndScriptData */
 #include "GridNotifiers.h"
 #include "GridNotifiersImpl.h"
 #include "GossipDef.h"
+#include "ObjectPool.h"
 
 #include <fstream>
 
@@ -89,6 +90,7 @@ public:
             { "update",         SEC_ADMINISTRATOR,  false, &HandleDebugUpdateCommand,          "", NULL },
             { "itemexpire",     SEC_ADMINISTRATOR,  false, &HandleDebugItemExpireCommand,      "", NULL },
             { "areatriggers",   SEC_ADMINISTRATOR,  false, &HandleDebugAreaTriggersCommand,    "", NULL },
+            { "objectpools",    SEC_ADMINISTRATOR,  true,  &HandleDebugObjectPoolsCommand,     "", NULL },
             { NULL,             0,                  false, NULL,                               "", NULL }
         };
         static ChatCommand commandTable[] =
@@ -431,6 +433,18 @@ public:
         return true;
     }
 
+    static bool HandleDebugObjectPoolsCommand(ChatHandler* handler, const char* /*args*/)
+    {
+        std::vector<ObjectPool::Stats> stats;
+        ObjectPool::GetAllStats(stats);
+
+        for (std::vector<ObjectPool::Stats>::const_iterator itr = stats.begin(); itr != stats.end(); ++itr)
+            handler->PSendSysMessage("%s (%u bytes): %u live, %u free, %u oversized, %u KB reserved",
+                itr->name, itr->slotSize, itr->live, itr->free, itr->oversized, (itr->live + itr->free) * itr->slotSize / 1024);
+
+        return true;
+    }
+
     //Send notification in channel
     static bool HandleDebugSendChannelNotifyCommand(ChatHandler* handler, const char* args)
     {
@@ -33,6 +33,7 @@ EndScriptData */
 #include "AuctionHouseMgr.h"
 #include "CreatureTextMgr.h"
 #include "SmartAI.h"
+#include "ScriptTableCache.h"
 #include "SkillDiscovery.h"
 #include "SkillExtraItems.h"
 #include "Chat.h"
@@ -138,6 +139,7 @@ public:
             { "skill_fishing_base_level",     SEC_ADMINISTRATOR, true,  &HandleReloadSkillFishingBaseLevelCommand,      "", NULL },
             { "skinning_loot_template",       SEC_ADMINISTRATOR, true,  &HandleReloadLootTemplatesSkinningCommand,      "", NULL },
             { "smart_scripts",                SEC_ADMINISTRATOR, true,  &HandleReloadSmartScripts,                      "", NULL },
+            { "script_tables",                SEC_ADMINISTRATOR, true,  &HandleReloadScriptTablesCommand,               "", NULL },
             { "spell_required",               SEC_ADMINISTRATOR, true,  &HandleReloadSpellRequiredCommand,              "", NULL },
             { "spell_area",                   SEC_ADMINISTRATOR, true,  &HandleReloadSpellAreaCommand,                  "", NULL },
             { "spell_bonus_data",             SEC_ADMINISTRATOR, true,  &HandleReloadSpellBonusesCommand,               "", NULL },
@@ -532,6 +534,7 @@ public:
         const_cast<CreatureInfo*>(cInfo)->ScriptID = sObjectMgr->GetScriptId(fields[82].GetCString());
 
         sObjectMgr->CheckCreatureTemplate(cInfo);
+        sObjectMgr->LoadCreatureNameIndex();                // the name may have changed
 
         handler->SendGlobalGMSysMessage("Creature template reloaded.");
         return true;
@@ -875,6 +878,7 @@ public:
     {
         sLog->outString("Re-Loading Spell Linked Spells...");
         sSpellMgr->LoadSpellLinked();
+        sSpellMgr->LoadSpellRuntimeInfo();
         handler->SendGlobalGMSysMessage("DB table `spell_linked_spell` reloaded.");
         return true;
     }
@@ -883,6 +887,7 @@ public:
     {
         sLog->outString("Re-Loading Spell Proc Event conditions...");
         sSpellMgr->LoadSpellProcEvents();
+        sSpellMgr->LoadSpellRuntimeInfo();
         handler->SendGlobalGMSysMessage("DB table `spell_proc_event` (spell proc trigger requirements) reloaded.");
         return true;
     }
@@ -891,6 +896,7 @@ public:
     {
         sLog->outString("Re-Loading Spell Bonus Data...");
         sSpellMgr->LoadSpellBonusess();
+        sSpellMgr->LoadSpellRuntimeInfo();
         handler->SendGlobalGMSysMessage("DB table `spell_bonus_data` (spell damage/healing coefficients) reloaded.");
         return true;
     }
@@ -1184,6 +1190,7 @@ public:
     {
         sLog->outString("Re-Loading Locales Creature ...");
         sObjectMgr->LoadCreatureLocales();
+        sObjectMgr->LoadCreatureNameIndex();
         handler->SendGlobalGMSysMessage("DB table `locales_creature` reloaded.");
         return true;
     }
@@ -1208,6 +1215,7 @@ public:
     {
         sLog->outString("Re-Loading Locales Item ... ");
         sObjectMgr->LoadItemLocales();
+        sObjectMgr->LoadItemNameIndex();
         handler->SendGlobalGMSysMessage("DB table `locales_item` reloaded.");
         return true;
     }
@@ -1293,6 +1301,14 @@ public:
         handler->SendGlobalGMSysMessage("Smart Scripts reloaded.");
         return true;
     }
+
+    static bool HandleReloadScriptTablesCommand(ChatHandler* handler, const char* /*args*/)
+    {
+        sLog->outString("Re-Loading Script Tables...");
+        sScriptTableCache->LoadAll();
+        handler->SendGlobalGMSysMessage("Custom script tables reloaded.");
+        return true;
+    }
 };
 
 void AddSC_reload_commandscript()
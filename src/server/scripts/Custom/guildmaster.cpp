@@ -25,6 +25,7 @@ EndScriptData */
 
 #include "ScriptPCH.h"
 #include "ScriptMgr.h"
+#include "ScriptTableCache.h"
 #include "../../shared/Configuration/Config.h"
 #ifndef _TRINITY_CORE_CONFIG
 # define _TRINITY_CORE_CONFIG  "worldserver.conf"
@@ -71,6 +72,19 @@ extern WorldDatabaseWorkerPool WorldDatabase;
 
 #define GOSSIP_COUNT_MAX         10
 
+#define GUILDHOUSES_TABLE        "guildhouses"
+
+enum GuildhouseFields
+{
+	GUILDHOUSE_FIELD_ID,
+	GUILDHOUSE_FIELD_GUILD,
+	GUILDHOUSE_FIELD_X,
+	GUILDHOUSE_FIELD_Y,
+	GUILDHOUSE_FIELD_Z,
+	GUILDHOUSE_FIELD_MAP,
+	GUILDHOUSE_FIELD_COMMENT
+};
+
 
 class pryds_guildmaster : public CreatureScript
 {
@@ -79,6 +93,8 @@ class pryds_guildmaster : public CreatureScript
         pryds_guildmaster()
             : CreatureScript("pryds_guildmaster")
         {
+            sScriptTableCache->RegisterTable(GUILDHOUSES_TABLE,
+                "SELECT `id`, `guildId`, `x`, `y`, `z`, `map`, `comment` FROM `guildhouses` ORDER BY `id` ASC", "iifffis");
         }
 
         struct pryds_guildmasterAI : public ScriptedAI
@@ -94,6 +110,16 @@ bool isPlayerGuildLeader(Player *player)
 	return (player->GetRank() == 0) && (player->GetGuildId() != 0);
 }
 
+//returns the first cached guildhouse row with the given field value
+CachedTableRow const* findGuildhouse(CachedTableRows const& rows, uint32 field, uint32 value)
+{
+	for (CachedTableRows::const_iterator itr = rows.begin(); itr != rows.end(); ++itr)
+		if (itr->GetUInt32(field) == value)
+			return &*itr;
+
+	return NULL;
+}
+
 bool getGuildHouseCoords(uint32 guildId, float &x, float &y, float &z, uint32 &map)
 {
 	if (guildId == 0)
@@ -102,15 +128,13 @@ bool getGuildHouseCoords(uint32 guildId, float &x, float &y, float &z, uint32 &m
 		return false;
 	}
 
-	QueryResult result;
-	result = WorldDatabase.PQuery("SELECT `x`, `y`, `z`, `map` FROM `guildhouses` WHERE `guildId` = %u", guildId);
-	if (result)
+	CachedTableRowsPtr rows = sScriptTableCache->GetRows(GUILDHOUSES_TABLE);
+	if (CachedTableRow const* row = findGuildhouse(*rows, GUILDHOUSE_FIELD_GUILD, guildId))
 	{
-		Field *fields = result->Fetch();
-		x = fields[0].GetFloat();
-		y = fields[1].GetFloat();
-		z = fields[2].GetFloat();
-		map = fields[3].GetUInt32();
+		x = row->GetFloat(GUILDHOUSE_FIELD_X);
+		y = row->GetFloat(GUILDHOUSE_FIELD_Y);
+		z = row->GetFloat(GUILDHOUSE_FIELD_Z);
+		map = row->GetUInt32(GUILDHOUSE_FIELD_MAP);
 		return true;
 	}
 	return false;
@@ -149,30 +173,28 @@ bool showBuyList(Player *player, Creature* pCreature, uint32 showFromId = 0)
 {
 	//show not occupied guildhouses
 
-	QueryResult result;
-	result = WorldDatabase.PQuery("SELECT `id`, `comment` FROM `guildhouses` WHERE `guildId` = 0 AND `id` > %u ORDER BY `id` ASC LIMIT %u",
-		showFromId, GOSSIP_COUNT_MAX);
+	CachedTableRowsPtr rows = sScriptTableCache->GetRows(GUILDHOUSES_TABLE);
 
-	if (result)
+	//rows are cached ordered by id
+	uint32 count = 0;
+	uint32 guildhouseId = 0;
+	for (CachedTableRows::const_iterator itr = rows->begin(); itr != rows->end() && count < GOSSIP_COUNT_MAX; ++itr)
 	{
-		uint32 guildhouseId = 0;
-		std::string comment = "";
-		do
-		{
+		if (itr->GetUInt32(GUILDHOUSE_FIELD_GUILD) != 0 || itr->GetUInt32(GUILDHOUSE_FIELD_ID) <= showFromId)
+			continue;
 
-			Field *fields = result->Fetch();
+		guildhouseId = itr->GetUInt32(GUILDHOUSE_FIELD_ID);
 
-			guildhouseId = fields[0].GetInt32();
-			comment = fields[1].GetString();
-			
-			//send comment as a gossip item
-			//transmit guildhouseId in Action variable
-			player->ADD_GOSSIP_ITEM(ICON_GOSSIP_TABARD, comment, GOSSIP_SENDER_MAIN,
-				guildhouseId + OFFSET_GH_ID_TO_ACTION);
-
-		} while (result->NextRow());
+		//send comment as a gossip item
+		//transmit guildhouseId in Action variable
+		player->ADD_GOSSIP_ITEM(ICON_GOSSIP_TABARD, itr->GetString(GUILDHOUSE_FIELD_COMMENT), GOSSIP_SENDER_MAIN,
+			guildhouseId + OFFSET_GH_ID_TO_ACTION);
+		++count;
+	}
 
-		if (result->GetRowCount() == GOSSIP_COUNT_MAX)
+	if (count)
+	{
+		if (count == GOSSIP_COUNT_MAX)
 		{
 			//assume that we have additional page
 			//add link to next GOSSIP_COUNT_MAX items
@@ -186,7 +208,7 @@ bool showBuyList(Player *player, Creature* pCreature, uint32 showFromId = 0)
 		return true;
 	} else
 	{
-		if (showFromId = 0)
+		if (showFromId == 0)
 		{
 			//all guildhouses are occupied
 			pCreature->MonsterWhisper(MSG_NOFREEGH, player->GetGUID());
@@ -205,19 +227,15 @@ bool showBuyList(Player *player, Creature* pCreature, uint32 showFromId = 0)
 bool isPlayerHasGuildhouse(Player *player, Creature* pCreature, bool whisper = false)
 {
 
-	QueryResult result;
-
-	result = WorldDatabase.PQuery("SELECT `comment` FROM `guildhouses` WHERE `guildId` = %u",
-		player->GetGuildId());
+	CachedTableRowsPtr rows = sScriptTableCache->GetRows(GUILDHOUSES_TABLE);
 
-	if (result)
+	if (CachedTableRow const* row = findGuildhouse(*rows, GUILDHOUSE_FIELD_GUILD, player->GetGuildId()))
 	{
 		if (whisper)
 		{
 			//whisper to player "already have etc..."
-			Field *fields = result->Fetch();
 			char msg[100];
-			sprintf(msg, MSG_ALREADYHAVEGH, fields[0].GetString());
+			snprintf(msg, sizeof(msg), MSG_ALREADYHAVEGH, row->GetString(GUILDHOUSE_FIELD_COMMENT).c_str());
 			pCreature->MonsterWhisper(msg, player->GetGUID());
 		}
 
@@ -244,25 +262,21 @@ void buyGuildhouse(Player *player, Creature* pCreature, uint32 guildhouseId)
 		return;
 	}
 
-	QueryResult result;
+	CachedTableRowsPtr rows = sScriptTableCache->GetRows(GUILDHOUSES_TABLE);
 
 	//check if somebody already occupied this GH
-	result = WorldDatabase.PQuery("SELECT `id` FROM `guildhouses` WHERE `id` = %u AND `guildId` <> 0",
-		guildhouseId);
-
-	if (result)
+	CachedTableRow const* row = findGuildhouse(*rows, GUILDHOUSE_FIELD_ID, guildhouseId);
+	if (!row || row->GetUInt32(GUILDHOUSE_FIELD_GUILD) != 0)
 	{
 		pCreature->MonsterWhisper(MSG_GHOCCUPIED, player->GetGUID());
 		return;
 	}
 
-	//update DB
-	result = WorldDatabase.PQuery("UPDATE `guildhouses` SET `guildId` = %u WHERE `id` = %u",
+	//update cache and DB
+	sScriptTableCache->UpdateField(GUILDHOUSES_TABLE, GUILDHOUSE_FIELD_ID, guildhouseId, GUILDHOUSE_FIELD_GUILD, player->GetGuildId());
+	WorldDatabase.PExecute("UPDATE `guildhouses` SET `guildId` = %u WHERE `id` = %u",
 		player->GetGuildId(), guildhouseId);
 
-	if (result)
-		
-	player->ModifyMoney(-int32(GHBUY_COST));
 	player->ModifyMoney(-(sConfig->GetFloatDefault("pryds_guildhouseGoldCost",0)));
 	pCreature->MonsterSay(MSG_CONGRATULATIONS, LANG_UNIVERSAL, player->GetGUID());
 	
@@ -272,14 +286,9 @@ void sellGuildhouse(Player *player, Creature* pCreature)
 {
 	if (isPlayerHasGuildhouse(player, pCreature))
 	{
-		QueryResult result;
-
-		result = WorldDatabase.PQuery("UPDATE `guildhouses` SET `guildId` = 0 WHERE `guildId` = %u",
-		player->GetGuildId());
-		
-		if (result)
-			
-		player->ModifyMoney(-int32(GHSELL_COST));
+		sScriptTableCache->UpdateField(GUILDHOUSES_TABLE, GUILDHOUSE_FIELD_GUILD, player->GetGuildId(), GUILDHOUSE_FIELD_GUILD, 0);
+		WorldDatabase.PExecute("UPDATE `guildhouses` SET `guildId` = 0 WHERE `guildId` = %u",
+			player->GetGuildId());
 
 		//display message e.g. "here your money etc."
 		char msg[100];
@@ -3,48 +3,59 @@
 #include "ScriptPCH.h"
 #include "ScriptMgr.h"
 #include "DatabaseEnv.h"
+#include "ScriptTableCache.h"
 #include <cstring>
 #include <stdio.h>
 #include <time.h>
 
 #define OFFSET_THEME 10000
 
+#define THEMES_TABLE            "gurubashi_themes"
+#define SPAWNS_TABLE            "gurubashi_spawns"
+#define LASTSPAWNED_TABLE       "gurubashi_lastspawned"
+
 class npc_gurubashi_theme : public CreatureScript
 {
         public:
                 npc_gurubashi_theme()
-                        : CreatureScript("npc_gurubashi_theme")
+                        : CreatureScript("npc_gurubashi_theme"), lastThemeTime(0), lastThemeTimeLoaded(false)
                 {
+                        sScriptTableCache->RegisterTable(THEMES_TABLE, "SELECT `id`, `name` FROM `gurubashi_themes`", "is");
+                        sScriptTableCache->RegisterTable(SPAWNS_TABLE, "SELECT `theme`, `x`, `y`, `z`, `o`, `entry` FROM `gurubashi_spawns`", "iffffi");
+                        sScriptTableCache->RegisterTable(LASTSPAWNED_TABLE, "SELECT `time` FROM `gurubashi_lastspawned`", "i");
                 }
 
-                bool GetLastThemeTime()
+                uint32 GetLastThemeTime()
                 {
-                        QueryResult result;
-                        result = WorldDatabase.PQuery("SELECT `time` FROM `gurubashi_lastspawned`");
-
-                        if (result)
+                        // the cached table only provides the value saved before startup, later changes are kept here
+                        if (!lastThemeTimeLoaded)
                         {
-                                Field *fields = result->Fetch();
-                                return fields[0].GetInt32();
+                                CachedTableRowsPtr rows = sScriptTableCache->GetRows(LASTSPAWNED_TABLE);
+                                if (!rows->empty())
+                                        lastThemeTime = (*rows)[0].GetUInt32(0);
+                                lastThemeTimeLoaded = true;
                         }
-                        else return 0;
+                        return lastThemeTime;
+                }
+
+                void SetLastThemeTime(uint32 time)
+                {
+                        lastThemeTime = time;
+                        lastThemeTimeLoaded = true;
+
+                        SQLTransaction trans = WorldDatabase.BeginTransaction();
+                        trans->Append("DELETE FROM `gurubashi_lastspawned`");
+                        trans->PAppend("INSERT INTO `gurubashi_lastspawned` VALUES (%u)", time);
+                        WorldDatabase.CommitTransaction(trans);
                 }
                 
                 bool OnGossipHello(Player *player, Creature *_Creature)
                 {
                         if (GetLastThemeTime() + 600 <= time (NULL))
                         {
-                                QueryResult result;
-                                result = WorldDatabase.PQuery("SELECT `id`, `name` FROM `gurubashi_themes`");
-                                if (result)
-                                {
-                                        do
-                                        {
-                                                Field *fields = result->Fetch();
-                                                player->ADD_GOSSIP_ITEM(4, fields[1].GetString(), GOSSIP_SENDER_MAIN, OFFSET_THEME + fields[0].GetInt32());
-                                        }
-                                        while (result->NextRow());
-                                }
+                                CachedTableRowsPtr rows = sScriptTableCache->GetRows(THEMES_TABLE);
+                                for (CachedTableRows::const_iterator itr = rows->begin(); itr != rows->end(); ++itr)
+                                        player->ADD_GOSSIP_ITEM(4, itr->GetString(1), GOSSIP_SENDER_MAIN, OFFSET_THEME + itr->GetInt32(0));
                         }
                         else
                         {
@@ -65,21 +76,21 @@ class npc_gurubashi_theme : public CreatureScript
                 {
                         if (action > OFFSET_THEME)
                         {
-                                QueryResult result;
-                                result = WorldDatabase.PQuery("DELETE FROM `gurubashi_lastspawned`");
-                                result = WorldDatabase.PQuery("INSERT INTO `gurubashi_lastspawned` VALUES (%u)", time (NULL));
-                                result = WorldDatabase.PQuery("SELECT `x`, `y`, `z`, `o`, `entry` FROM `gurubashi_spawns` WHERE `theme` = %u", action - OFFSET_THEME);
-                                if (result)
+                                SetLastThemeTime(uint32(time (NULL)));
+
+                                CachedTableRowsPtr rows = sScriptTableCache->GetRows(SPAWNS_TABLE);
+                                bool spawned = false;
+                                for (CachedTableRows::const_iterator itr = rows->begin(); itr != rows->end(); ++itr)
                                 {
-                                        _Creature->MonsterSay("Spawning gameobjects..", LANG_UNIVERSAL, player->GetGUID());
-                                        do
-                                        {
-                                                Field *fields = result->Fetch();
-                                                _Creature->SummonGameObject(fields[4].GetInt32(), fields[0].GetFloat(), fields[1].GetFloat(), fields[2].GetFloat(), fields[3].GetFloat(), 0, 0, 0, 0, -600);
-                                        }
-                                        while (result->NextRow());
+                                        if (itr->GetUInt32(0) != action - OFFSET_THEME)
+                                                continue;
+
+                                        if (!spawned)
+                                                _Creature->MonsterSay("Spawning gameobjects..", LANG_UNIVERSAL, player->GetGUID());
+                                        spawned = true;
+                                        _Creature->SummonGameObject(itr->GetInt32(5), itr->GetFloat(1), itr->GetFloat(2), itr->GetFloat(3), itr->GetFloat(4), 0, 0, 0, 0, -600);
                                 }
-                                else
+                                if (!spawned)
                                 {
                                         _Creature->MonsterSay("No gameobjects found.", LANG_UNIVERSAL, player->GetGUID());
                                 }
@@ -99,6 +110,10 @@ class npc_gurubashi_theme : public CreatureScript
                         }
                         return true;
                 }
+
+        private:
+                uint32 lastThemeTime;
+                bool lastThemeTimeLoaded;
 };
 
 void AddSC_npc_gurubashi_theme()
@@ -87,12 +87,7 @@ class ItemRequester : public CreatureScript
 					pPlayer->CLOSE_GOSSIP_MENU();
 					uint32 itemId = atol(pCode);
 					if(itemId == 0)
-					{
-						std::string escapedCode = pCode;
-						WorldDatabase.escape_string(escapedCode);
-						if(QueryResult queryResult = WorldDatabase.PQuery("SELECT `entry` FROM `item_template` WHERE `name` = '%s'", escapedCode.c_str()))
-							itemId = queryResult->Fetch()[0].GetUInt32();
-					}
+						itemId = sObjectMgr->GetItemEntryByName(pCode, pPlayer->GetSession()->GetSessionDbLocaleIndex());
 
 					const ItemPrototype *itemProto = sObjectMgr->GetItemPrototype(itemId);
 					if(itemProto == NULL)
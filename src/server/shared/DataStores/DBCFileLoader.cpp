@@ -22,72 +22,74 @@
 
 #include "DBCFileLoader.h"
 
+#include <ace/Mem_Map.h>
+
 DBCFileLoader::DBCFileLoader()
 {
     data = NULL;
     fieldsOffset = NULL;
+    fileMap = NULL;
+}
+
+void DBCFileLoader::Unload()
+{
+    delete fileMap;
+    fileMap = NULL;
+    data = NULL;
+
+    delete [] fieldsOffset;
+    fieldsOffset = NULL;
 }
 
 bool DBCFileLoader::Load(const char *filename, const char *fmt)
 {
-    uint32 header;
-    if (data)
+    Unload();
+
+    // the file is mapped instead of read, only the pages actually used get loaded
+    fileMap = new ACE_Mem_Map();
+    if (fileMap->map(ACE_TEXT_CHAR_TO_TCHAR(filename), static_cast<size_t>(-1), O_RDONLY, ACE_DEFAULT_FILE_PERMS, PROT_READ, ACE_MAP_PRIVATE) == -1)
     {
-        delete [] data;
-        data = NULL;
+        Unload();
+        return false;
     }
 
-    FILE * f = fopen(filename,"rb");
-    if (!f)
-        return false;
+    unsigned char* file = static_cast<unsigned char*>(fileMap->addr());
+    size_t fileSize = fileMap->size();
 
-    if (fread(&header,4,1,f) != 1)                           // Number of records
+    uint32 header;
+    if (fileSize < 5 * 4)
     {
-        fclose(f);
+        Unload();
         return false;
     }
 
-
+    memcpy(&header, file, 4);
     EndianConvert(header);
 
     if (header != 0x43424457)                                //'WDBC'
     {
-        fclose(f);
-        return false;
-    }
-
-    if (fread(&recordCount,4,1,f) != 1)                      // Number of records
-    {
-        fclose(f);
+        Unload();
         return false;
     }
 
+    memcpy(&recordCount, file + 4, 4);                      // Number of records
     EndianConvert(recordCount);
 
-    if (fread(&fieldCount,4,1,f) != 1)                       // Number of fields
-    {
-        fclose(f);
-        return false;
-    }
-
+    memcpy(&fieldCount, file + 8, 4);                       // Number of fields
     EndianConvert(fieldCount);
 
-    if (fread(&recordSize,4,1,f) != 1)                       // Size of a record
-    {
-        fclose(f);
-        return false;
-    }
-
+    memcpy(&recordSize, file + 12, 4);                      // Size of a record
     EndianConvert(recordSize);
 
-    if (fread(&stringSize,4,1,f) != 1)                       // String size
+    memcpy(&stringSize, file + 16, 4);                      // String size
+    EndianConvert(stringSize);
+
+    if (fileSize - 5 * 4 < uint64(recordSize) * recordCount + stringSize)
     {
-        fclose(f);
+        Unload();
         return false;
     }
 
-    EndianConvert(stringSize);
-
     fieldsOffset = new uint32[fieldCount];
     fieldsOffset[0] = 0;
     for (uint32 i = 1; i < fieldCount; i++)
@@ -99,27 +101,15 @@ bool DBCFileLoader::Load(const char *filename, const char *fmt)
             fieldsOffset[i] += 4;
     }
 
-    data = new unsigned char[recordSize*recordCount+stringSize];
+    data = file + 5 * 4;
     stringTable = data + recordSize*recordCount;
 
-    if (fread(data,recordSize*recordCount+stringSize,1,f) != 1)
-    {
-        fclose(f);
-        return false;
-    }
-
-    fclose(f);
-
     return true;
 }
 
 DBCFileLoader::~DBCFileLoader()
 {
-    if (data)
-        delete [] data;
-
-    if (fieldsOffset)
-        delete [] fieldsOffset;
+    Unload();
 }
 
 DBCFileLoader::Record DBCFileLoader::getRecord(size_t id)
@@ -249,6 +239,40 @@ char* DBCFileLoader::AutoProduceData(const char* format, uint32& records, char**
     return dataTable;
 }
 
+bool DBCFileLoader::HasStringsToFill(const char* format, char const* dataTable)
+{
+    if (strlen(format)!=fieldCount)
+        return false;
+
+    uint32 offset=0;
+
+    for (uint32 y =0; y<recordCount; y++)
+    {
+        for (uint32 x=0; x<fieldCount; x++)
+            switch(format[x])
+        {
+            case FT_FLOAT:
+            case FT_IND:
+            case FT_INT:
+                offset+=4;
+                break;
+            case FT_BYTE:
+                offset+=1;
+                break;
+            case FT_STRING:
+            {
+                char const* slot = *(char* const*)(&dataTable[offset]);
+                if ((!slot || !*slot) && *getRecord(y).getString(x))
+                    return true;
+                offset+=sizeof(char*);
+                break;
+            }
+        }
+    }
+
+    return false;
+}
+
 char* DBCFileLoader::AutoProduceStrings(const char* format, char* dataTable)
 {
     if (strlen(format)!=fieldCount)
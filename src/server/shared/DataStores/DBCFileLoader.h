@@ -22,6 +22,8 @@
 #include "Utilities/ByteConverter.h"
 #include <cassert>
 
+class ACE_Mem_Map;
+
 enum
 {
     FT_NA='x',                                              //not used or unknown, 4 byte size
@@ -44,6 +46,7 @@ class DBCFileLoader
         ~DBCFileLoader();
 
         bool Load(const char *filename, const char *fmt);
+        void Unload();
 
         class Record
         {
@@ -96,6 +99,8 @@ class DBCFileLoader
         bool IsLoaded() const { return data != NULL; }
         char* AutoProduceData(const char* fmt, uint32& count, char**& indexTable, uint32 sqlRecordCount, uint32 sqlHighestIndex, char *& sqlDataTable);
         char* AutoProduceStrings(const char* fmt, char* dataTable);
+        // True if the file has a non empty string for any string slot of dataTable that is still empty
+        bool HasStringsToFill(const char* fmt, char const* dataTable);
         static uint32 GetFormatRecordSize(const char * format, int32 * index_pos = NULL);
     private:
 
@@ -106,5 +111,6 @@ class DBCFileLoader
         uint32 *fieldsOffset;
         unsigned char *data;
         unsigned char *stringTable;
+        ACE_Mem_Map *fileMap;
 };
 #endif
@@ -231,12 +231,18 @@ class DBCStorage
             if(!indexTable)
                 return false;
 
+            // stores without strings take nothing from the locale files
+            if (!strchr(fmt, FT_STRING))
+                return true;
+
             DBCFileLoader dbc;
             // Check if load was successful, only then continue
             if(!dbc.Load(fn, fmt))
                 return false;
 
-            m_stringPoolList.push_back(dbc.AutoProduceStrings(fmt,(char*)m_dataTable));
+            // only empty strings are taken from locale files, skip the string table copy if there are none to fill
+            if (dbc.HasStringsToFill(fmt, (char*)m_dataTable))
+                m_stringPoolList.push_back(dbc.AutoProduceStrings(fmt,(char*)m_dataTable));
 
             return true;
         }
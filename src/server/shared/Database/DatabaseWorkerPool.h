@@ -30,6 +30,7 @@
 #include "QueryResult.h"
 #include "QueryHolder.h"
 #include "AdhocStatement.h"
+#include "Timer.h"
 
 class PingOperation : public SQLOperation
 {
@@ -316,11 +317,28 @@ class DatabaseWorkerPool
         QueryResultHolderFuture DelayQueryHolder(SQLQueryHolder* holder)
         {
             QueryResultHolderFuture res;
+            holder->SetStartTime(getMSTime());
             SQLQueryHolderTask* task = new SQLQueryHolderTask(holder, res);
             Enqueue(task);
             return res;     //! Fool compiler, has no use yet
         }
 
+        //! Same as DelayQueryHolder, but every query of the holder is enqueued separately so the independent
+        //! queries are spread over all asynchronous connections. The future is set when the last result arrives.
+        //! Queries must not depend on each other's side effects since their execution order is undefined.
+        QueryResultHolderFuture DelayQueryHolderParallel(SQLQueryHolder* holder)
+        {
+            if (m_connectionCount[IDX_ASYNC] < 2 || holder->GetSize() < 2)
+                return DelayQueryHolder(holder);
+
+            QueryResultHolderFuture res;
+            holder->SetStartTime(getMSTime());
+            holder->m_pendingQueries = long(holder->GetSize());
+            for (size_t i = 0; i < holder->GetSize(); ++i)
+                Enqueue(new SQLQueryHolderPartTask(holder, i, res));
+            return res;
+        }
+
         /**
             Transaction context methods.
         */
@@ -353,6 +371,18 @@ class DatabaseWorkerPool
             Enqueue(new TransactionTask(transaction));
         }
 
+        //! Directly executes a transaction, that will block the calling thread until finished.
+        //! Returns false if the transaction was rolled back.
+        bool DirectCommitTransaction(SQLTransaction& transaction)
+        {
+            T* t = GetFreeConnection();
+            TransactionTask task(transaction);
+            task.SetConnection(t);
+            bool res = task.Execute();
+            t->Unlock();
+            return res;
+        }
+
         //! Method used to execute prepared statements in a diverse context.
         //! Will be wrapped in a transaction if valid object is present, otherwise executed standalone.
         void ExecuteOrAppend(SQLTransaction& trans, PreparedStatement* stmt)
@@ -185,7 +185,6 @@ enum CharacterDatabaseStatements
     CHAR_RESET_GUILD_RANK_BANK_TIME5,
     CHAR_LOAD_GUILDS,
     CHAR_LOAD_GUILD_RANKS,
-    CHAR_LOAD_CHAR_DATA_FOR_GUILD,
     CHAR_LOAD_GUILD_MEMBERS,
     CHAR_LOAD_GUILD_BANK_RIGHTS,
     CHAR_LOAD_GUILD_BANK_TABS,
@@ -19,6 +19,7 @@
 #include "QueryHolder.h"
 #include "PreparedStatement.h"
 #include "Log.h"
+#include "Timer.h"
 
 bool SQLQueryHolder::SetQuery(size_t index, const char *sql)
 {
@@ -153,41 +154,71 @@ void SQLQueryHolder::SetSize(size_t size)
 {
     /// to optimize push_back, reserve the number of queries about to be executed
     m_queries.resize(size);
+    m_queryTimes.resize(size, 0);
 }
 
-bool SQLQueryHolderTask::Execute()
+uint32 SQLQueryHolder::GetTotalQueryTime() const
 {
-    if (!m_holder)
-        return false;
+    uint32 total = 0;
+    for (size_t i = 0; i < m_queryTimes.size(); ++i)
+        total += m_queryTimes[i];
 
-    /// we can do this, we are friends
-    std::vector<SQLQueryHolder::SQLResultPair> &queries = m_holder->m_queries;
+    return total;
+}
 
-    for (size_t i = 0; i < queries.size(); i++)
+void SQLQueryHolder::ExecuteQuery(size_t index, MySQLConnection* conn)
+{
+    SQLElementData* data = &m_queries[index].first;
+    uint32 oldMSTime = getMSTime();
+
+    switch (data->type)
     {
-        /// execute all queries in the holder and pass the results
-        if (SQLElementData* data = &queries[i].first)
+        case SQL_ELEMENT_RAW:
         {
-            switch (data->type)
-            {
-                case SQL_ELEMENT_RAW:
-                {
-                    char const *sql = data->element.query;
-                    if (sql)
-                        m_holder->SetResult(i, m_conn->Query(sql));
-                    break;
-                }
-                case SQL_ELEMENT_PREPARED:
-                {
-                    PreparedStatement* stmt = data->element.stmt;
-                    if (stmt)
-                        m_holder->SetPreparedResult(i, m_conn->Query(stmt));
-                    break;
-                }
-            }
+            char const *sql = data->element.query;
+            if (sql)
+                SetResult(index, conn->Query(sql));
+            break;
+        }
+        case SQL_ELEMENT_PREPARED:
+        {
+            PreparedStatement* stmt = data->element.stmt;
+            if (stmt)
+                SetPreparedResult(index, conn->Query(stmt));
+            break;
         }
     }
 
+    m_queryTimes[index] = GetMSTimeDiffToNow(oldMSTime);
+}
+
+bool SQLQueryHolderTask::Execute()
+{
+    if (!m_holder)
+        return false;
+
+    /// execute all queries in the holder and pass the results
+    for (size_t i = 0; i < m_holder->m_queries.size(); ++i)
+        m_holder->ExecuteQuery(i, m_conn);
+
+    m_holder->m_elapsedTime = GetMSTimeDiffToNow(m_holder->m_startTime);
     m_result.set(m_holder);
     return true;
 }
+
+bool SQLQueryHolderPartTask::Execute()
+{
+    if (!m_holder)
+        return false;
+
+    /// every part writes only its own slot, the vectors are never resized while parts are queued
+    m_holder->ExecuteQuery(m_index, m_conn);
+
+    if (--m_holder->m_pendingQueries == 0)
+    {
+        m_holder->m_elapsedTime = GetMSTimeDiffToNow(m_holder->m_startTime);
+        m_result.set(m_holder);
+    }
+
+    return true;
+}
@@ -19,15 +19,24 @@
 #define _QUERYHOLDER_H
 
 #include <ace/Future.h>
+#include <ace/Atomic_Op.h>
 
 class SQLQueryHolder
 {
     friend class SQLQueryHolderTask;
+    friend class SQLQueryHolderPartTask;
+    template <class T> friend class DatabaseWorkerPool;
     private:
         typedef std::pair<SQLElementData, SQLResultSetUnion> SQLResultPair;
         std::vector<SQLResultPair> m_queries;
+        std::vector<uint32> m_queryTimes;                   // execution time of each query in ms
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> m_pendingQueries;
+        uint32 m_startTime;
+        uint32 m_elapsedTime;                               // ms from enqueue until the last result arrived
+
+        void ExecuteQuery(size_t index, MySQLConnection* conn);
     public:
-        SQLQueryHolder() {}
+        SQLQueryHolder() : m_pendingQueries(0), m_startTime(0), m_elapsedTime(0) {}
         ~SQLQueryHolder();
         bool SetQuery(size_t index, const char *sql);
         bool SetPQuery(size_t index, const char *format, ...) ATTR_PRINTF(3,4);
@@ -37,6 +46,13 @@ class SQLQueryHolder
         PreparedQueryResult GetPreparedResult(size_t index);
         void SetResult(size_t index, ResultSet* result);
         void SetPreparedResult(size_t index, PreparedResultSet* result);
+
+        size_t GetSize() const { return m_queries.size(); }
+        uint32 GetQueryTime(size_t index) const { return index < m_queryTimes.size() ? m_queryTimes[index] : 0; }
+        uint32 GetElapsedTime() const { return m_elapsedTime; }
+        // Sum of all per-query times, compare with GetElapsedTime() to see the gain of parallel execution
+        uint32 GetTotalQueryTime() const;
+        void SetStartTime(uint32 msTime) { m_startTime = msTime; }
 };
 
 typedef ACE_Future<SQLQueryHolder*> QueryResultHolderFuture;
@@ -54,4 +70,19 @@ class SQLQueryHolderTask : public SQLOperation
 
 };
 
+/// Executes a single query of a holder that was split across the async connections,
+/// the part that finishes last sets the holder future.
+class SQLQueryHolderPartTask : public SQLOperation
+{
+    private:
+        SQLQueryHolder * m_holder;
+        size_t m_index;
+        QueryResultHolderFuture m_result;
+
+    public:
+        SQLQueryHolderPartTask(SQLQueryHolder *holder, size_t index, QueryResultHolderFuture res)
+            : m_holder(holder), m_index(index), m_result(res) {}
+        bool Execute();
+};
+
 #endif
\ No newline at end of file
@@ -19,6 +19,8 @@
 #include "SQLStorage.h"
 #include "SQLStorageImpl.h"
 
+#include <ace/Mem_Map.h>
+
 const char CreatureInfosrcfmt[]="iiiiiiiiiisssiiiiiiifffiffiifiiiiiiiiiiffiiiiiiiiiiiiiiiiiiiiiiiisiifffliiiiiiiliiisi";
 const char CreatureInfodstfmt[]="iiiiiiiiiisssibbiiiifffiffiifiiiiiiiiiiffiiiiiiiiiiiiiiiiiiiiiiiisiifffliiiiiiiliiiii";
 const char CreatureDataAddonInfofmt[]="iiiiiis";
@@ -43,6 +45,14 @@ SQLStorage sItemStorage(ItemPrototypesrcfmt, ItemPrototypedstfmt, "entry","item_
 SQLStorage sPageTextStore(PageTextfmt,"entry","page_text");
 SQLStorage sInstanceTemplate(InstanceTemplatesrcfmt, InstanceTemplatedstfmt, "map","instance_template");
 
+std::string SQLStorage::m_snapshotDirectory;
+uint32 SQLStorage::m_snapshotSalt = 0;
+
+// bump when the snapshot layout changes
+#define SQLSTORAGE_SNAPSHOT_VERSION 1
+
+static char const SQLStorageSnapshotMagic[4] = { 'T', 'C', 'S', 'S' };
+
 void SQLStorage::Free ()
 {
     uint32 offset=0;
@@ -71,3 +81,299 @@ void SQLStorage::Load()
     SQLStorageLoader loader;
     loader.Load(*this);
 }
+
+uint32 SQLStorage::GetRecordSize() const
+{
+    uint32 size = 0;
+    for (uint32 x = 0; x < iNumFields; ++x)
+        if (dst_format[x] == FT_STRING)
+            size += sizeof(char*);
+        else if (dst_format[x] == FT_LOGIC)
+            size += sizeof(bool);
+        else if (dst_format[x] == FT_BYTE)
+            size += sizeof(char);
+        else
+            size += 4;
+
+    return size;
+}
+
+void SQLStorage::SetSnapshotDirectory(std::string const& directory)
+{
+    m_snapshotDirectory = directory;
+    if (!m_snapshotDirectory.empty() && m_snapshotDirectory.at(m_snapshotDirectory.length()-1) != '/' && m_snapshotDirectory.at(m_snapshotDirectory.length()-1) != '\\')
+        m_snapshotDirectory.append("/");
+}
+
+std::string SQLStorage::GetSnapshotFileName() const
+{
+    return m_snapshotDirectory + table + ".snapshot";
+}
+
+bool SQLStorage::GetSnapshotChecksum(uint64& checksum) const
+{
+    if (m_snapshotDirectory.empty())
+        return false;
+
+    // content checksum computed by the server, changes whenever any row of the table changes
+    QueryResult result = WorldDatabase.PQuery("CHECKSUM TABLE %s", table);
+    if (!result || result->GetFieldCount() < 2)
+        return false;
+
+    checksum = (*result)[1].GetUInt64();
+    return checksum != 0;
+}
+
+/*
+ * Snapshot layout: magic, version, table checksum, salt, length prefixed
+ * dst_format, MaxEntry, record count, then for every record its entry followed
+ * by all fields in dst_format order. Bools and bytes take one byte, ints and
+ * floats four, strings are stored as length + characters.
+ */
+namespace
+{
+    class SnapshotReader
+    {
+        public:
+            SnapshotReader(char const* data, size_t size) : m_data(data), m_size(size), m_pos(0) {}
+
+            template<class T>
+            bool Read(T& value)
+            {
+                return Read(&value, sizeof(T));
+            }
+
+            bool Read(void* dst, size_t size)
+            {
+                if (m_size - m_pos < size)
+                    return false;
+
+                memcpy(dst, m_data + m_pos, size);
+                m_pos += size;
+                return true;
+            }
+
+            // returns a pointer to the next size bytes in the mapped file
+            char const* Skip(size_t size)
+            {
+                if (m_size - m_pos < size)
+                    return NULL;
+
+                char const* ptr = m_data + m_pos;
+                m_pos += size;
+                return ptr;
+            }
+
+            size_t GetPos() const { return m_pos; }
+            void SetPos(size_t pos) { m_pos = pos; }
+            bool IsAtEnd() const { return m_pos == m_size; }
+
+        private:
+            char const* m_data;
+            size_t m_size;
+            size_t m_pos;
+    };
+
+    template<class T>
+    void WriteSnapshotValue(FILE* file, T const& value)
+    {
+        fwrite(&value, sizeof(T), 1, file);
+    }
+}
+
+bool SQLStorage::LoadSnapshot(uint64 checksum)
+{
+    std::string fileName = GetSnapshotFileName();
+
+    ACE_Mem_Map map;
+    if (map.map(ACE_TEXT_CHAR_TO_TCHAR(fileName.c_str()), static_cast<size_t>(-1), O_RDONLY, ACE_DEFAULT_FILE_PERMS, PROT_READ, ACE_MAP_PRIVATE) == -1)
+        return false;
+
+    SnapshotReader reader(static_cast<char const*>(map.addr()), map.size());
+
+    char magic[4];
+    uint32 version, salt, formatLength, maxEntry, recordCount;
+    uint64 fileChecksum;
+    if (!reader.Read(magic, sizeof(magic)) || memcmp(magic, SQLStorageSnapshotMagic, sizeof(magic)) != 0 ||
+        !reader.Read(version) || version != SQLSTORAGE_SNAPSHOT_VERSION ||
+        !reader.Read(fileChecksum) || !reader.Read(salt) || !reader.Read(formatLength))
+    {
+        sLog->outError("Snapshot %s is corrupted, loading `%s` from the database", fileName.c_str(), table);
+        return false;
+    }
+
+    char const* format = reader.Skip(formatLength);
+    if (fileChecksum != checksum || salt != m_snapshotSalt || !format ||
+        formatLength != iNumFields || memcmp(format, dst_format, formatLength) != 0)
+    {
+        sLog->outString("Snapshot of `%s` is outdated, loading it from the database", table);
+        return false;
+    }
+
+    if (!reader.Read(maxEntry) || !reader.Read(recordCount))
+        return false;
+
+    // validate the whole file first, building the storage can't fail afterwards
+    size_t recordsPos = reader.GetPos();
+    for (uint32 i = 0; i < recordCount; ++i)
+    {
+        uint32 entry;
+        if (!reader.Read(entry) || entry >= maxEntry)
+            return false;
+
+        for (uint32 x = 0; x < iNumFields; ++x)
+        {
+            if (dst_format[x] == FT_STRING)
+            {
+                uint32 length;
+                if (!reader.Read(length) || !reader.Skip(length))
+                    return false;
+            }
+            else if (!reader.Skip(dst_format[x] == FT_LOGIC || dst_format[x] == FT_BYTE ? 1 : 4))
+                return false;
+        }
+    }
+
+    if (!reader.IsAtEnd())
+    {
+        sLog->outError("Snapshot %s is corrupted, loading `%s` from the database", fileName.c_str(), table);
+        return false;
+    }
+
+    reader.SetPos(recordsPos);
+
+    uint32 recordSize = GetRecordSize();
+    char** newIndex = new char*[maxEntry];
+    memset(newIndex, 0, maxEntry * sizeof(char*));
+    char* newData = new char[recordCount * recordSize];
+
+    for (uint32 i = 0; i < recordCount; ++i)
+    {
+        uint32 entry;
+        reader.Read(entry);
+
+        char* p = &newData[recordSize * i];
+        newIndex[entry] = p;
+
+        uint32 offset = 0;
+        for (uint32 x = 0; x < iNumFields; ++x)
+        {
+            switch (dst_format[x])
+            {
+                case FT_LOGIC:
+                {
+                    uint8 value;
+                    reader.Read(value);
+                    *((bool*)(&p[offset])) = value != 0;
+                    offset += sizeof(bool);
+                    break;
+                }
+                case FT_BYTE:
+                    reader.Read(&p[offset], sizeof(char));
+                    offset += sizeof(char);
+                    break;
+                case FT_STRING:
+                {
+                    uint32 length;
+                    reader.Read(length);
+                    char* str = new char[length + 1];
+                    reader.Read(str, length);
+                    str[length] = 0;
+                    *((char**)(&p[offset])) = str;
+                    offset += sizeof(char*);
+                    break;
+                }
+                default:
+                    reader.Read(&p[offset], 4);
+                    offset += 4;
+                    break;
+            }
+        }
+    }
+
+    pIndex = newIndex;
+    data = newData;
+    MaxEntry = maxEntry;
+    RecordCount = recordCount;
+
+    sLog->outString("Loaded `%s` from snapshot %s", table, fileName.c_str());
+    return true;
+}
+
+void SQLStorage::SaveSnapshot(uint64 checksum) const
+{
+    // written to a temporary file first so a crash never leaves a half written snapshot behind
+    std::string fileName = GetSnapshotFileName();
+    std::string tmpName = fileName + ".tmp";
+
+    FILE* file = fopen(tmpName.c_str(), "wb");
+    if (!file)
+    {
+        sLog->outError("Can't create snapshot %s for `%s`", tmpName.c_str(), table);
+        return;
+    }
+
+    uint32 recordCount = 0;
+    for (uint32 y = 0; y < MaxEntry; ++y)
+        if (pIndex[y])
+            ++recordCount;
+
+    fwrite(SQLStorageSnapshotMagic, sizeof(SQLStorageSnapshotMagic), 1, file);
+    WriteSnapshotValue(file, uint32(SQLSTORAGE_SNAPSHOT_VERSION));
+    WriteSnapshotValue(file, checksum);
+    WriteSnapshotValue(file, m_snapshotSalt);
+    WriteSnapshotValue(file, iNumFields);
+    fwrite(dst_format, 1, iNumFields, file);
+    WriteSnapshotValue(file, MaxEntry);
+    WriteSnapshotValue(file, recordCount);
+
+    for (uint32 y = 0; y < MaxEntry; ++y)
+    {
+        char const* p = pIndex[y];
+        if (!p)
+            continue;
+
+        WriteSnapshotValue(file, y);
+
+        uint32 offset = 0;
+        for (uint32 x = 0; x < iNumFields; ++x)
+        {
+            switch (dst_format[x])
+            {
+                case FT_LOGIC:
+                    WriteSnapshotValue(file, uint8(*((bool const*)(&p[offset])) ? 1 : 0));
+                    offset += sizeof(bool);
+                    break;
+                case FT_BYTE:
+                    fwrite(&p[offset], sizeof(char), 1, file);
+                    offset += sizeof(char);
+                    break;
+                case FT_STRING:
+                {
+                    char const* str = *((char* const*)(&p[offset]));
+                    uint32 length = str ? strlen(str) : 0;
+                    WriteSnapshotValue(file, length);
+                    fwrite(str, 1, length, file);
+                    offset += sizeof(char*);
+                    break;
+                }
+                default:
+                    fwrite(&p[offset], 4, 1, file);
+                    offset += 4;
+                    break;
+            }
+        }
+    }
+
+    bool failed = ferror(file) != 0;
+    if (fclose(file) != 0 || failed)
+    {
+        sLog->outError("Can't write snapshot %s for `%s`", tmpName.c_str(), table);
+        remove(tmpName.c_str());
+        return;
+    }
+
+    remove(fileName.c_str());
+    if (rename(tmpName.c_str(), fileName.c_str()) != 0)
+        sLog->outError("Can't replace snapshot %s for `%s`", fileName.c_str(), table);
+}
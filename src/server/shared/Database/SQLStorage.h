@@ -67,6 +67,11 @@ class SQLStorage
         void Load();
         void Free();
 
+        // Loaded tables are cached as binary snapshots in this directory, empty disables them
+        static void SetSnapshotDirectory(std::string const& directory);
+        // Mixed into the snapshot key, for loaders whose conversions depend on other data (script names)
+        static void SetSnapshotSalt(uint32 salt) { m_snapshotSalt = salt; }
+
     private:
         void init(const char * _entry_field, const char * sqlname)
         {
@@ -86,6 +91,15 @@ class SQLStorage
         const char *table;
         const char *entry_field;
         //bool HasString;
+
+        uint32 GetRecordSize() const;
+        bool GetSnapshotChecksum(uint64& checksum) const;
+        std::string GetSnapshotFileName() const;
+        bool LoadSnapshot(uint64 checksum);
+        void SaveSnapshot(uint64 checksum) const;
+
+        static std::string m_snapshotDirectory;
+        static uint32 m_snapshotSalt;
 };
 
 template <class T>
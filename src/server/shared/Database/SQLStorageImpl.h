@@ -121,6 +121,13 @@ void SQLStorageLoaderBase<T>::Load(SQLStorage &store)
 {
     uint32 maxi;
     Field *fields;
+
+    // the table didn't change since the last start, no need to convert all rows again
+    uint64 snapshotChecksum = 0;
+    bool useSnapshot = store.GetSnapshotChecksum(snapshotChecksum);
+    if (useSnapshot && store.LoadSnapshot(snapshotChecksum))
+        return;
+
     QueryResult result  = WorldDatabase.PQuery("SELECT MAX(%s) FROM %s", store.entry_field, store.table);
     if(!result)
     {
@@ -158,18 +165,7 @@ void SQLStorageLoaderBase<T>::Load(SQLStorage &store)
         exit(1);                                            // Stop server at loading broken or non-compatible table.
     }
 
-    //get struct size
-    uint32 sc=0;
-    uint32 bo=0;
-    uint32 bb=0;
-    for (uint32 x=0; x< store.iNumFields; x++)
-        if(store.dst_format[x]==FT_STRING)
-            ++sc;
-        else if (store.dst_format[x]==FT_LOGIC)
-            ++bo;
-        else if (store.dst_format[x]==FT_BYTE)
-            ++bb;
-    recordsize=(store.iNumFields-sc-bo-bb)*4+sc*sizeof(char*)+bo*sizeof(bool)+bb*sizeof(char);
+    recordsize = store.GetRecordSize();
 
     char** newIndex=new char*[maxi];
     memset(newIndex,0,maxi*sizeof(char*));
@@ -203,5 +199,8 @@ void SQLStorageLoaderBase<T>::Load(SQLStorage &store)
     store.pIndex = newIndex;
     store.MaxEntry = maxi;
     store.data = _data;
+
+    if (useSnapshot)
+        store.SaveSnapshot(snapshotChecksum);
 }
 
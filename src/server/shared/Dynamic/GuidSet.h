@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_GUIDSET_H
+#define TRINITY_GUIDSET_H
+
+#include "Common.h"
+#include <vector>
+
+/*
+ * Set of object guids stored in a flat open addressed table (linear probing).
+ *
+ * Meant for small to medium sets that are looked up far more often than they
+ * change, like the guids a player has at its client. A lookup touches one or
+ * two cache lines instead of walking tree nodes, and copying the set is a
+ * single allocation. Guid 0 marks a free slot, so it can't be stored.
+ *
+ * Erasing while iterating the same set is not supported.
+ */
+class GuidSet
+{
+    public:
+        class const_iterator
+        {
+            public:
+                const_iterator() : m_pos(NULL), m_end(NULL) {}
+                const_iterator(uint64 const* pos, uint64 const* end) : m_pos(pos), m_end(end) { SkipFree(); }
+
+                uint64 operator*() const { return *m_pos; }
+                const_iterator& operator++() { ++m_pos; SkipFree(); return *this; }
+                bool operator==(const_iterator const& right) const { return m_pos == right.m_pos; }
+                bool operator!=(const_iterator const& right) const { return m_pos != right.m_pos; }
+
+            private:
+                void SkipFree() { while (m_pos != m_end && !*m_pos) ++m_pos; }
+
+                uint64 const* m_pos;
+                uint64 const* m_end;
+        };
+        typedef const_iterator iterator;
+
+        GuidSet() : m_size(0) {}
+
+        const_iterator begin() const { return m_slots.empty() ? const_iterator() : const_iterator(&m_slots[0], &m_slots[0] + m_slots.size()); }
+        const_iterator end() const { return m_slots.empty() ? const_iterator() : const_iterator(&m_slots[0] + m_slots.size(), &m_slots[0] + m_slots.size()); }
+
+        bool empty() const { return m_size == 0; }
+        size_t size() const { return m_size; }
+
+        void clear()
+        {
+            m_slots.clear();
+            m_size = 0;
+        }
+
+        size_t count(uint64 guid) const
+        {
+            if (!m_size || !guid)
+                return 0;
+
+            size_t mask = m_slots.size() - 1;
+            for (size_t i = Hash(guid) & mask; m_slots[i]; i = (i + 1) & mask)
+                if (m_slots[i] == guid)
+                    return 1;
+
+            return 0;
+        }
+
+        bool insert(uint64 guid)
+        {
+            if (!guid)
+                return false;
+
+            // keep the table at most half full, probe sequences stay short
+            if ((m_size + 1) * 2 > m_slots.size())
+                Rehash(m_slots.empty() ? MIN_CAPACITY : m_slots.size() * 2);
+
+            size_t mask = m_slots.size() - 1;
+            size_t i = Hash(guid) & mask;
+            for (; m_slots[i]; i = (i + 1) & mask)
+                if (m_slots[i] == guid)
+                    return false;
+
+            m_slots[i] = guid;
+            ++m_size;
+            return true;
+        }
+
+        size_t erase(uint64 guid)
+        {
+            if (!m_size || !guid)
+                return 0;
+
+            size_t mask = m_slots.size() - 1;
+            size_t i = Hash(guid) & mask;
+            for (; m_slots[i] != guid; i = (i + 1) & mask)
+                if (!m_slots[i])
+                    return 0;
+
+            // shift back the following entries of the probe sequence instead of leaving a tombstone
+            for (size_t j = (i + 1) & mask; m_slots[j]; j = (j + 1) & mask)
+            {
+                size_t home = Hash(m_slots[j]) & mask;
+                // the entry at j can fill the hole at i only if its home slot is not in (i, j]
+                if (i <= j ? (home <= i || home > j) : (home <= i && home > j))
+                {
+                    m_slots[i] = m_slots[j];
+                    i = j;
+                }
+            }
+
+            m_slots[i] = 0;
+            --m_size;
+            return 1;
+        }
+
+    private:
+        static const size_t MIN_CAPACITY = 32;
+
+        static size_t Hash(uint64 guid)
+        {
+            // fibonacci hashing, guids of one type only differ in the low bits
+            return size_t((guid * UI64LIT(0x9E3779B97F4A7C15)) >> 32);
+        }
+
+        void Rehash(size_t capacity)
+        {
+            std::vector<uint64> old(capacity, 0);
+            old.swap(m_slots);
+
+            size_t mask = capacity - 1;
+            for (std::vector<uint64>::const_iterator itr = old.begin(); itr != old.end(); ++itr)
+            {
+                if (!*itr)
+                    continue;
+
+                size_t i = Hash(*itr) & mask;
+                while (m_slots[i])
+                    i = (i + 1) & mask;
+                m_slots[i] = *itr;
+            }
+        }
+
+        std::vector<uint64> m_slots;                        // power of two sized, 0 is a free slot
+        size_t m_size;
+};
+
+#endif
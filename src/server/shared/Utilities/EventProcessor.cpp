@@ -17,16 +17,102 @@
  */
 
 #include "EventProcessor.h"
+#include "ObjectPool.h"
+#include <algorithm>
+#include <cstring>
+
+// BasicEvent itself is 64 bytes, most derived events add no more than a few pointers
+static ObjectPool* const sEventPool = new ObjectPool("BasicEvent", 96, 1024);
+
+void* BasicEvent::operator new(size_t size)
+{
+    return sEventPool->Allocate(size);
+}
+
+void BasicEvent::operator delete(void* ptr, size_t size)
+{
+    sEventPool->Deallocate(ptr, size);
+}
+
+enum EventWheelLayout
+{
+    WHEEL_BITS      = 6,
+    WHEEL_SIZE      = 1 << WHEEL_BITS,
+    WHEEL_MASK      = WHEEL_SIZE - 1,
+    WHEEL_LEVELS    = 4,                                    // 2^24 ms (~4.6 hours), later events wait in the top level and are rescheduled
+    WHEEL_DUE_SLOT  = WHEEL_LEVELS * WHEEL_SIZE,            // events added for a tick the wheel has already passed
+    WHEEL_SLOTS
+};
+
+/*
+ * Hierarchical timer wheel with 1 ms resolution.
+ *
+ * Level 0 has one slot per millisecond of the next WHEEL_SIZE ms. Every slot of
+ * a higher level covers one full turn of the level below it and its events are
+ * redistributed to the lower levels (cascaded) when the level below wraps.
+ * Slots are circular doubly linked lists threaded through the events, the
+ * head's previous event is the tail. A level 0 slot holds the events of a
+ * single tick, they are kept sorted by the order they were added in, so an
+ * event cascaded from a higher level still runs before a later added event
+ * of the same time. The due slot is kept sorted by time and order.
+ */
+struct EventProcessor::EventWheel
+{
+    EventWheel() { memset(slots, 0, sizeof(slots)); memset(occupied, 0, sizeof(occupied)); }
+
+    static void* operator new(size_t size);
+    static void operator delete(void* ptr, size_t size);
+    static ObjectPool* const pool;
+
+    BasicEvent* slots[WHEEL_SLOTS];                         // level * WHEEL_SIZE + index, then the due slot
+    uint64 occupied[WHEEL_LEVELS];                          // one bit per non-empty slot
+};
+
+ObjectPool* const EventProcessor::EventWheel::pool = new ObjectPool("EventWheel", sizeof(EventProcessor::EventWheel), 64);
+
+void* EventProcessor::EventWheel::operator new(size_t size)
+{
+    return pool->Allocate(size);
+}
+
+void EventProcessor::EventWheel::operator delete(void* ptr, size_t size)
+{
+    pool->Deallocate(ptr, size);
+}
+
+// Returns the first non-empty slot at or after from, WHEEL_SIZE if there is none
+static uint32 FindNextSlot(uint64 occupied, uint32 from)
+{
+    if (from >= WHEEL_SIZE)
+        return WHEEL_SIZE;
+
+    occupied >>= from;
+    if (!occupied)
+        return WHEEL_SIZE;
+
+    while (!(occupied & 1))
+    {
+        occupied >>= 1;
+        ++from;
+    }
+
+    return from;
+}
 
 EventProcessor::EventProcessor()
 {
     m_time = 0;
+    m_wheelTime = 0;
+    m_eventCount = 0;
+    m_nextQueueOrder = 0;
+    m_wheel = NULL;
     m_aborting = false;
 }
 
 EventProcessor::~EventProcessor()
 {
     KillAllEvents(true);
+    delete m_wheel;
 }
 
 void EventProcessor::Update(uint32 p_time)
@@ -34,13 +120,91 @@ void EventProcessor::Update(uint32 p_time)
     // update time
     m_time += p_time;
 
-    // main event loop
-    EventList::iterator i;
-    while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
+    // main event loop, one wheel tick at a time
+    while (m_eventCount)
+    {
+        ExecuteSlot(WHEEL_DUE_SLOT, p_time);
+
+        if (m_wheelTime > m_time)
+            return;
+
+        uint32 index = uint32(m_wheelTime & WHEEL_MASK);
+        if (!index)
+        {
+            uint32 level = 1;
+            while (level < WHEEL_LEVELS && !Cascade(level))
+                ++level;
+        }
+
+        // events added by Execute() for this very tick are appended to the slot and run here as well
+        ExecuteSlot(index, p_time);
+
+        // skip the ticks that have nothing to run or cascade
+        m_wheelTime = std::min(NextEventTick(), m_time + 1);
+    }
+
+    // nothing queued, the wheel can simply follow the clock
+    m_wheelTime = m_time + 1;
+}
+
+void EventProcessor::KillAllEvents(bool force)
+{
+    // prevent event insertions
+    m_aborting = true;
+
+    if (!m_wheel)
+        return;
+
+    // first, abort all existing events
+    for (uint32 slot = 0; slot < WHEEL_SLOTS; ++slot)
     {
+        BasicEvent* Event = DetachSlot(slot);
+        while (Event)
+        {
+            BasicEvent* next = Event->m_nextEvent;
+
+            Event->to_Abort = true;
+            Event->Abort(m_time);
+            if (force || Event->IsDeletable())
+                delete Event;
+            else                                            // stays queued and gets deleted at its planned time
+                LinkEvent(Event, slot);
+
+            Event = next;
+        }
+    }
+}
+
+void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime)
+{
+    if (set_addtime) Event->m_addTime = m_time;
+    Event->m_execTime = e_time;
+    Event->m_queueOrder = m_nextQueueOrder++;
+
+    if (!m_wheel)
+        m_wheel = new EventWheel();
+
+    ScheduleEvent(Event);
+}
+
+uint64 EventProcessor::CalculateTime(uint64 t_offset) const
+{
+    return(m_time + t_offset);
+}
+
+void EventProcessor::ExecuteSlot(uint32 slot, uint32 p_time)
+{
+    while (BasicEvent* Event = m_wheel->slots[slot])
+    {
+        // an event added for an earlier time by the previous one runs first
+        if (slot != WHEEL_DUE_SLOT && m_wheel->slots[WHEEL_DUE_SLOT])
+        {
+            ExecuteSlot(WHEEL_DUE_SLOT, p_time);
+            continue;
+        }
+
         // get and remove event from queue
-        BasicEvent* Event = i->second;
-        m_events.erase(i);
+        UnlinkEvent(Event);
 
         if (!Event->to_Abort)
         {
@@ -58,42 +222,149 @@ void EventProcessor::Update(uint32 p_time)
     }
 }
 
-void EventProcessor::KillAllEvents(bool force)
+void EventProcessor::ScheduleEvent(BasicEvent* Event)
 {
-    // prevent event insertions
-    m_aborting = true;
-
-    // first, abort all existing events
-    for (EventList::iterator i = m_events.begin(); i != m_events.end();)
+    uint64 execTime = Event->m_execTime;
+    if (execTime < m_wheelTime)
     {
-        EventList::iterator i_old = i;
-        ++i;
+        LinkEvent(Event, WHEEL_DUE_SLOT);
+        return;
+    }
 
-        i_old->second->to_Abort = true;
-        i_old->second->Abort(m_time);
-        if(force || i_old->second->IsDeletable())
-        {
-            delete i_old->second;
+    uint64 delta = execTime - m_wheelTime;
+
+    uint32 level = 0;
+    while (level + 1 < WHEEL_LEVELS && delta >= (uint64(1) << ((level + 1) * WHEEL_BITS)))
+        ++level;
 
-            if(!force)                                      // need per-element cleanup
-                m_events.erase (i_old);
+    // beyond the range of the wheel, park the event in the last slot it can reach
+    if (delta >= (uint64(1) << (WHEEL_LEVELS * WHEEL_BITS)))
+        execTime = m_wheelTime + (uint64(1) << (WHEEL_LEVELS * WHEEL_BITS)) - 1;
+
+    LinkEvent(Event, level * WHEEL_SIZE + (uint32(execTime >> (level * WHEEL_BITS)) & WHEEL_MASK));
+}
+
+void EventProcessor::LinkEvent(BasicEvent* Event, uint32 slot)
+{
+    BasicEvent*& head = m_wheel->slots[slot];
+    if (head)
+    {
+        // level 0 and due slots are kept sorted, usually the event just goes behind the tail
+        bool sorted = slot < WHEEL_SIZE || slot == WHEEL_DUE_SLOT;
+        BasicEvent* next = head;
+        if (sorted && RunsBefore(Event, head->m_prevEvent))
+        {
+            next = head->m_prevEvent;
+            while (next != head && RunsBefore(Event, next->m_prevEvent))
+                next = next->m_prevEvent;
         }
+
+        // link in front of next, in front of the head is behind the tail
+        Event->m_nextEvent = next;
+        Event->m_prevEvent = next->m_prevEvent;
+        next->m_prevEvent->m_nextEvent = Event;
+        next->m_prevEvent = Event;
+
+        if (sorted && next == head && RunsBefore(Event, head))
+            head = Event;
+    }
+    else
+    {
+        Event->m_nextEvent = Event;
+        Event->m_prevEvent = Event;
+        head = Event;
+
+        if (slot != WHEEL_DUE_SLOT)
+            m_wheel->occupied[slot / WHEEL_SIZE] |= uint64(1) << (slot & WHEEL_MASK);
     }
 
-    // fast clear event list (in force case)
-    if(force)
-        m_events.clear();
+    Event->m_wheelSlot = uint16(slot);
+    ++m_eventCount;
 }
 
-void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime)
+void EventProcessor::UnlinkEvent(BasicEvent* Event)
 {
-    if (set_addtime) Event->m_addTime = m_time;
-    Event->m_execTime = e_time;
-    m_events.insert(std::pair<uint64, BasicEvent*>(e_time, Event));
+    uint32 slot = Event->m_wheelSlot;
+
+    BasicEvent*& head = m_wheel->slots[slot];
+    if (Event->m_nextEvent == Event)
+    {
+        head = NULL;
+
+        if (slot != WHEEL_DUE_SLOT)
+            m_wheel->occupied[slot / WHEEL_SIZE] &= ~(uint64(1) << (slot & WHEEL_MASK));
+    }
+    else
+    {
+        Event->m_prevEvent->m_nextEvent = Event->m_nextEvent;
+        Event->m_nextEvent->m_prevEvent = Event->m_prevEvent;
+        if (head == Event)
+            head = Event->m_nextEvent;
+    }
+
+    Event->m_prevEvent = NULL;
+    Event->m_nextEvent = NULL;
+    --m_eventCount;
 }
 
-uint64 EventProcessor::CalculateTime(uint64 t_offset) const
+// Empties a slot and returns its events as a NULL terminated list in queue order
+BasicEvent* EventProcessor::DetachSlot(uint32 slot)
 {
-    return(m_time + t_offset);
+    BasicEvent* head = m_wheel->slots[slot];
+    if (!head)
+        return NULL;
+
+    m_wheel->slots[slot] = NULL;
+    if (slot != WHEEL_DUE_SLOT)
+        m_wheel->occupied[slot / WHEEL_SIZE] &= ~(uint64(1) << (slot & WHEEL_MASK));
+
+    head->m_prevEvent->m_nextEvent = NULL;
+    for (BasicEvent* Event = head; Event; Event = Event->m_nextEvent)
+        --m_eventCount;
+
+    return head;
 }
 
+bool EventProcessor::RunsBefore(BasicEvent const* left, BasicEvent const* right)
+{
+    if (left->m_execTime != right->m_execTime)
+        return left->m_execTime < right->m_execTime;
+    return left->m_queueOrder < right->m_queueOrder;
+}
+
+// Moves the events of the current slot of a level down to the lower levels, returns the slot index
+uint32 EventProcessor::Cascade(uint32 level)
+{
+    uint32 index = uint32(m_wheelTime >> (level * WHEEL_BITS)) & WHEEL_MASK;
+
+    BasicEvent* Event = DetachSlot(level * WHEEL_SIZE + index);
+    while (Event)
+    {
+        BasicEvent* next = Event->m_nextEvent;
+        ScheduleEvent(Event);
+        Event = next;
+    }
+
+    return index;
+}
+
+// Returns the first tick after m_wheelTime at which an event has to run or a slot has to be cascaded
+uint64 EventProcessor::NextEventTick() const
+{
+    for (uint32 level = 0; level < WHEEL_LEVELS; ++level)
+    {
+        uint32 shift = level * WHEEL_BITS;
+        uint32 index = uint32(m_wheelTime >> shift) & WHEEL_MASK;
+        uint64 turnStart = (m_wheelTime >> (shift + WHEEL_BITS)) << (shift + WHEEL_BITS);
+
+        uint32 next = FindNextSlot(m_wheel->occupied[level], index + 1);
+        if (next < WHEEL_SIZE)
+            return turnStart + (uint64(next) << shift);
+
+        // slots before the current one belong to the next turn of this level
+        if (m_wheel->occupied[level])
+            return turnStart + (uint64(1) << (shift + WHEEL_BITS));
+    }
+
+    return m_wheelTime + 1;
+}
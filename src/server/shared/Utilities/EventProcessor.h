@@ -21,18 +21,20 @@
 
 #include "Define.h"
 
-#include<map>
-
 // Note. All times are in milliseconds here.
 
 class BasicEvent
 {
     public:
-        BasicEvent() { to_Abort = false; }
+        BasicEvent() : m_queueOrder(0), m_prevEvent(NULL), m_nextEvent(NULL), m_wheelSlot(0) { to_Abort = false; }
         virtual ~BasicEvent()                               // override destructor to perform some actions on event removal
         {
         };
 
+        // events are served from a small object pool, unusually large derived events use the global allocator
+        static void* operator new(size_t size);
+        static void operator delete(void* ptr, size_t size);
+
         // this method executes when the event is triggered
         // return false if event does not want to be deleted
         // e_time is execution time, p_time is update interval
@@ -48,10 +50,26 @@ class BasicEvent
         // these can be used for time offset control
         uint64 m_addTime;                                   // time when the event was added to queue, filled by event handler
         uint64 m_execTime;                                  // planned time of next execution, filled by event handler
-};
 
-typedef std::multimap<uint64, BasicEvent*> EventList;
+    private:
+        friend class EventProcessor;
+
+        // events with the same execution time run in the order they were added (or re-added)
+        uint64 m_queueOrder;
+
+        // links of the timer wheel slot the event is queued in, managed by the event handler
+        BasicEvent* m_prevEvent;
+        BasicEvent* m_nextEvent;
+        uint16 m_wheelSlot;
+};
 
+/*
+ * Events are kept in a hierarchical timer wheel, see EventProcessor.cpp.
+ * Adding and removing an event is O(1) and needs no memory besides the
+ * event itself; the wheel is only allocated once the first event is added.
+ * Events run in order of execution time, events with the same execution
+ * time in the order they were added.
+ */
 class EventProcessor
 {
     public:
@@ -63,8 +81,22 @@ class EventProcessor
         void AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime = true);
         uint64 CalculateTime(uint64 t_offset) const;
     protected:
+        struct EventWheel;
+
+        void ExecuteSlot(uint32 slot, uint32 p_time);
+        void ScheduleEvent(BasicEvent* Event);
+        void LinkEvent(BasicEvent* Event, uint32 slot);
+        void UnlinkEvent(BasicEvent* Event);
+        BasicEvent* DetachSlot(uint32 slot);
+        static bool RunsBefore(BasicEvent const* left, BasicEvent const* right);
+        uint32 Cascade(uint32 level);
+        uint64 NextEventTick() const;
+
         uint64 m_time;
-        EventList m_events;
+        uint64 m_wheelTime;                                 // next tick of the wheel that was not processed yet
+        uint32 m_eventCount;
+        uint64 m_nextQueueOrder;
+        EventWheel* m_wheel;
         bool m_aborting;
 };
 #endif
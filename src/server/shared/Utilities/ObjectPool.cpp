@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ObjectPool.h"
+#include <ace/Guard_T.h>
+#include <new>
+
+// pools are created during static initialization, before any thread is started
+static ObjectPool* s_firstPool = NULL;
+
+ObjectPool::ObjectPool(char const* name, size_t slotSize, uint32 slotsPerSlab) :
+    m_name(name), m_slotsPerSlab(slotsPerSlab), m_freeList(NULL), m_freeCount(0), m_slabs(0),
+    m_live(0), m_oversized(0)
+{
+    // keep every slot aligned for any type the global allocator could have returned
+    size_t const align = 2 * sizeof(void*);
+    if (slotSize < sizeof(FreeSlot))
+        slotSize = sizeof(FreeSlot);
+    m_slotSize = (slotSize + align - 1) & ~(align - 1);
+
+    if (!m_slotsPerSlab)
+        m_slotsPerSlab = 1;
+    m_batchSize = m_slotsPerSlab / 4 ? m_slotsPerSlab / 4 : 1;
+
+    m_nextPool = s_firstPool;
+    s_firstPool = this;
+}
+
+ObjectPool::ThreadCache::~ThreadCache()
+{
+    if (pool && count)
+        pool->DrainCache(this, 0);
+}
+
+ObjectPool::ThreadCache* ObjectPool::GetThreadCache()
+{
+    // created on first use in every thread
+    ThreadCache* cache = m_threadCache;
+    cache->pool = this;
+    return cache;
+}
+
+void* ObjectPool::Allocate(size_t size)
+{
+    if (size > m_slotSize)
+    {
+        ++m_oversized;
+        return ::operator new(size);
+    }
+
+    ThreadCache* cache = GetThreadCache();
+    if (!cache->head)
+        FillCache(cache);
+
+    FreeSlot* slot = cache->head;
+    cache->head = slot->next;
+    --cache->count;
+
+    ++m_live;
+    return slot;
+}
+
+void ObjectPool::Deallocate(void* ptr, size_t size)
+{
+    if (!ptr)
+        return;
+
+    if (size > m_slotSize)
+    {
+        --m_oversized;
+        ::operator delete(ptr);
+        return;
+    }
+
+    --m_live;
+
+    ThreadCache* cache = GetThreadCache();
+    FreeSlot* slot = static_cast<FreeSlot*>(ptr);
+    slot->next = cache->head;
+    cache->head = slot;
+
+    // objects are often freed by another thread than the one that created them,
+    // don't let a single thread cache hoard everything
+    if (++cache->count >= 2 * m_batchSize)
+        DrainCache(cache, m_batchSize);
+}
+
+void ObjectPool::FillCache(ThreadCache* cache)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_lock);
+
+    if (m_freeCount < m_batchSize)
+        AllocateSlab();
+
+    for (uint32 i = 0; i < m_batchSize && m_freeList; ++i)
+    {
+        FreeSlot* slot = m_freeList;
+        m_freeList = slot->next;
+        --m_freeCount;
+
+        slot->next = cache->head;
+        cache->head = slot;
+        ++cache->count;
+    }
+}
+
+void ObjectPool::DrainCache(ThreadCache* cache, uint32 keep)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_lock);
+
+    while (cache->count > keep)
+    {
+        FreeSlot* slot = cache->head;
+        cache->head = slot->next;
+        --cache->count;
+
+        slot->next = m_freeList;
+        m_freeList = slot;
+        ++m_freeCount;
+    }
+}
+
+void ObjectPool::AllocateSlab()
+{
+    char* slab = static_cast<char*>(::operator new(m_slotSize * m_slotsPerSlab));
+
+    // link slots in address order so consecutive allocations are adjacent in memory
+    for (uint32 i = m_slotsPerSlab; i > 0; --i)
+    {
+        FreeSlot* slot = reinterpret_cast<FreeSlot*>(slab + (i - 1) * m_slotSize);
+        slot->next = m_freeList;
+        m_freeList = slot;
+    }
+
+    m_freeCount += m_slotsPerSlab;
+    ++m_slabs;
+}
+
+void ObjectPool::GetStats(Stats& stats) const
+{
+    long const live = m_live.value();
+    long const oversized = m_oversized.value();
+
+    {
+        // map threads grow the pool in FillCache while .debug objectpools reads it
+        ACE_GUARD(ACE_Thread_Mutex, guard, m_lock);
+        stats.slabs = m_slabs;
+    }
+
+    stats.name = m_name;
+    stats.slotSize = uint32(m_slotSize);
+    stats.live = uint32(live > 0 ? live : 0);
+    stats.oversized = uint32(oversized > 0 ? oversized : 0);
+
+    uint32 const capacity = stats.slabs * m_slotsPerSlab;
+    stats.free = capacity > stats.live ? capacity - stats.live : 0;
+}
+
+void ObjectPool::GetAllStats(std::vector<Stats>& stats)
+{
+    for (ObjectPool const* pool = s_firstPool; pool; pool = pool->m_nextPool)
+    {
+        Stats poolStats;
+        pool->GetStats(poolStats);
+        stats.push_back(poolStats);
+    }
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_OBJECTPOOL_H
+#define TRINITY_OBJECTPOOL_H
+
+#include "Define.h"
+#include <ace/Atomic_Op.h>
+#include <ace/Thread_Mutex.h>
+#include <ace/TSS_T.h>
+#include <vector>
+
+/*
+ * Fixed size slab allocator for frequently created and destroyed objects.
+ *
+ * Memory is reserved from the global allocator in slabs of slotsPerSlab slots
+ * and never given back. Every thread keeps its own free list so allocations and
+ * frees on map threads don't take any lock; only when a thread cache runs empty
+ * or grows too large a batch of slots is moved from/to the shared free list.
+ *
+ * Requests bigger than the slot size (derived classes the pool was not sized
+ * for) are passed through to the global allocator and only counted.
+ *
+ * Pools are meant to live for the whole process, create them with new and
+ * never delete them so objects freed during static destruction remain valid.
+ */
+class ObjectPool
+{
+    public:
+        struct Stats
+        {
+            char const* name;
+            uint32 slotSize;
+            uint32 live;                                    // pooled objects currently in use
+            uint32 free;                                    // reserved slots not in use (thread caches included)
+            uint32 oversized;                               // objects in use that were too big for the pool
+            uint32 slabs;
+        };
+
+        ObjectPool(char const* name, size_t slotSize, uint32 slotsPerSlab = 256);
+
+        void* Allocate(size_t size);
+        void Deallocate(void* ptr, size_t size);
+
+        void GetStats(Stats& stats) const;
+
+        // Collects statistics of every pool created so far
+        static void GetAllStats(std::vector<Stats>& stats);
+
+    private:
+        ObjectPool(ObjectPool const&);
+        ObjectPool& operator=(ObjectPool const&);
+
+        struct FreeSlot
+        {
+            FreeSlot* next;
+        };
+
+        struct ThreadCache
+        {
+            ThreadCache() : pool(NULL), head(NULL), count(0) {}
+            ~ThreadCache();                                 // hands the cached slots back to the shared list on thread exit
+
+            ObjectPool* pool;
+            FreeSlot* head;
+            uint32 count;
+        };
+
+        ThreadCache* GetThreadCache();
+        void FillCache(ThreadCache* cache);
+        void DrainCache(ThreadCache* cache, uint32 keep);
+        void AllocateSlab();
+
+        char const* m_name;
+        size_t m_slotSize;
+        uint32 m_slotsPerSlab;
+        uint32 m_batchSize;
+
+        ACE_TSS<ThreadCache> m_threadCache;
+
+        mutable ACE_Thread_Mutex m_lock;
+        FreeSlot* m_freeList;                               // guarded by m_lock
+        uint32 m_freeCount;                                 // guarded by m_lock
+        uint32 m_slabs;                                     // guarded by m_lock
+
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> m_live;
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> m_oversized;
+
+        ObjectPool* m_nextPool;                             // intrusive list of all pools, see GetAllStats
+};
+
+#endif
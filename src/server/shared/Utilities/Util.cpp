@@ -474,6 +474,21 @@ bool Utf8FitTo(const std::string& str, std::wstring search)
     return true;
 }
 
+std::string Utf8ToLowerKey(const std::string& utf8str)
+{
+    std::wstring wstr;
+    if (!Utf8toWStr(utf8str, wstr))
+        return utf8str;
+
+    wstrToLower(wstr);
+
+    std::string key;
+    if (!WStrToUtf8(wstr, key))
+        return utf8str;
+
+    return key;
+}
+
 void utf8printf(FILE *out, const char *str, ...)
 {
     va_list ap;
@@ -27,6 +27,7 @@
 #include "Configuration/Config.h"
 
 #include "AccountMgr.h"
+#include "CharacterCache.h"
 #include "Chat.h"
 #include "CliRunnable.h"
 #include "Language.h"
@@ -293,8 +294,10 @@ void ChatHandler::HandleCharacterDeletedRestoreHelper(DeletedInfo const& delInfo
         return;
     }
 
-    CharacterDatabase.PExecute("UPDATE characters SET name='%s', account='%u', deleteDate=NULL, deleteInfos_Name=NULL, deleteInfos_Account=NULL WHERE deleteDate IS NOT NULL AND guid = %u",
+    // executed directly, the character cache reloads the restored row right after
+    CharacterDatabase.DirectPExecute("UPDATE characters SET name='%s', account='%u', deleteDate=NULL, deleteInfos_Name=NULL, deleteInfos_Account=NULL WHERE deleteDate IS NOT NULL AND guid = %u",
         delInfo.name.c_str(), delInfo.accountId, delInfo.lowguid);
+    sCharacterCache->LoadCharacterFromDB(delInfo.lowguid);
 }
 
 /**
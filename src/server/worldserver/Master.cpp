@@ -388,6 +388,9 @@ bool Master::_StartDB()
     std::string dbstring;
     uint8 async_threads, synch_threads;
 
+    // every startup loader thread needs its own synchronous connection to the world and character databases
+    uint8 loader_threads = sConfig->GetIntDefault("StartupLoader.Threads", 1);
+
     dbstring = sConfig->GetStringDefault("WorldDatabaseInfo", "");
     if (dbstring.empty())
     {
@@ -403,7 +406,7 @@ bool Master::_StartDB()
         return false;
     }
 
-    synch_threads = sConfig->GetIntDefault("WorldDatabase.SynchThreads", 1);
+    synch_threads = std::max(uint8(sConfig->GetIntDefault("WorldDatabase.SynchThreads", 1)), loader_threads);
 
     ///- Initialise the world database
     if (!WorldDatabase.Open(dbstring, async_threads, synch_threads))
@@ -427,7 +430,7 @@ bool Master::_StartDB()
         return false;
     }
 
-    synch_threads = sConfig->GetIntDefault("CharacterDatabase.SynchThreads", 2);
+    synch_threads = std::max(uint8(sConfig->GetIntDefault("CharacterDatabase.SynchThreads", 2)), loader_threads);
 
     ///- Initialise the Character database
     if (!CharacterDatabase.Open(dbstring, async_threads, synch_threads))
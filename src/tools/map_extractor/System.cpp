@@ -3,6 +3,7 @@
 #include <stdio.h>
 #include <deque>
 #include <set>
+#include <map>
 #include <cstdlib>
 
 #ifdef _WIN32
@@ -18,6 +19,12 @@
 #include "wdt.h"
 #include <fcntl.h>
 
+#include <ace/Task.h>
+#include <ace/Thread_Mutex.h>
+#include <ace/Thread_Semaphore.h>
+#include <ace/Guard_T.h>
+#include <ace/OS_NS_unistd.h>
+
 #if defined( __GNUC__ )
     #define _open   open
     #define _close close
@@ -59,6 +66,10 @@ enum Extract
 
 // Select data for extract
 int   CONF_extract = EXTRACT_MAP | EXTRACT_DBC;
+// Number of threads converting map tiles, 0 - one per core
+int   CONF_threads = 0;
+// Skip tiles whose source data and options did not change since the last run
+bool  CONF_incremental = false;
 // This option allow limit minimum height to some value (Allow save some memory)
 bool  CONF_allow_height_limit = true;
 float CONF_use_minHeight = -500.0f;
@@ -116,6 +127,8 @@ void Usage(char* prg)
         "-o set output path\n"\
         "-e extract only MAP(1)/DBC(2) - standard: both(3)\n"\
         "-f height stored as int (less map size but lost some accuracy) 1 by default\n"\
+        "-t number of threads converting map tiles, 0 (all cores) by default\n"\
+        "-u update only tiles that changed since the last extraction 0 by default\n"\
         "Example: %s -f 0 -i \"c:\\games\\game\"", prg, prg);
     exit(1);
 }
@@ -129,6 +142,8 @@ void HandleArgs(int argc, char * arg[])
         // e - extract only MAP(1)/DBC(2) - standard both(3)
         // f - use float to int conversion
         // h - limit minimum height
+        // t - number of converting threads
+        // u - incremental update
         if(arg[c][0] != '-')
             Usage(arg[0]);
 
@@ -162,6 +177,22 @@ void HandleArgs(int argc, char * arg[])
                 else
                     Usage(arg[0]);
                 break;
+            case 't':
+                if(c + 1 < argc)                            // all ok
+                {
+                    CONF_threads=atoi(arg[(c++) + 1]);
+                    if(CONF_threads < 0)
+                        Usage(arg[0]);
+                }
+                else
+                    Usage(arg[0]);
+                break;
+            case 'u':
+                if(c + 1 < argc)                            // all ok
+                    CONF_incremental=atoi(arg[(c++) + 1])!=0;
+                else
+                    Usage(arg[0]);
+                break;
         }
     }
 }
@@ -349,26 +380,46 @@ float selectUInt16StepStore(float maxDiff)
 {
     return 65535 / maxDiff;
 }
-// Temporary grid data store
-uint16 area_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
-
-float V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-float V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
-uint16 uint16_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-uint16 uint16_V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
-uint8  uint8_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-uint8  uint8_V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+// Temporary grid data store, each converting thread has its own
+struct GridDataStore
+{
+    uint16 area_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+
+    float V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+    float V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+    uint16 uint16_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+    uint16 uint16_V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+    uint8  uint8_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+    uint8  uint8_V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+
+    uint8 liquid_type[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+    bool  liquid_show[ADT_GRID_SIZE][ADT_GRID_SIZE];
+    float liquid_height[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+};
 
-uint8 liquid_type[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
-bool  liquid_show[ADT_GRID_SIZE][ADT_GRID_SIZE];
-float liquid_height[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+// libmpq is not thread safe, every archive access while tiles are converted goes through this lock
+ACE_Thread_Mutex mpqLock;
 
-bool ConvertADT(char *filename, char *filename2, int cell_y, int cell_x, uint32 build)
+bool ConvertADT(char *filename, char *filename2, int cell_y, int cell_x, uint32 build, GridDataStore &store)
 {
+    uint16 (&area_flags)[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID] = store.area_flags;
+    float (&V8)[ADT_GRID_SIZE][ADT_GRID_SIZE] = store.V8;
+    float (&V9)[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1] = store.V9;
+    uint16 (&uint16_V8)[ADT_GRID_SIZE][ADT_GRID_SIZE] = store.uint16_V8;
+    uint16 (&uint16_V9)[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1] = store.uint16_V9;
+    uint8 (&uint8_V8)[ADT_GRID_SIZE][ADT_GRID_SIZE] = store.uint8_V8;
+    uint8 (&uint8_V9)[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1] = store.uint8_V9;
+    uint8 (&liquid_type)[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID] = store.liquid_type;
+    bool (&liquid_show)[ADT_GRID_SIZE][ADT_GRID_SIZE] = store.liquid_show;
+    float (&liquid_height)[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1] = store.liquid_height;
+
     ADT_file adt;
 
-    if (!adt.loadFile(filename))
-        return false;
+    {
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, mpqLock, false);
+        if (!adt.loadFile(filename))
+            return false;
+    }
 
     adt_MCIN *cells = adt.a_grid->getMCIN();
     if (!cells)
@@ -869,10 +920,180 @@ bool ConvertADT(char *filename, char *filename2, int cell_y, int cell_x, uint32
     return true;
 }
 
-void ExtractMapsFromMpq(uint32 build)
+// Fingerprints of the tiles written so far, kept next to the map files for incremental updates
+typedef std::map<std::string, uint64> TileFingerprintMap;
+
+static char const* TILE_FINGERPRINT_FILE = "maps/tiles.fingerprint";
+
+void LoadTileFingerprints(TileFingerprintMap &fingerprints)
+{
+    std::string filename = std::string(output_path) + "/" + TILE_FINGERPRINT_FILE;
+    FILE *input = fopen(filename.c_str(), "r");
+    if (!input)
+        return;
+
+    char tile[64];
+    uint32 high, low;
+    while (fscanf(input, "%63s %8x%8x", tile, &high, &low) == 3)
+        fingerprints[tile] = (uint64(high) << 32) | low;
+
+    fclose(input);
+}
+
+void SaveTileFingerprints(TileFingerprintMap const &fingerprints)
+{
+    std::string filename = std::string(output_path) + "/" + TILE_FINGERPRINT_FILE;
+    FILE *output = fopen(filename.c_str(), "w");
+    if (!output)
+    {
+        printf("Can't create the output file '%s'\n", filename.c_str());
+        return;
+    }
+
+    // std::map keeps the file sorted, so it does not depend on the order tiles were converted in
+    for (TileFingerprintMap::const_iterator itr = fingerprints.begin(); itr != fingerprints.end(); ++itr)
+        fprintf(output, "%s %08x%08x\n", itr->first.c_str(), uint32(itr->second >> 32), uint32(itr->second));
+
+    fclose(output);
+}
+
+// Everything besides the ADT itself that ends up in the map files
+uint64 GetConvertOptionsFingerprint(uint32 build)
+{
+    uint64 fingerprint = FINGERPRINT_SEED;
+    fingerprint = HashBytes(fingerprint, MAP_VERSION_MAGIC, 4);
+    fingerprint = HashBytes(fingerprint, &build, sizeof(build));
+    fingerprint = HashBytes(fingerprint, &CONF_allow_height_limit, sizeof(CONF_allow_height_limit));
+    fingerprint = HashBytes(fingerprint, &CONF_use_minHeight, sizeof(CONF_use_minHeight));
+    fingerprint = HashBytes(fingerprint, &CONF_allow_float_to_int, sizeof(CONF_allow_float_to_int));
+    fingerprint = HashBytes(fingerprint, &CONF_float_to_int8_limit, sizeof(CONF_float_to_int8_limit));
+    fingerprint = HashBytes(fingerprint, &CONF_float_to_int16_limit, sizeof(CONF_float_to_int16_limit));
+    fingerprint = HashBytes(fingerprint, &CONF_flat_height_delta_limit, sizeof(CONF_flat_height_delta_limit));
+    fingerprint = HashBytes(fingerprint, &CONF_flat_liquid_delta_limit, sizeof(CONF_flat_liquid_delta_limit));
+
+    // area flags come from the dbc
+    uint64 dbcFingerprint = 0;
+    if (MPQFile::GetFingerprint("DBFilesClient\\AreaTable.dbc", dbcFingerprint))
+        fingerprint = HashBytes(fingerprint, &dbcFingerprint, sizeof(dbcFingerprint));
+
+    return fingerprint;
+}
+
+struct TileConvertJob
 {
     char mpq_filename[1024];
     char output_filename[1024];
+    char tile[16];
+    uint32 cell_y;
+    uint32 cell_x;
+};
+
+/* Converts ADT tiles on a pool of threads. Jobs are handed out through a queue bounded to a few
+ * jobs per thread, so the producer never gets far ahead of the converters. Every tile is written to
+ * its own file, the result does not depend on which thread converts which tile.
+ */
+class TileConverter : public ACE_Task<ACE_MT_SYNCH>
+{
+    public:
+        TileConverter(uint32 build, int threads, TileFingerprintMap &fingerprints) : m_build(build), m_threads(threads),
+            m_queueSlots(threads * 4), m_optionsFingerprint(GetConvertOptionsFingerprint(build)),
+            m_fingerprints(fingerprints), m_converted(0), m_skipped(0), m_failed(0) {}
+
+        int Start()
+        {
+            return activate(THR_NEW_LWP | THR_JOINABLE, m_threads);
+        }
+
+        // Blocks while the queue is full
+        void Convert(TileConvertJob *job)
+        {
+            m_queueSlots.acquire();
+            putq(new ACE_Message_Block((char const*)job));
+        }
+
+        // Waits until all queued tiles are done and stops the threads
+        void Finish()
+        {
+            for (int i = 0; i < m_threads * 4; ++i)
+                m_queueSlots.acquire();
+
+            msg_queue()->deactivate();
+            wait();
+        }
+
+        uint32 GetConvertedCount() const { return m_converted; }
+        uint32 GetSkippedCount() const { return m_skipped; }
+        uint32 GetFailedCount() const { return m_failed; }
+
+        int svc()
+        {
+            GridDataStore *store = new GridDataStore();
+
+            ACE_Message_Block *mb;
+            while (getq(mb) != -1)
+            {
+                TileConvertJob *job = (TileConvertJob*)mb->base();
+                mb->release();
+
+                ConvertTile(*job, *store);
+                delete job;
+
+                m_queueSlots.release();
+            }
+
+            delete store;
+            return 0;
+        }
+
+    private:
+        void ConvertTile(TileConvertJob &job, GridDataStore &store)
+        {
+            uint64 fingerprint = 0;
+            {
+                ACE_GUARD(ACE_Thread_Mutex, guard, mpqLock);
+                if (MPQFile::GetFingerprint(job.mpq_filename, fingerprint))
+                    fingerprint = HashBytes(m_optionsFingerprint, &fingerprint, sizeof(fingerprint));
+            }
+
+            if (CONF_incremental && fingerprint && FileExists(job.output_filename))
+            {
+                ACE_GUARD(ACE_Thread_Mutex, guard, m_resultLock);
+                TileFingerprintMap::const_iterator itr = m_fingerprints.find(job.tile);
+                if (itr != m_fingerprints.end() && itr->second == fingerprint)
+                {
+                    ++m_skipped;
+                    return;
+                }
+            }
+
+            bool converted = ConvertADT(job.mpq_filename, job.output_filename, job.cell_y, job.cell_x, m_build, store);
+
+            ACE_GUARD(ACE_Thread_Mutex, guard, m_resultLock);
+            if (converted && fingerprint)
+                m_fingerprints[job.tile] = fingerprint;
+            else
+                m_fingerprints.erase(job.tile);
+
+            if (converted)
+                ++m_converted;
+            else
+                ++m_failed;
+        }
+
+        uint32 m_build;
+        int m_threads;
+        ACE_Thread_Semaphore m_queueSlots;
+        uint64 m_optionsFingerprint;
+
+        ACE_Thread_Mutex m_resultLock;
+        TileFingerprintMap &m_fingerprints;
+        uint32 m_converted;
+        uint32 m_skipped;
+        uint32 m_failed;
+};
+
+void ExtractMapsFromMpq(uint32 build)
+{
     char mpq_map_name[1024];
 
     printf("Extracting maps...\n");
@@ -886,14 +1107,36 @@ void ExtractMapsFromMpq(uint32 build)
     path += "/maps/";
     CreateDir(path);
 
-    printf("Convert map files\n");
+    TileFingerprintMap fingerprints;
+    if (CONF_incremental)
+        LoadTileFingerprints(fingerprints);
+
+    int threads = CONF_threads;
+    if (threads <= 0)
+        threads = ACE_OS::num_processors_online();
+    if (threads <= 0)
+        threads = 1;
+
+    TileConverter converter(build, threads, fingerprints);
+    if (converter.Start() == -1)
+    {
+        printf("Fatal error: Can't start converting threads!\n");
+        exit(1);
+    }
+
+    printf("Convert map files using %d threads\n", threads);
     for(uint32 z = 0; z < map_count; ++z)
     {
         printf("Extract %s (%d/%d)                  \n", map_ids[z].name, z+1, map_count);
         // Loadup map grid data
         sprintf(mpq_map_name, "World\\Maps\\%s\\%s.wdt", map_ids[z].name, map_ids[z].name);
         WDT_file wdt;
-        if (!wdt.loadFile(mpq_map_name, false))
+        bool loaded;
+        {
+            ACE_GUARD(ACE_Thread_Mutex, guard, mpqLock);
+            loaded = wdt.loadFile(mpq_map_name, false);
+        }
+        if (!loaded)
         {
 //            printf("Error loading %s map wdt data\n", map_ids[z].name);
             continue;
@@ -905,15 +1148,25 @@ void ExtractMapsFromMpq(uint32 build)
             {
                 if (!wdt.main->adt_list[y][x].exist)
                     continue;
-                sprintf(mpq_filename, "World\\Maps\\%s\\%s_%u_%u.adt", map_ids[z].name, map_ids[z].name, x, y);
-                sprintf(output_filename, "%s/maps/%03u%02u%02u.map", output_path, map_ids[z].id, y, x);
-                ConvertADT(mpq_filename, output_filename, y, x, build);
+                TileConvertJob *job = new TileConvertJob();
+                sprintf(job->mpq_filename, "World\\Maps\\%s\\%s_%u_%u.adt", map_ids[z].name, map_ids[z].name, x, y);
+                sprintf(job->output_filename, "%s/maps/%03u%02u%02u.map", output_path, map_ids[z].id, y, x);
+                sprintf(job->tile, "%03u%02u%02u", map_ids[z].id, y, x);
+                job->cell_y = y;
+                job->cell_x = x;
+                converter.Convert(job);
             }
             // draw progress bar
             printf("Processing........................%d%%\r", (100 * (y+1)) / WDT_MAP_SIZE);
         }
     }
+
+    converter.Finish();
     printf("\n");
+    printf("Converted %u tiles, skipped %u unchanged, %u failed\n", converter.GetConvertedCount(), converter.GetSkippedCount(), converter.GetFailedCount());
+
+    SaveTileFingerprints(fingerprints);
+
     delete [] areas;
     delete [] map_ids;
 }
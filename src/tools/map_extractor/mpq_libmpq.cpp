@@ -74,6 +74,35 @@ MPQFile::MPQFile(const char* filename):
     buffer = 0;
 }
 
+bool MPQFile::GetFingerprint(const char* filename, uint64& fingerprint)
+{
+    for(ArchiveSet::iterator i=gOpenArchives.begin(); i!=gOpenArchives.end();++i)
+    {
+        mpq_archive *mpq_a = (*i)->mpq_a;
+
+        uint32_t filenum;
+        if(libmpq__file_number(mpq_a, filename, &filenum)) continue;
+
+        libmpq__off_t archiveSize = 0, offset = 0, packedSize = 0, unpackedSize = 0;
+        uint32_t archiveFiles = 0;
+        libmpq__archive_packed_size(mpq_a, &archiveSize);
+        libmpq__archive_files(mpq_a, &archiveFiles);
+        libmpq__file_offset(mpq_a, filenum, &offset);
+        libmpq__file_packed_size(mpq_a, filenum, &packedSize);
+        libmpq__file_unpacked_size(mpq_a, filenum, &unpackedSize);
+
+        fingerprint = FINGERPRINT_SEED;
+        fingerprint = HashBytes(fingerprint, &archiveSize, sizeof(archiveSize));
+        fingerprint = HashBytes(fingerprint, &archiveFiles, sizeof(archiveFiles));
+        fingerprint = HashBytes(fingerprint, &filenum, sizeof(filenum));
+        fingerprint = HashBytes(fingerprint, &offset, sizeof(offset));
+        fingerprint = HashBytes(fingerprint, &packedSize, sizeof(packedSize));
+        fingerprint = HashBytes(fingerprint, &unpackedSize, sizeof(unpackedSize));
+        return true;
+    }
+    return false;
+}
+
 size_t MPQFile::read(void* dest, size_t bytes)
 {
     if (eof) return 0;
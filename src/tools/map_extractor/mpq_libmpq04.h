@@ -6,6 +6,7 @@
 
 #include "loadlib/loadlib.h"
 #include "libmpq/mpq.h"
+#include "Fingerprint.h"
 #include <string.h>
 #include <ctype.h>
 #include <vector>
@@ -75,6 +76,10 @@ public:
     void seek(int offset);
     void seekRelative(int offset);
     void close();
+
+    // Identifies the archive entry that would be read for filename without unpacking it,
+    // any patch that replaces the file changes it. Returns false if no archive has the file.
+    static bool GetFingerprint(const char* filename, uint64& fingerprint);
 };
 
 inline void flipcc(char *fcc)
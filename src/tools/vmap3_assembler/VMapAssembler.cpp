@@ -1,23 +1,52 @@
 #include <string>
 #include <iostream>
+#include <cstdlib>
+#include <cstring>
+
+#include <ace/OS_NS_unistd.h>
 
 #include "TileAssembler.h"
 
 int main(int argc, char* argv[])
 {
-    if(argc != 3)
+    uint32 threads = 0;
+    bool incremental = false;
+    bool badArgs = argc < 3;
+
+    for (int i = 3; i < argc && !badArgs; ++i)
+    {
+        if (!strcmp(argv[i], "-t") && i + 1 < argc)
+            threads = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-u"))
+            incremental = true;
+        else
+            badArgs = true;
+    }
+
+    if (badArgs)
     {
         //printf("\nusage: %s <raw data dir> <vmap dest dir> [config file name]\n", argv[0]);
-        std::cout << "usage: " << argv[0] << " <raw data dir> <vmap dest dir>" << std::endl;
+        std::cout << "usage: " << argv[0] << " <raw data dir> <vmap dest dir> [-t threads] [-u]" << std::endl;
+        std::cout << "  -t  number of converting threads, all cores by default" << std::endl;
+        std::cout << "  -u  only convert maps and models whose input changed since the last run" << std::endl;
         return 1;
     }
 
+    if (!threads)
+    {
+        long cores = ACE_OS::num_processors_online();
+        threads = cores > 0 ? uint32(cores) : 1;
+    }
+
     std::string src = argv[1];
     std::string dest = argv[2];
 
     std::cout << "using " << src << " as source directory and writing output to " << dest << std::endl;
+    std::cout << "using " << threads << " threads" << (incremental ? ", incremental" : "") << std::endl;
 
     VMAP::TileAssembler* ta = new VMAP::TileAssembler(src, dest);
+    ta->setThreadCount(threads);
+    ta->setIncremental(incremental);
 
     if(!ta->convertWorld2())
     {